@@ -479,6 +479,9 @@ int main(int argc, char* argv[])
 					if (vm.count(cli::MINER_JOB_LATENCY))
 						node.m_Cfg.m_Timeout.m_MiningSoftRestart_ms = vm[cli::MINER_JOB_LATENCY].as<uint32_t>();
 
+					if (vm.count(cli::MINER_JOB_FEE_THRESHOLD))
+						node.m_Cfg.m_MiningFeeThreshold = vm[cli::MINER_JOB_FEE_THRESHOLD].as<Amount>();
+
 					if (vm.count(cli::MINE_ONLINE))
 						node.m_Cfg.m_PreferOnlineMining = vm[cli::MINE_ONLINE].as<bool>();
 
@@ -1807,6 +1807,45 @@ namespace beam
 			m_pKernel->AddStats(s);
 	}
 
+	void TxBase::Context::IVerifiedCache::get_Key(Key& hv, const Output& outp, uint32_t iFork)
+	{
+		ECC::Hash::Processor hp;
+		hp
+			<< "vc.outp"
+			<< iFork;
+
+		hp.Serialize(outp);
+		hp >> hv;
+	}
+
+	void TxBase::Context::IVerifiedCache::get_Key(Key& hv, const TxKernel& krn, uint32_t iFork)
+	{
+		ECC::Hash::Processor hp;
+
+		auto nType = static_cast<uint8_t>(krn.get_Subtype());
+		hp
+			<< "vc.krn"
+			<< iFork
+			<< nType;
+
+		// kernel ID doesn't cover the signature (for std kernels) and some proofs, hence the whole kernel is hashed
+		switch (nType)
+		{
+#define THE_MACRO(id, name) \
+		case TxKernel::Subtype::name: \
+			hp.Serialize(Cast::Up<TxKernel##name>(krn)); \
+			break;
+
+		BeamKernelsAll(THE_MACRO)
+#undef THE_MACRO
+
+		default:
+			Exc::Fail("Bad kernel subtype");
+		}
+
+		hp >> hv;
+	}
+
 	void TxVectors::Reader::Clone(Ptr& pOut)
 	{
 		pOut.reset(new Reader(m_P, m_E));
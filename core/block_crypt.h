@@ -1489,6 +1489,9 @@ namespace beam
 			// returns false only if cancelled
 			bool Solve(const void* pInput, uint32_t nSizeInput, Height, const Cancel& = [](bool) { return false; });
 
+			// Solve() keeps its (large) tables for the subsequent calls on the same thread. Frees them for the calling thread
+			static void ReleaseSolver();
+
 		private:
 			struct Helper;
 		};
@@ -1718,6 +1721,22 @@ namespace beam
 		// In other words Sigma = <all outputs> - <all inputs>
 		// Sigma is either zero or -Sum(Fee)*H, depending on what we validate
 
+		// Elements (outputs and kernels) that already passed the verification, so that it can be skipped.
+		// The key covers the whole element (including proofs and signatures) and the fork.
+		struct IVerifiedCache
+		{
+			typedef ECC::Hash::Value Key;
+
+			static void get_Key(Key&, const Output&, uint32_t iFork);
+			static void get_Key(Key&, const TxKernel&, uint32_t iFork);
+
+			// Both are called from the verification threads.
+			// pSigma: the kernel contribution to the sigma, for outputs it's nullptr (the commitment is used).
+			// Inserted elements may still be pending the batch verification, which is not complete yet.
+			virtual bool Find(const Key&, ECC::Point* pSigma) = 0;
+			virtual void Insert(const Key&, const ECC::Point::Native* pSigma) = 0;
+		};
+
 		struct Params
 		{
 			bool m_bAllowUnsignedOutputs; // allow outputs without signature (commitment only). Applicable for cut-through blocks only, outputs that are supposed to be consumed in the later block.
@@ -1726,6 +1745,8 @@ namespace beam
 			uint32_t m_nVerifiers;
 			volatile bool* m_pAbort;
 
+			IVerifiedCache* m_pCache;
+
 			Params(); // defaults
 		};
 
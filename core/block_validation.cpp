@@ -184,8 +184,20 @@ namespace beam
 
 				if (bSigned)
 				{
-					if (!r.m_pUtxoOut->IsValid(m_Height.m_Min, pt))
-						Fail_Signature();
+					IVerifiedCache::Key hv;
+					if (m_Params.m_pCache)
+						IVerifiedCache::get_Key(hv, *r.m_pUtxoOut, iFork);
+
+					if (m_Params.m_pCache && m_Params.m_pCache->Find(hv, nullptr))
+						pt.ImportStrict(r.m_pUtxoOut->m_Commitment);
+					else
+					{
+						if (!r.m_pUtxoOut->IsValid(m_Height.m_Min, pt))
+							Fail_Signature();
+
+						if (m_Params.m_pCache)
+							m_Params.m_pCache->Insert(hv, nullptr);
+					}
 				}
 				else
 				{
@@ -212,7 +224,25 @@ namespace beam
 				if (pPrev && ((*pPrev) > (*r.m_pKernel)))
 					Fail_Order(); // wrong order
 
-				r.m_pKernel->TestValid(m_Height.m_Min, m_Sigma);
+				if (m_Params.m_pCache)
+				{
+					IVerifiedCache::Key hv;
+					IVerifiedCache::get_Key(hv, *r.m_pKernel, iFork);
+
+					ECC::Point ptExc;
+					if (m_Params.m_pCache->Find(hv, &ptExc) && pt.Import(ptExc))
+						m_Sigma += pt;
+					else
+					{
+						ECC::Point::Native exc(Zero);
+						r.m_pKernel->TestValid(m_Height.m_Min, exc);
+
+						m_Sigma += exc;
+						m_Params.m_pCache->Insert(hv, &exc);
+					}
+				}
+				else
+					r.m_pKernel->TestValid(m_Height.m_Min, m_Sigma);
 
 				HandleElementHeightStrict(r.m_pKernel->get_EffectiveHeightRange());
 
@@ -15,6 +15,7 @@
 #include "common.h"
 #include "ecc_native.h"
 #include "../utility/common.h" // Exc
+#include "../utility/executor.h"
 
 #if defined(__clang__) || defined(__GNUC__) || defined(__GNUG__)
 #	pragma GCC diagnostic push
@@ -44,6 +45,10 @@
 #    include <fcntl.h>
 #endif // WIN32
 
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#	include <immintrin.h> // Hash::Multi lanes
+#endif
+
 //#ifdef __linux__
 //#	include <sys/syscall.h>
 //#	include <linux/random.h>
@@ -431,6 +436,269 @@ namespace ECC {
 		Write(Point(v));
 	}
 
+	/////////////////////
+	// Hash::Multi
+	namespace HashMulti
+	{
+		// Lane types. Each provides the same set of 32-bit element-wise operations
+#if defined(__AVX512F__)
+#	define BEAM_HASH_MULTI_LANES
+#	if defined(__GNUC__) && !defined(__clang__)
+#		pragma GCC diagnostic push
+#		pragma GCC diagnostic ignored "-Wuninitialized" // false positives in the avx512 intrinsics of some gcc versions
+#		pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#		define BEAM_HASH_MULTI_DIAGNOSTIC_POP
+#	endif // __GNUC__
+		struct Lane
+		{
+			static const uint32_t N = 16;
+			typedef __m512i V;
+
+			static V Load(const uint32_t* p) { return _mm512_loadu_si512(p); }
+			static void Store(uint32_t* p, V x) { _mm512_storeu_si512(p, x); }
+			static V Set(uint32_t n) { return _mm512_set1_epi32(static_cast<int>(n)); }
+			static V Add(V a, V b) { return _mm512_add_epi32(a, b); }
+			static V Xor(V a, V b) { return _mm512_xor_si512(a, b); }
+			static V And(V a, V b) { return _mm512_and_si512(a, b); }
+			static V Or(V a, V b) { return _mm512_or_si512(a, b); }
+			static V AndNot(V a, V b) { return _mm512_andnot_si512(a, b); } // ~a & b
+			template <int n> static V Shr(V x) { return _mm512_srli_epi32(x, n); }
+			template <int n> static V Rotr(V x) { return _mm512_ror_epi32(x, n); }
+		};
+#elif defined(__AVX2__)
+#	define BEAM_HASH_MULTI_LANES
+		struct Lane
+		{
+			static const uint32_t N = 8;
+			typedef __m256i V;
+
+			static V Load(const uint32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const V*>(p)); }
+			static void Store(uint32_t* p, V x) { _mm256_storeu_si256(reinterpret_cast<V*>(p), x); }
+			static V Set(uint32_t n) { return _mm256_set1_epi32(static_cast<int>(n)); }
+			static V Add(V a, V b) { return _mm256_add_epi32(a, b); }
+			static V Xor(V a, V b) { return _mm256_xor_si256(a, b); }
+			static V And(V a, V b) { return _mm256_and_si256(a, b); }
+			static V Or(V a, V b) { return _mm256_or_si256(a, b); }
+			static V AndNot(V a, V b) { return _mm256_andnot_si256(a, b); }
+			template <int n> static V Shr(V x) { return _mm256_srli_epi32(x, n); }
+			template <int n> static V Rotr(V x) { return Or(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n)); }
+		};
+#elif defined(__SSE2__) || defined(_M_X64)
+#	define BEAM_HASH_MULTI_LANES
+		struct Lane
+		{
+			static const uint32_t N = 4;
+			typedef __m128i V;
+
+			static V Load(const uint32_t* p) { return _mm_loadu_si128(reinterpret_cast<const V*>(p)); }
+			static void Store(uint32_t* p, V x) { _mm_storeu_si128(reinterpret_cast<V*>(p), x); }
+			static V Set(uint32_t n) { return _mm_set1_epi32(static_cast<int>(n)); }
+			static V Add(V a, V b) { return _mm_add_epi32(a, b); }
+			static V Xor(V a, V b) { return _mm_xor_si128(a, b); }
+			static V And(V a, V b) { return _mm_and_si128(a, b); }
+			static V Or(V a, V b) { return _mm_or_si128(a, b); }
+			static V AndNot(V a, V b) { return _mm_andnot_si128(a, b); }
+			template <int n> static V Shr(V x) { return _mm_srli_epi32(x, n); }
+			template <int n> static V Rotr(V x) { return Or(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n)); }
+		};
+#endif // SIMD
+
+#ifdef BEAM_HASH_MULTI_LANES
+		static const uint32_t s_pIV[8] = {
+			0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+		};
+
+		static const uint32_t s_pK[64] = {
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+		};
+
+		template <typename L>
+		struct Engine
+		{
+			typedef typename L::V V;
+
+			static V Ch(V e, V f, V g) { return L::Xor(L::And(e, f), L::AndNot(e, g)); }
+			static V Maj(V a, V b, V c) { return L::Or(L::And(a, b), L::And(c, L::Or(a, b))); }
+			static V S0(V x) { return L::Xor(L::Xor(L::template Rotr<2>(x), L::template Rotr<13>(x)), L::template Rotr<22>(x)); }
+			static V S1(V x) { return L::Xor(L::Xor(L::template Rotr<6>(x), L::template Rotr<11>(x)), L::template Rotr<25>(x)); }
+			static V s0(V x) { return L::Xor(L::Xor(L::template Rotr<7>(x), L::template Rotr<18>(x)), L::template Shr<3>(x)); }
+			static V s1(V x) { return L::Xor(L::Xor(L::template Rotr<17>(x), L::template Rotr<19>(x)), L::template Shr<10>(x)); }
+
+			static uint32_t get_Blocks(uint32_t nSize)
+			{
+				// the message, 0x80 byte, and 64-bit length
+				return (nSize + 9 + 63) >> 6;
+			}
+
+			static void get_Block(uint8_t* p, const beam::Blob& msg, uint32_t iBlock, uint32_t nBlocks)
+			{
+				uint32_t nOffs = iBlock << 6;
+				uint32_t nCopy = (msg.n > nOffs) ? std::min(msg.n - nOffs, 64U) : 0;
+
+				memcpy(p, reinterpret_cast<const uint8_t*>(msg.p) + nOffs, nCopy);
+				memset(p + nCopy, 0, 64 - nCopy);
+
+				if ((msg.n >= nOffs) && (msg.n - nOffs < 64))
+					p[msg.n - nOffs] = 0x80;
+
+				if (iBlock + 1 == nBlocks)
+				{
+					uint64_t nBits = uint64_t(msg.n) << 3;
+					for (uint32_t i = 0; i < 8; i++, nBits >>= 8)
+						p[63 - i] = static_cast<uint8_t>(nBits);
+				}
+			}
+
+			static void Transform(V* pS, V* pW)
+			{
+				V a = pS[0], b = pS[1], c = pS[2], d = pS[3], e = pS[4], f = pS[5], g = pS[6], h = pS[7];
+
+				for (uint32_t i = 0; i < 64; i++)
+				{
+					// message schedule in a ring of 16 words
+					V& w = pW[i & 15];
+					if (i >= 16)
+						w = L::Add(L::Add(w, pW[(i + 9) & 15]), L::Add(s0(pW[(i + 1) & 15]), s1(pW[(i + 14) & 15])));
+
+					V t1 = L::Add(L::Add(L::Add(h, S1(e)), L::Add(Ch(e, f, g), L::Set(s_pK[i]))), w);
+					V t2 = L::Add(S0(a), Maj(a, b, c));
+
+					h = g;
+					g = f;
+					f = e;
+					e = L::Add(d, t1);
+					d = c;
+					c = b;
+					b = a;
+					a = L::Add(t1, t2);
+				}
+
+				pS[0] = L::Add(pS[0], a);
+				pS[1] = L::Add(pS[1], b);
+				pS[2] = L::Add(pS[2], c);
+				pS[3] = L::Add(pS[3], d);
+				pS[4] = L::Add(pS[4], e);
+				pS[5] = L::Add(pS[5], f);
+				pS[6] = L::Add(pS[6], g);
+				pS[7] = L::Add(pS[7], h);
+			}
+
+			static void Calculate(Hash::Value* pRes, const beam::Blob* pMsg, uint32_t nLanes)
+			{
+				// Messages are processed in lockstep, lanes with shorter messages just idle till the longest one is done.
+				// Unused lanes are fed with zeroes.
+				assert(nLanes && (nLanes <= L::N));
+
+				uint32_t pBlocks[L::N] = { 0 };
+				uint32_t nBlocksMax = 0;
+				for (uint32_t j = 0; j < nLanes; j++)
+				{
+					pBlocks[j] = get_Blocks(pMsg[j].n);
+					nBlocksMax = std::max(nBlocksMax, pBlocks[j]);
+				}
+
+				uint32_t pW[16][L::N] = { { 0 } };
+				uint32_t pOut[8][L::N];
+
+				V pS[8], pV[16];
+				for (uint32_t k = 0; k < 8; k++)
+					pS[k] = L::Set(s_pIV[k]);
+
+				for (uint32_t iBlock = 0; iBlock < nBlocksMax; iBlock++)
+				{
+					for (uint32_t j = 0; j < nLanes; j++)
+					{
+						if (iBlock >= pBlocks[j])
+							continue;
+
+						uint8_t pBuf[64];
+						get_Block(pBuf, pMsg[j], iBlock, pBlocks[j]);
+
+						for (uint32_t t = 0; t < 16; t++)
+						{
+							const uint8_t* p = pBuf + (t << 2);
+							pW[t][j] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+						}
+					}
+
+					for (uint32_t t = 0; t < 16; t++)
+						pV[t] = L::Load(pW[t]);
+
+					Transform(pS, pV);
+
+					bool bStored = false;
+					for (uint32_t j = 0; j < nLanes; j++)
+					{
+						if (iBlock + 1 != pBlocks[j])
+							continue;
+
+						if (!bStored)
+						{
+							for (uint32_t k = 0; k < 8; k++)
+								L::Store(pOut[k], pS[k]);
+							bStored = true;
+						}
+
+						uint8_t* p = pRes[j].m_pData;
+						for (uint32_t k = 0; k < 8; k++, p += 4)
+						{
+							uint32_t x = pOut[k][j];
+							p[0] = static_cast<uint8_t>(x >> 24);
+							p[1] = static_cast<uint8_t>(x >> 16);
+							p[2] = static_cast<uint8_t>(x >> 8);
+							p[3] = static_cast<uint8_t>(x);
+						}
+					}
+				}
+			}
+		};
+#endif // BEAM_HASH_MULTI_LANES
+
+	} // namespace HashMulti
+
+#ifdef BEAM_HASH_MULTI_DIAGNOSTIC_POP
+#	pragma GCC diagnostic pop
+#endif
+
+	void Hash::Multi::Calculate(Value* pRes, const beam::Blob* pMsg, uint32_t nCount)
+	{
+#ifdef BEAM_HASH_MULTI_LANES
+		typedef HashMulti::Engine<HashMulti::Lane> Engine;
+		const uint32_t N = HashMulti::Lane::N;
+
+		for (uint32_t i = 0; i < nCount; i += N)
+			Engine::Calculate(pRes + i, pMsg + i, std::min(N, nCount - i));
+#else // BEAM_HASH_MULTI_LANES
+		for (uint32_t i = 0; i < nCount; i++)
+			Processor() << pMsg[i] >> pRes[i];
+#endif // BEAM_HASH_MULTI_LANES
+	}
+
+	void Hash::Multi::CalculatePairs(Value* pRes, const Value* pSrc, uint32_t nCount)
+	{
+		beam::Blob pMsg[0x40];
+
+		while (nCount)
+		{
+			uint32_t n = std::min<uint32_t>(nCount, _countof(pMsg));
+			for (uint32_t i = 0; i < n; i++)
+				pMsg[i] = beam::Blob(pSrc[i << 1].m_pData, Value::nBytes << 1);
+
+			Calculate(pRes, pMsg, n);
+
+			pRes += n;
+			pSrc += n << 1;
+			nCount -= n;
+		}
+	}
+
 	void Hash::Mac::Reset(const void* pSecret, uint32_t nSecret)
 	{
 		secp256k1_hmac_sha256_initialize(this, (uint8_t*)pSecret, nSecret);
@@ -877,6 +1145,83 @@ namespace ECC {
 		m_Batch.m_Size++;
 	}
 
+	const uint32_t s_BatchConvChunk = 0x100;
+	const uint32_t s_BatchConvMinParallel = 0x1000;
+
+	static void ExportBatchChunk(Point* pDst, const Point::Native* pSrc, uint32_t nCount)
+	{
+		assert(nCount <= s_BatchConvChunk);
+
+		Point::Native::BatchNormalizer_Arr_T<s_BatchConvChunk> bn;
+		uint32_t pIdx[s_BatchConvChunk];
+		bn.m_Size = 0;
+
+		for (uint32_t i = 0; i < nCount; i++)
+		{
+			if (pSrc[i] == Zero)
+				ZeroObject(pDst[i]);
+			else
+			{
+				pIdx[bn.m_Size] = i;
+				bn.m_pPts[bn.m_Size++] = pSrc[i];
+			}
+		}
+
+		bn.Normalize();
+
+		NoLeak<secp256k1_ge> ge;
+		for (uint32_t i = 0; i < bn.m_Size; i++)
+		{
+			Point::Native::BatchNormalizer::get_As(ge.V, bn.m_pPts[i]);
+			secp256k1_fe_normalize(&ge.V.x);
+			secp256k1_fe_normalize(&ge.V.y);
+			Point::Native::ExportEx(pDst[pIdx[i]], ge.V);
+		}
+	}
+
+	static void ExportBatchRange(Point* pDst, const Point::Native* pSrc, uint32_t nCount)
+	{
+		while (nCount)
+		{
+			uint32_t n = std::min(nCount, s_BatchConvChunk);
+			ExportBatchChunk(pDst, pSrc, n);
+
+			pDst += n;
+			pSrc += n;
+			nCount -= n;
+		}
+	}
+
+	void Point::Native::ExportBatch(Point* pDst, const Native* pSrc, uint32_t nCount)
+	{
+		if (!beam::Executor::s_pInstance || (nCount < s_BatchConvMinParallel))
+		{
+			ExportBatchRange(pDst, pSrc, nCount);
+			return;
+		}
+
+		struct MyTask
+			:public beam::Executor::TaskSync
+		{
+			Point* m_pDst;
+			const Native* m_pSrc;
+			uint32_t m_Count;
+
+			virtual void Exec(beam::Executor::Context& ctx) override
+			{
+				uint32_t i0, n;
+				ctx.get_Portion(i0, n, m_Count);
+				ExportBatchRange(m_pDst + i0, m_pSrc + i0, n);
+			}
+		} t;
+
+		t.m_pDst = pDst;
+		t.m_pSrc = pSrc;
+		t.m_Count = nCount;
+
+		beam::Executor::s_pInstance->ExecAll(t);
+	}
+
 	void Point::Compact::Assign(secp256k1_ge& ge) const
 	{
 		secp256k1_ge_from_storage(&ge, this);
@@ -1448,8 +1793,269 @@ namespace ECC {
 		return true;
 	}
 
+	uint32_t MultiMac::s_PippengerMin = 512;
+
+	struct MultiMac::Pippenger
+		:public beam::Executor::TaskSync
+	{
+		// All the terms are split into windows of signed digits. For each window the points are accumulated in buckets according to their digits,
+		// then the window result is sum(i * bucket[i]). Windows are independent, and calculated in parallel.
+		static const uint32_t s_MinParallel = 2048;
+
+		std::vector<secp256k1_ge> m_vPts; // affine
+		std::vector<const Scalar::Native*> m_vpK;
+		std::vector<int16_t> m_vDigits; // window-major
+		std::vector<Point::Native> m_vWnd; // per-window results
+
+		unsigned int m_WndBits;
+		unsigned int m_Windows;
+
+		void Import(const MultiMac&);
+		void Import(const Point::Storage*, const Scalar::Native*, uint32_t nCount);
+		void Calculate(Point::Native&);
+
+		static unsigned int get_WndBits(uint32_t nTerms);
+		static unsigned int get_Bits(const Scalar::Native&, unsigned int iBit, unsigned int nBits);
+
+		void SetDigits(uint32_t iTerm);
+		void CalculateRange(uint32_t iWnd0, uint32_t nCount);
+		void CalculateWnd(uint32_t iWnd, Point::Native* pBuckets);
+
+		virtual void Exec(beam::Executor::Context&) override;
+	};
+
+	void MultiMac::Pippenger::Import(const MultiMac& mm)
+	{
+		m_vPts.reserve(static_cast<size_t>(mm.m_Casual) + mm.m_Prepared);
+		m_vpK.reserve(m_vPts.capacity());
+
+		if (mm.m_Casual)
+		{
+			// casual points are in jacobian coordinates, bring them to affine all at once
+			std::vector<Point::Native> vPts(mm.m_Casual);
+			std::vector<secp256k1_fe> vFes(mm.m_Casual);
+
+			Point::Native::BatchNormalizer_Arr bn;
+			bn.m_pPts = &vPts.front();
+			bn.m_pFes = &vFes.front();
+			bn.m_Size = 0;
+
+			for (int iEntry = 0; iEntry < mm.m_Casual; iEntry++)
+			{
+				const Point::Native& pt = mm.m_pCasual[iEntry].U.F.get().m_pPt[0];
+				const Scalar::Native& k = mm.m_pKCasual[iEntry];
+
+				if ((pt == Zero) || (k == Zero))
+					continue;
+
+				vPts[bn.m_Size++] = pt;
+				m_vpK.push_back(&k);
+			}
+
+			bn.Normalize();
+
+			m_vPts.resize(bn.m_Size);
+			for (uint32_t i = 0; i < bn.m_Size; i++)
+				Point::Native::BatchNormalizer::get_As(m_vPts[i], vPts[i]);
+		}
+
+		for (int iEntry = 0; iEntry < mm.m_Prepared; iEntry++)
+		{
+			const Scalar::Native& k = mm.m_pKPrep[iEntry];
+			if (k == Zero)
+				continue;
+
+			m_vPts.emplace_back();
+			secp256k1_ge_from_storage(&m_vPts.back(), &mm.m_ppPrepared[iEntry]->m_Fast.m_pPt[0]);
+			m_vpK.push_back(&k);
+		}
+	}
+
+	void MultiMac::Pippenger::Import(const Point::Storage* pPts, const Scalar::Native* pKs, uint32_t nCount)
+	{
+		m_vPts.reserve(nCount);
+		m_vpK.reserve(nCount);
+
+		for (uint32_t i = 0; i < nCount; i++)
+		{
+			if (memis0(pPts + i, sizeof(*pPts)) || (pKs[i] == Zero))
+				continue;
+
+			m_vPts.emplace_back();
+			secp256k1_ge& ge = m_vPts.back();
+			ZeroObject(ge);
+
+			secp256k1_fe_set_b32_mod(&ge.x, pPts[i].m_X.m_pData);
+			secp256k1_fe_set_b32_mod(&ge.y, pPts[i].m_Y.m_pData);
+
+			m_vpK.push_back(pKs + i);
+		}
+	}
+
+	void MultiMac::CalculateBuckets(Point::Native& res, const Point::Storage* pPts, const Scalar::Native* pKs, uint32_t nCount)
+	{
+		assert(Mode::Fast == g_Mode);
+
+		Pippenger pp;
+		pp.Import(pPts, pKs, nCount);
+		pp.Calculate(res);
+	}
+
+	unsigned int MultiMac::Pippenger::get_WndBits(uint32_t nTerms)
+	{
+		// Minimize the number of additions. Per window each term is added to its bucket, and summing 2^(nBits-1) buckets takes 2 additions per bucket.
+		// Digits must fit int16_t
+		unsigned int nRes = 1;
+		uint64_t nCostMin = static_cast<uint64_t>(-1);
+
+		for (unsigned int nBits = 1; nBits < 16; nBits++)
+		{
+			uint64_t nCost = static_cast<uint64_t>(ECC::nBits / nBits + 1) * (nTerms + (1U << nBits));
+			if (nCost < nCostMin)
+			{
+				nCostMin = nCost;
+				nRes = nBits;
+			}
+		}
+
+		return nRes;
+	}
+
+	unsigned int MultiMac::Pippenger::get_Bits(const Scalar::Native& k, unsigned int iBit, unsigned int nBits)
+	{
+		const unsigned int nBitsPerWord = sizeof(Scalar::Native::uint) << 3;
+		const unsigned int nWords = ECC::nBits / nBitsPerWord;
+
+		unsigned int iWord = iBit / nBitsPerWord;
+		if (iWord >= nWords)
+			return 0;
+
+		const Scalar::Native::uint* p = k.get().d;
+		unsigned int iBitInWord = iBit & (nBitsPerWord - 1);
+
+		Scalar::Native::uint n = p[iWord] >> iBitInWord;
+		if (iBitInWord && (iWord + 1 < nWords))
+			n |= p[iWord + 1] << (nBitsPerWord - iBitInWord);
+
+		return static_cast<unsigned int>(n) & ((1U << nBits) - 1);
+	}
+
+	void MultiMac::Pippenger::SetDigits(uint32_t iTerm)
+	{
+		const Scalar::Native& k = *m_vpK[iTerm];
+		const unsigned int nHalf = 1U << (m_WndBits - 1);
+		unsigned int nCarry = 0;
+
+		for (unsigned int iWnd = 0; iWnd < m_Windows; iWnd++)
+		{
+			int nVal = get_Bits(k, iWnd * m_WndBits, m_WndBits) + nCarry;
+
+			nCarry = (static_cast<unsigned int>(nVal) > nHalf);
+			if (nCarry)
+				nVal -= (1 << m_WndBits);
+
+			m_vDigits[static_cast<size_t>(iWnd) * m_vPts.size() + iTerm] = static_cast<int16_t>(nVal);
+		}
+
+		assert(!nCarry); // the extra window is enough
+	}
+
+	void MultiMac::Pippenger::CalculateWnd(uint32_t iWnd, Point::Native* pBuckets)
+	{
+		const unsigned int nBuckets = 1U << (m_WndBits - 1);
+		for (unsigned int i = 0; i < nBuckets; i++)
+			pBuckets[i] = Zero;
+
+		const int16_t* pDigits = &m_vDigits.front() + static_cast<size_t>(iWnd) * m_vPts.size();
+		secp256k1_ge ge;
+
+		for (size_t i = 0; i < m_vPts.size(); i++)
+		{
+			int nVal = pDigits[i];
+			if (!nVal)
+				continue;
+
+			if (nVal > 0)
+				secp256k1_gej_add_ge_var(&pBuckets[nVal - 1].get_Raw(), &pBuckets[nVal - 1].get_Raw(), &m_vPts[i], nullptr);
+			else
+			{
+				secp256k1_ge_neg(&ge, &m_vPts[i]);
+				secp256k1_gej_add_ge_var(&pBuckets[-nVal - 1].get_Raw(), &pBuckets[-nVal - 1].get_Raw(), &ge, nullptr);
+			}
+		}
+
+		Point::Native ptRunning = Zero;
+		Point::Native& res = m_vWnd[iWnd];
+		res = Zero;
+
+		for (unsigned int i = nBuckets; i--; )
+		{
+			ptRunning += pBuckets[i];
+			res += ptRunning;
+		}
+	}
+
+	void MultiMac::Pippenger::CalculateRange(uint32_t iWnd0, uint32_t nCount)
+	{
+		if (!nCount)
+			return;
+
+		std::vector<Point::Native> vBuckets(static_cast<size_t>(1) << (m_WndBits - 1));
+
+		for (nCount += iWnd0; iWnd0 < nCount; iWnd0++)
+			CalculateWnd(iWnd0, &vBuckets.front());
+	}
+
+	void MultiMac::Pippenger::Exec(beam::Executor::Context& ctx)
+	{
+		uint32_t i0, nCount;
+		ctx.get_Portion(i0, nCount, m_Windows);
+		CalculateRange(i0, nCount);
+	}
+
+	void MultiMac::Pippenger::Calculate(Point::Native& res)
+	{
+		res = Zero;
+
+		uint32_t nTerms = static_cast<uint32_t>(m_vPts.size());
+		if (!nTerms)
+			return;
+
+		m_WndBits = get_WndBits(nTerms);
+		m_Windows = ECC::nBits / m_WndBits + 1; // extra window for the carry
+
+		m_vDigits.resize(static_cast<size_t>(m_Windows) * nTerms);
+		for (uint32_t i = 0; i < nTerms; i++)
+			SetDigits(i);
+
+		m_vWnd.resize(m_Windows);
+
+		if (beam::Executor::s_pInstance && (nTerms >= s_MinParallel))
+			beam::Executor::s_pInstance->ExecAll(*this);
+		else
+			CalculateRange(0, m_Windows);
+
+		for (uint32_t iWnd = m_Windows; iWnd--; )
+		{
+			if (!(res == Zero))
+				for (unsigned int i = 0; i < m_WndBits; i++)
+					res = res * Two;
+
+			res += m_vWnd[iWnd];
+		}
+	}
+
 	void MultiMac::Calculate(Point::Native& res) const
 	{
+		// prepared points have bigger precalculated tables, hence cheaper for wNAF
+		if ((Mode::Fast == g_Mode) && (Reuse::None == m_ReuseFlag) && (static_cast<uint32_t>(m_Casual + (m_Prepared >> 1)) >= s_PippengerMin))
+		{
+			Pippenger pp;
+			pp.Import(*this);
+			pp.Calculate(res);
+			return;
+		}
+
 		const unsigned int nBitsPerWord = sizeof(Scalar::Native::uint) << 3;
 
 		static_assert(!(nBitsPerWord % Casual::Secure::nBits), "");
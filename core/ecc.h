@@ -153,6 +153,7 @@ namespace ECC
 
 		class Processor;
 		class Mac;
+		struct Multi;
 	};
 
 	typedef beam::Amount Amount;
@@ -200,6 +200,11 @@ namespace ECC
 		bool Import(const Storage&, bool bVerify);
 		void Export(Storage&) const;
 
+		// Batch conversion, zero points are allowed. Points are brought to affine form with a single inversion per chunk (Montgomery's trick).
+		// Big batches are converted in parallel over the Executor, if there's one.
+		// Currently only the Lelantus prover uses it.
+		static void ExportBatch(Point*, const Native*, uint32_t nCount);
+
 		struct BatchNormalizer
 		{
 			struct Element
@@ -422,14 +427,22 @@ namespace ECC
 
 		Reuse::Enum m_ReuseFlag;
 
+		// In fast mode big batches (unless reused) are calculated by the bucket method (Pippenger) instead of the interleaved wNAF.
+		// It's parallelized over the Executor, if there's one.
+		static uint32_t s_PippengerMin; // min number of terms. Can be adjusted (i.e. for tests)
+
 		MultiMac() { Reset(); }
 
 		void Reset();
 		void Calculate(Point::Native&) const;
 
+		// Bucket method over the points in the storage (affine) form, without the per-term tables. Zero points are allowed. Fast mode only.
+		static void CalculateBuckets(Point::Native&, const Point::Storage*, const Scalar::Native*, uint32_t nCount);
+
 	private:
 
 		struct Normalizer;
+		struct Pippenger;
 	};
 
 	template <int nMaxCasual, int nMaxPrepared>
@@ -657,6 +670,14 @@ namespace ECC
 		void operator >> (Value& hv) { Finalize(hv); }
 	};
 
+	// Multi-buffer hashing: many independent messages are hashed at once in SIMD lanes (SSE2, AVX2 or AVX-512, whichever is enabled for the build).
+	// Without SIMD support the messages are just hashed one by one. The result is the same as of Processor() << msg >> hv
+	struct Hash::Multi
+	{
+		static void Calculate(Value* pRes, const beam::Blob* pMsg, uint32_t nCount);
+		static void CalculatePairs(Value* pRes, const Value* pSrc, uint32_t nCount); // pRes[i] = H(pSrc[2*i] | pSrc[2*i+1]), i.e. Merkle nodes
+	};
+
 	class NonceGenerator
 	{
 		// RFC-5869
@@ -14,6 +14,7 @@
 
 #include "fly_client.h"
 #include "../utility/executor.h"
+#include "serialization_adapters.h"
 
 namespace beam {
 namespace proto {
@@ -171,6 +172,17 @@ void FlyClient::NetworkStd::Connection::ResetInternal()
         m_lst.pop_front();
         m_This.m_lst.push_back(n);
     }
+
+    for (auto& v : m_Coalesced)
+    {
+        while (!v.second.empty())
+        {
+            RequestNode& n = v.second.front();
+            v.second.pop_front();
+            m_This.m_lst.push_back(n);
+        }
+    }
+    m_Coalesced.clear();
 }
 
 void FlyClient::NetworkStd::Connection::SendLoginPlus()
@@ -205,6 +217,7 @@ void FlyClient::NetworkStd::Connection::SetupLogin(Login& msg)
         msg.m_Flags |= LoginFlags::MiningFinalization;
     if (m_This.HasDependentSubscriptions())
         msg.m_Flags |= LoginFlags::WantDependentState;
+    msg.m_Flags |= LoginFlags::WantEventsPush; // relevant only for owned nodes
 
     m_This.OnLoginSetup(msg);
 }
@@ -398,6 +411,7 @@ void FlyClient::NetworkStd::Connection::StartSync()
     if (sTip.IsNext(m_Tip))
     {
         // simple case
+        m_This.m_Cache.Clear();
         m_This.m_Client.get_History().AddStates(&m_Tip, 1);
         PrioritizeSelf();
         AssignRequests();
@@ -617,6 +631,8 @@ void FlyClient::NetworkStd::Connection::PostChainworkProof(const StateArray& arr
 
     m_This.m_Client.get_History().Enum(w, NULL);
 
+    m_This.m_Cache.Clear();
+
     if (w.m_LowErase != MaxHeight)
     {
         m_This.m_Client.get_History().DeleteFrom(w.m_LowErase);
@@ -778,6 +794,168 @@ FlyClient::NetworkStd::RequestNode& FlyClient::NetworkStd::Connection::get_First
     return n;
 }
 
+template <typename TReq>
+bool FlyClient::NetworkStd::Connection::AssignCached(TReq& req)
+{
+    RequestNode& n = m_lst.back(); // SendRequest is called on the most recently added request
+    assert(&req == n.m_pRequest);
+
+    n.m_CacheKey = Zero;
+    if (!m_This.m_Cfg.m_CacheSize || !IsCacheable(req))
+        return false;
+
+    Serializer ser;
+    ser & req.m_Msg;
+    auto buf = ser.buffer();
+
+    ECC::Hash::Processor()
+        << static_cast<uint32_t>(TReq::s_Type)
+        << Blob(buf.first, static_cast<uint32_t>(buf.second))
+        >> n.m_CacheKey;
+
+    Merkle::Hash hvTip;
+    m_Tip.get_Hash(hvTip);
+
+    const ByteBuffer* pRes = m_This.m_Cache.Find(n.m_CacheKey, hvTip);
+    if (pRes)
+    {
+        Deserializer der;
+        der.reset(*pRes);
+        der & req.m_Res;
+
+        OnDone(n);
+        return true;
+    }
+
+    auto it = m_Coalesced.find(n.m_CacheKey);
+    if (m_Coalesced.end() == it)
+    {
+        m_Coalesced[n.m_CacheKey]; // will be sent, identical requests will wait for it
+        return false;
+    }
+
+    m_lst.erase(RequestList::s_iterator_to(n));
+    it->second.push_back(n);
+    return true;
+}
+
+template <typename TReq>
+void FlyClient::NetworkStd::Connection::OnCacheableDone(RequestNode& n, const TReq& req, CoalescedDone& cd)
+{
+    if (n.m_CacheKey == Zero)
+        return;
+
+    auto it = m_Coalesced.find(n.m_CacheKey);
+    if (m_Coalesced.end() != it)
+    {
+        cd.m_lst.swap(it->second);
+        m_Coalesced.erase(it);
+    }
+
+    if (!IsAtTip())
+    {
+        // the request will be retried, so should be the coalesced ones
+        while (!cd.m_lst.empty())
+        {
+            RequestNode& x = cd.m_lst.front();
+            cd.m_lst.pop_front();
+            m_This.m_lst.push_back(x);
+        }
+        return;
+    }
+
+    Serializer ser;
+    ser & req.m_Res;
+    ser.swap_buf(cd.m_Res);
+
+    Merkle::Hash hvTip;
+    m_Tip.get_Hash(hvTip);
+    m_This.m_Cache.Insert(n.m_CacheKey, hvTip, cd.m_Res, m_This.m_Cfg.m_CacheSize);
+}
+
+template <typename TReq>
+void FlyClient::NetworkStd::Connection::CoalescedDone::Finish()
+{
+    while (!m_lst.empty())
+    {
+        RequestNode& n = m_lst.front();
+        if (n.m_pRequest->m_pTrg)
+        {
+            Deserializer der;
+            der.reset(m_Res);
+            der & n.m_pRequest->As<TReq>().m_Res;
+        }
+
+        m_lst.Finish(n);
+    }
+}
+
+void FlyClient::NetworkStd::Cache::Delete(Entry& x)
+{
+    assert(m_Size >= x.get_Size());
+    m_Size -= x.get_Size();
+
+    m_Lru.erase(Lru::s_iterator_to(x));
+    m_Set.erase(Set::s_iterator_to(x));
+    delete &x;
+}
+
+void FlyClient::NetworkStd::Cache::Clear()
+{
+    while (!m_Lru.empty())
+        Delete(m_Lru.front());
+}
+
+void FlyClient::NetworkStd::Cache::SetTip(const Merkle::Hash& hvTip)
+{
+    if (m_Tip != hvTip)
+    {
+        Clear();
+        m_Tip = hvTip;
+    }
+}
+
+const ByteBuffer* FlyClient::NetworkStd::Cache::Find(const Merkle::Hash& hvKey, const Merkle::Hash& hvTip)
+{
+    SetTip(hvTip);
+
+    auto it = m_Set.find(hvKey, Entry::Comparator());
+    if (m_Set.end() == it)
+        return nullptr;
+
+    Entry& x = *it;
+    m_Lru.erase(Lru::s_iterator_to(x));
+    m_Lru.push_back(x);
+
+    return &x.m_Res;
+}
+
+void FlyClient::NetworkStd::Cache::Insert(const Merkle::Hash& hvKey, const Merkle::Hash& hvTip, const ByteBuffer& res, size_t nMaxSize)
+{
+    SetTip(hvTip);
+
+    if (m_Set.end() != m_Set.find(hvKey, Entry::Comparator()))
+        return; // answered by another connection
+
+    Entry* p = new Entry;
+    p->m_Key = hvKey;
+    p->m_Res = res;
+
+    size_t nSize = p->get_Size();
+    if (nSize > nMaxSize)
+    {
+        delete p;
+        return;
+    }
+
+    while (m_Size + nSize > nMaxSize)
+        Delete(m_Lru.front());
+
+    m_Size += nSize;
+    m_Lru.push_back(*p);
+    m_Set.insert(*p);
+}
+
 #define REQUEST_STD_RCV(type, msgIn) \
 void FlyClient::NetworkStd::Connection::OnMsg(msgIn&& msg) \
 { \
@@ -787,7 +965,10 @@ void FlyClient::NetworkStd::Connection::OnMsg(msgIn&& msg) \
  \
      OnRequestData(r); \
  \
+    CoalescedDone cd; \
+    OnCacheableDone(n, r, cd); \
     OnDone(n); \
+    cd.Finish<Request##type>(); \
 }
 
 
@@ -799,7 +980,8 @@ bool FlyClient::NetworkStd::Connection::SendRequest(Request##type& req) \
     if (!IsSupported(req)) \
         return false; \
  \
-    Send(req.m_Msg); \
+    if (!AssignCached(req)) \
+        Send(req.m_Msg); \
     return true; \
 }
 
@@ -1051,7 +1233,8 @@ bool FlyClient::NetworkStd::Connection::SendRequest(RequestContractVars& req)
     if (!SendTrgCtx(req.m_pCtx))
         return false;
 
-    Send(req.m_Msg);
+    if (!AssignCached(req))
+        Send(req.m_Msg);
     return true;
 }
 
@@ -1236,6 +1419,14 @@ void FlyClient::NetworkStd::Connection::OnMsg(EventsSerif&& msg)
     m_This.m_Client.OnEventsSerif(msg.m_Value, msg.m_Height);
 }
 
+void FlyClient::NetworkStd::Connection::OnMsg(EventsPush&& msg)
+{
+    if (!(Flags::Owned & m_Flags) || (msg.m_HeightMin > msg.m_HeightMax))
+        ThrowUnexpected();
+
+    m_This.m_Client.OnEventsPush(msg.m_HeightMin, msg.m_HeightMax, msg.m_Events);
+}
+
 void FlyClient::NetworkStd::Connection::OnMsg(PeerInfo&& msg)
 {
     m_This.m_Client.OnNewPeer(msg.m_ID, msg.m_LastAddr);
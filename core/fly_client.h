@@ -168,6 +168,7 @@ namespace proto {
 		virtual Block::SystemState::IHistory& get_History() = 0;
 		virtual void OnOwnedNode(const PeerID&, bool bUp) {}
 		virtual void OnEventsSerif(const ECC::Hash::Value&, Height) {}
+		virtual void OnEventsPush(Height hMin, Height hMax, const ByteBuffer&) {} // events of the owned node pushed for the range [hMin, hMax], may arrive before the tip is updated
 		virtual void OnNewPeer(const PeerID& id, io::Address address) {}
 		virtual void OnDependentStateChanged() {}
 
@@ -204,6 +205,7 @@ namespace proto {
 				:public boost::intrusive::list_base_hook<>
 			{
 				Request::Ptr m_pRequest;
+				Merkle::Hash m_CacheKey = Zero; // set when a cacheable request is sent
 			};
 
 			struct RequestList
@@ -215,11 +217,43 @@ namespace proto {
 			RequestList m_lst; // idle
 			void OnNewRequests();
 
+			// Recent node responses, keyed by the request type and message. All of them are valid for the same tip only,
+			// and are dropped once the tip changes.
+			struct Cache
+			{
+				struct Entry
+					:public boost::intrusive::list_base_hook<>
+					,public intrusive::set_base_hook<Merkle::Hash>
+				{
+					ByteBuffer m_Res;
+					size_t get_Size() const { return sizeof(*this) + m_Res.size(); }
+				};
+
+				typedef boost::intrusive::list<Entry> Lru; // least recently used first
+				typedef boost::intrusive::multiset<Entry> Set;
+
+				Lru m_Lru;
+				Set m_Set;
+				Merkle::Hash m_Tip = Zero;
+				size_t m_Size = 0;
+
+				~Cache() { Clear(); }
+
+				void Clear();
+				void Delete(Entry&);
+				const ByteBuffer* Find(const Merkle::Hash& hvKey, const Merkle::Hash& hvTip);
+				void Insert(const Merkle::Hash& hvKey, const Merkle::Hash& hvTip, const ByteBuffer& res, size_t nMaxSize);
+
+			private:
+				void SetTip(const Merkle::Hash& hvTip);
+			} m_Cache;
+
 			struct Config {
 				std::vector<io::Address> m_vNodes;
 				uint32_t m_PollPeriod_ms = 0; // set to 0 to keep connection. Anyway poll period would be no less than the expected rate of blocks
 				uint32_t m_ReconnectTimeout_ms = 5000;
                 uint32_t m_CloseConnectionDelay_ms = 1000;
+				uint32_t m_CacheSize = 4 * 1024 * 1024; // max size of the cached responses, set to 0 to disable caching and coalescing of identical requests
 				bool m_UseProxy = false;
 				bool m_PreferOnlineMining = true;
 				io::Address m_ProxyAddr;
@@ -284,6 +318,23 @@ namespace proto {
 				void AssignRequests();
 				void AssignRequest(RequestNode&);
 
+				// requests waiting for the identical one in progress, by the cache key
+				std::map<Merkle::Hash, RequestList> m_Coalesced;
+
+				struct CoalescedDone
+				{
+					RequestList m_lst;
+					ByteBuffer m_Res;
+
+					template <typename TReq>
+					void Finish();
+				};
+
+				template <typename TReq>
+				bool AssignCached(TReq&);
+				template <typename TReq>
+				void OnCacheableDone(RequestNode&, const TReq&, CoalescedDone&);
+
 				void SendLoginPlus();
 
 				bool IsAtTip() const;
@@ -308,6 +359,7 @@ namespace proto {
 				void OnMsg(proto::ProofChainWork&& msg) override;
 				void OnMsg(proto::BbsMsg&& msg) override;
 				void OnMsg(proto::EventsSerif&& msg) override;
+				void OnMsg(proto::EventsPush&& msg) override;
 				void OnMsg(proto::DataMissing&& msg) override;
 				void OnMsg(proto::PeerInfo&& msg) override;
 				void OnMsg(proto::DependentContextChanged&& msg) override;
@@ -330,6 +382,13 @@ namespace proto {
 				bool IsSupported(RequestEvents&);
 				bool IsSupported(RequestTransaction&);
 
+				bool IsCacheable(const Data::Std&) { return false; }
+				bool IsCacheable(const RequestUtxo&) { return true; }
+				bool IsCacheable(const RequestKernel2&) { return true; }
+				bool IsCacheable(const RequestAsset&) { return true; }
+				bool IsCacheable(const RequestShieldedList&) { return true; }
+				bool IsCacheable(const RequestContractVars& req) { return !req.m_pCtx; } // dependent state may change without a new tip
+
 				void OnRequestData(const Data::Std&) {}
 				void OnRequestData(RequestUtxo&);
 				void OnRequestData(RequestKernel&);
@@ -0,0 +1,172 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iblt.h"
+#include <set>
+
+namespace beam
+{
+	uint32_t Iblt::get_CellsFor(uint32_t nDiff)
+	{
+		// Asymptotically ~1.3x cells would suffice, but for small differences the failure rate is dominated by several keys
+		// colliding in all their cells. The following gives decode failure rate below ~0.2% for all the sizes.
+		uint32_t nCells = nDiff * 2 + s_Hashes * 8;
+		return nCells - (nCells % s_Hashes);
+	}
+
+	void Iblt::Reset(uint32_t nCells, uint64_t salt)
+	{
+		assert(!(nCells % s_Hashes));
+
+		m_Salt = salt;
+		m_vCells.resize(nCells);
+
+		for (uint32_t i = 0; i < nCells; i++)
+			m_vCells[i].Reset();
+	}
+
+	uint64_t Iblt::Mix(uint64_t x)
+	{
+		// splitmix64 finalizer
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ULL;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebULL;
+		x ^= x >> 31;
+		return x;
+	}
+
+	uint64_t Iblt::get_Hash(const Key& key) const
+	{
+		uint64_t ret = m_Salt;
+
+		// endian-independent, must be the same for all the peers
+		for (uint32_t i = 0; i < Key::nBytes; )
+		{
+			uint64_t w = 0;
+			for (uint32_t iEnd = i + sizeof(w); i < iEnd; i++)
+				w = (w << 8) | key.m_pData[i];
+
+			ret = Mix(ret ^ w);
+		}
+
+		return ret;
+	}
+
+	uint32_t Iblt::get_Check(uint64_t hash)
+	{
+		return static_cast<uint32_t>(Mix(hash + 0x9e3779b97f4a7c15ULL));
+	}
+
+	uint32_t Iblt::get_Idx(uint64_t hash, uint32_t iHash) const
+	{
+		uint32_t nPart = static_cast<uint32_t>(m_vCells.size()) / s_Hashes;
+		assert(nPart);
+
+		uint64_t val = Mix(hash + iHash);
+		return iHash * nPart + static_cast<uint32_t>(val % nPart);
+	}
+
+	void Iblt::Toggle(const Key& key, int32_t nDelta)
+	{
+		if (m_vCells.empty())
+			return;
+
+		uint64_t hash = get_Hash(key);
+		uint32_t nCheck = get_Check(hash);
+
+		for (uint32_t iHash = 0; iHash < s_Hashes; iHash++)
+		{
+			Cell& c = m_vCells[get_Idx(hash, iHash)];
+			c.m_Count += nDelta;
+			c.m_Check ^= nCheck;
+			c.m_KeySum ^= key;
+		}
+	}
+
+	bool Iblt::Subtract(const std::vector<Cell>& v)
+	{
+		if (v.size() != m_vCells.size())
+			return false;
+
+		for (size_t i = 0; i < v.size(); i++)
+		{
+			Cell& c = m_vCells[i];
+			c.m_Count -= v[i].m_Count;
+			c.m_Check ^= v[i].m_Check;
+			c.m_KeySum ^= v[i].m_KeySum;
+		}
+
+		return true;
+	}
+
+	bool Iblt::IsPure(const Cell& c) const
+	{
+		return
+			((1 == c.m_Count) || (-1 == c.m_Count)) &&
+			(get_Check(get_Hash(c.m_KeySum)) == c.m_Check);
+	}
+
+	bool Iblt::Decode(std::vector<Key>& vPos, std::vector<Key>& vNeg)
+	{
+		std::vector<uint32_t> vQueue;
+		for (uint32_t i = 0; i < m_vCells.size(); i++)
+			if (IsPure(m_vCells[i]))
+				vQueue.push_back(i);
+
+		// The table may come from a remote peer. A crafted one can make the same key pure again after it's peeled
+		// (with the opposite sign), which would loop forever. Each key may be decoded once, and no more keys than cells.
+		std::set<Key> setDecoded;
+
+		while (!vQueue.empty())
+		{
+			const Cell& c = m_vCells[vQueue.back()];
+			vQueue.pop_back();
+
+			if (!IsPure(c))
+				continue; // already peeled via another cell
+
+			int32_t nCount = c.m_Count;
+			Key key = c.m_KeySum;
+
+			if ((setDecoded.size() >= m_vCells.size()) || !setDecoded.insert(key).second)
+				return false;
+
+			((nCount > 0) ? vPos : vNeg).push_back(key);
+
+			uint64_t hash = get_Hash(key);
+			uint32_t nCheck = get_Check(hash);
+
+			for (uint32_t iHash = 0; iHash < s_Hashes; iHash++)
+			{
+				uint32_t iCell = get_Idx(hash, iHash);
+				Cell& c2 = m_vCells[iCell];
+
+				c2.m_Count -= nCount;
+				c2.m_Check ^= nCheck;
+				c2.m_KeySum ^= key;
+
+				if (IsPure(c2))
+					vQueue.push_back(iCell);
+			}
+		}
+
+		for (uint32_t i = 0; i < m_vCells.size(); i++)
+			if (!m_vCells[i].IsEmpty())
+				return false;
+
+		return true;
+	}
+
+} // namespace beam
@@ -0,0 +1,85 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "uintBig.h"
+
+namespace beam
+{
+	// Invertible Bloom Lookup Table over 256-bit keys (tx keys, bbs msg IDs).
+	// Two parties fill tables of the same geometry (num of cells and salt) with their sets, one is subtracted from another,
+	// and the result is peeled to recover the symmetric difference. Elements present in both sets cancel out.
+	// The keys are assumed to be uniformly distributed (hashes), so that no cryptographic hashing is needed for cell selection.
+	struct Iblt
+	{
+		typedef uintBig_t<32> Key;
+
+		static const uint32_t s_Hashes = 4; // cells are partitioned into s_Hashes subtables, each key occupies 1 cell in each
+
+		struct Cell
+		{
+			int32_t m_Count;
+			uint32_t m_Check;
+			Key m_KeySum;
+
+			void Reset()
+			{
+				m_Count = 0;
+				m_Check = 0;
+				m_KeySum = Zero;
+			}
+
+			bool IsEmpty() const
+			{
+				return !m_Count && !m_Check && (m_KeySum == Zero);
+			}
+
+			template <typename Archive>
+			void serialize(Archive& ar)
+			{
+				ar
+					& m_Count
+					& m_Check
+					& m_KeySum;
+			}
+		};
+
+		std::vector<Cell> m_vCells;
+		uint64_t m_Salt = 0;
+
+		// num of cells sufficient to decode the given difference with high probability. Always a multiple of s_Hashes
+		static uint32_t get_CellsFor(uint32_t nDiff);
+
+		void Reset(uint32_t nCells, uint64_t salt); // nCells must be a multiple of s_Hashes
+
+		void Add(const Key& key) { Toggle(key, 1); }
+		void Remove(const Key& key) { Toggle(key, -1); }
+
+		bool Subtract(const std::vector<Cell>&); // returns false if the geometry doesn't match
+
+		// Destructive. vPos receives keys that were added (present only in the minuend), vNeg - removed (present only in the subtrahend).
+		// Returns false if the table couldn't be peeled completely (the difference is too big for this table).
+		bool Decode(std::vector<Key>& vPos, std::vector<Key>& vNeg);
+
+	private:
+		void Toggle(const Key&, int32_t nDelta);
+		uint64_t get_Hash(const Key&) const;
+		static uint64_t Mix(uint64_t);
+		static uint32_t get_Check(uint64_t hash);
+		uint32_t get_Idx(uint64_t hash, uint32_t iHash) const;
+		bool IsPure(const Cell&) const;
+	};
+
+} // namespace beam
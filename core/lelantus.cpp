@@ -78,13 +78,10 @@ struct CommitmentStd
 			mm.m_pKPrep[iIdx] = blinding;
 	}
 
-	void Calculate(Point& res, MultiMacMy& mm, const Scalar::Native& blinding)
+	void Calculate(Point::Native& res, MultiMacMy& mm, const Scalar::Native& blinding)
 	{
 		FillEquation(mm, blinding);
-		Point::Native resN;
-		mm.Calculate(resN);
-
-		res = resN;
+		mm.Calculate(res);
 	}
 
 	// A + B*x =?= Commitment(..., z)
@@ -117,18 +114,13 @@ void CmList::Import(MultiMac& mm, uint32_t iPos, uint32_t nCount)
 	}
 }
 
-void CmList::Calculate(Point::Native& res, uint32_t iPos, uint32_t nCount, const Scalar::Native* pKs)
+static void CalculateCmList(CmList& lst, MultiMac& mm, uint32_t nSizeNaggle, Point::Native& res, uint32_t iPos, uint32_t nCount, const Scalar::Native* pKs)
 {
-	Mode::Scope scope(Mode::Fast);
-
-	const uint32_t nSizeNaggle = 128;
-	MultiMac_WithBufs<nSizeNaggle, 1> mm;
-
 	Point::Native comm;
 
 	while (true)
 	{
-		Import(mm, iPos, std::min(nSizeNaggle, nCount));
+		lst.Import(mm, iPos, std::min(nSizeNaggle, nCount));
 		mm.m_pKCasual = Cast::NotConst(pKs + iPos);
 
 		mm.Calculate(comm);
@@ -142,6 +134,46 @@ void CmList::Calculate(Point::Native& res, uint32_t iPos, uint32_t nCount, const
 	}
 }
 
+static void CalculateCmListBuckets(CmList& lst, uint32_t nSizeNaggle, Point::Native& res, uint32_t iPos, uint32_t nCount, const Scalar::Native* pKs)
+{
+	// The points are already in the affine form, feed them to the bucket method as-is, without the MultiMac tables
+	std::vector<Point::Storage> vPts(std::min(nSizeNaggle, nCount));
+	Point::Native comm;
+
+	while (true)
+	{
+		uint32_t n = 0;
+		for (uint32_t nMax = std::min(nSizeNaggle, nCount); n < nMax; n++)
+			if (!lst.get_At(vPts[n], iPos + n))
+				break;
+
+		MultiMac::CalculateBuckets(comm, vPts.data(), pKs + iPos, n);
+		res += comm;
+
+		iPos += n;
+		nCount -= n;
+
+		if (!nCount || (n < nSizeNaggle))
+			break;
+	}
+}
+
+void CmList::Calculate(Point::Native& res, uint32_t iPos, uint32_t nCount, const Scalar::Native* pKs)
+{
+	Mode::Scope scope(Mode::Fast);
+
+	if (nCount >= MultiMac::s_PippengerMin)
+		// bucket method is more efficient for bigger portions
+		CalculateCmListBuckets(*this, 0x10000, res, iPos, nCount, pKs);
+	else
+	{
+		const uint32_t nSizeNaggle = 128;
+		MultiMac_WithBufs<nSizeNaggle, 1> mm;
+
+		CalculateCmList(*this, mm, nSizeNaggle, res, iPos, nCount, pKs);
+	}
+}
+
 ///////////////////////////
 // Cfg
 uint32_t Cfg::get_N() const
@@ -420,64 +452,176 @@ void Prover::InitNonces(const uintBig& seed)
 	}
 }
 
-void Prover::CalculateP()
+void Prover::CalculateP_Part(uint32_t j, uint32_t nPwr, uint32_t t0, uint32_t t1)
 {
-	m_p[0] = 1U;
+	// The coefficients of different t are independent, so the range can be processed in parallel
+	const uint32_t N = m_nLo;
 
-	const uint32_t N = m_Cfg.get_N();
-	assert(N);
+	const Scalar::Native* pA = m_a + m_Cfg.n * j;
+	Scalar::Native* pP = m_p + N * (j + 1);
 
-	Scalar::Native* pA = m_a;
-	Scalar::Native* pP = m_p;
-	uint32_t nPwr = 1;
-	for (uint32_t j = 0; j < m_Cfg.M; j++)
+	uint32_t i0 = (m_Witness.m_L / nPwr) % m_Cfg.n;
+
+	for (uint32_t i = m_Cfg.n; i--; )
 	{
-		uint32_t i0 = (m_Witness.m_L / nPwr) % m_Cfg.n;
+		bool bMatch = (i == i0);
 
-		pP += N;
+		if (j + 1 < m_Cfg.M)
+		{
+			for (uint32_t t = t1; t-- > t0; )
+				if (bMatch)
+					pP[i * nPwr + t] = pP[static_cast<int32_t>(t - N)];
+				else
+					pP[i * nPwr + t] = Zero;
+		}
+
+		Scalar::Native* pP0 = pP;
 
-		for (uint32_t i = m_Cfg.n; i--; )
+		for (uint32_t k = j; ; )
 		{
-			bool bMatch = (i == i0);
+			pP0 -= N;
 
-			if (j + 1 < m_Cfg.M)
+			for (uint32_t t = t1; t-- > t0; )
 			{
-				for (uint32_t t = nPwr; t--; )
-					if (bMatch)
-						pP[i * nPwr + t] = pP[static_cast<int32_t>(t - N)];
-					else
-						pP[i * nPwr + t] = Zero;
+				if (i)
+					pP0[i * nPwr + t] = pP0[t];
+				pP0[i * nPwr + t] *= pA[i];
+
+				if (bMatch && k)
+					pP0[i * nPwr + t] += pP0[static_cast<int32_t>(t - N)];
 			}
 
-			Scalar::Native* pP0 = pP;
+			if (!k--)
+				break;
+		}
+	}
+}
 
-			for (uint32_t k = j; ; )
-			{
-				pP0 -= N;
+void Prover::CalculateP()
+{
+	struct MyTask
+		:public Executor::TaskSync
+	{
+		Prover* m_pThis;
+		uint32_t m_j;
+		uint32_t m_nPwr;
 
-				for (uint32_t t = nPwr; t--; )
-				{
-					if (i)
-						pP0[i * nPwr + t] = pP0[t];
-					pP0[i * nPwr + t] *= pA[i];
+		virtual void Exec(Executor::Context& ctx) override
+		{
+			uint32_t t0, nCount;
+			ctx.get_Portion(t0, nCount, m_nPwr);
 
-					if (bMatch && k)
-						pP0[i * nPwr + t] += pP0[static_cast<int32_t>(t - N)];
-				}
+			m_pThis->CalculateP_Part(m_j, m_nPwr, t0, t0 + nCount);
+		}
 
-				if (!k--)
-					break;
-			}
+	} t;
+
+	t.m_pThis = this;
+
+	m_p[0] = 1U;
+
+	const uint32_t nMinParallel = 0x100;
+
+	uint32_t nPwr = 1;
+	for (uint32_t j = 0; j < m_nLoDigits; j++)
+	{
+		if (Executor::s_pInstance && (nPwr >= nMinParallel))
+		{
+			t.m_j = j;
+			t.m_nPwr = nPwr;
+			Executor::s_pInstance->ExecAll(t);
 		}
+		else
+			CalculateP_Part(j, nPwr, 0, nPwr);
 
-		pA += m_Cfg.n;
 		nPwr *= m_Cfg.n;
 	}
 }
 
+void Prover::CalculateP_Hi(Scalar::Native* pQ, uint32_t iHi) const
+{
+	// product of the polynomials of the higher digits, its degree is M - m_nLoDigits
+	pQ[0] = 1U;
+
+	uint32_t nL_Reduced = m_Witness.m_L / m_nLo;
+
+	for (uint32_t j = m_nLoDigits, nDeg = 0; j < m_Cfg.M; j++, nDeg++)
+	{
+		uint32_t i = iHi % m_Cfg.n;
+		bool bMatch = ((nL_Reduced % m_Cfg.n) == i);
+
+		iHi /= m_Cfg.n;
+		nL_Reduced /= m_Cfg.n;
+
+		const Scalar::Native& a = m_a[j * m_Cfg.n + i];
+
+		// multiply by (a + x) if match, or by a otherwise
+		if (bMatch)
+			pQ[nDeg + 1] = pQ[nDeg];
+		else
+			pQ[nDeg + 1] = Zero;
+
+		for (uint32_t k = nDeg; ; k--)
+		{
+			pQ[k] *= a;
+			if (!k)
+				break;
+
+			if (bMatch)
+				pQ[k] += pQ[k - 1];
+		}
+	}
+}
+
+void Prover::get_P(Scalar::Native* pRes, uint32_t nStride, uint32_t i0, uint32_t nCount) const
+{
+	// pRes[k * nStride + i] = coefficient of x^k for element i0+i
+	if (m_nLoDigits == m_Cfg.M)
+	{
+		// all precalculated
+		for (uint32_t k = 0; k < m_Cfg.M; k++)
+			for (uint32_t i = 0; i < nCount; i++)
+				pRes[k * nStride + i] = m_p[k * m_nLo + i0 + i];
+		return;
+	}
+
+	const uint32_t nDegHi = m_Cfg.M - m_nLoDigits;
+
+	Scalar::Native pQ[Cfg::Max::M + 1], v;
+	uint32_t iHiLast = static_cast<uint32_t>(-1);
+
+	for (uint32_t i = 0; i < nCount; i++)
+	{
+		uint32_t iLo = (i0 + i) % m_nLo;
+		uint32_t iHi = (i0 + i) / m_nLo;
+
+		if (iHi != iHiLast)
+		{
+			CalculateP_Hi(pQ, iHi);
+			iHiLast = iHi;
+		}
+
+		for (uint32_t k = 0; k < m_Cfg.M; k++)
+		{
+			Scalar::Native& res = pRes[k * nStride + i];
+			res = Zero;
+
+			// lower part has m_nLoDigits+1 coefficients, the higher part has nDegHi+1
+			uint32_t b0 = (k > m_nLoDigits) ? (k - m_nLoDigits) : 0;
+			for (uint32_t b = b0; (b <= k) && (b <= nDegHi); b++)
+			{
+				v = m_p[(k - b) * m_nLo + iLo];
+				v *= pQ[b];
+				res += v;
+			}
+		}
+	}
+}
+
 void Prover::ExtractABCD()
 {
 	CommitmentStd::MultiMacMy mm(m_Cfg);
+	Point::Native pRes[4];
 
 	{
 		struct Commitment_A :public CommitmentStd
@@ -490,7 +634,7 @@ void Prover::ExtractABCD()
 		} c;
 		c.m_p = this;
 		c.m_pCfg = &m_Cfg;
-		c.Calculate(m_Proof.m_Part1.m_A, mm, m_vBuf[Idx::rA]);
+		c.Calculate(pRes[0], mm, m_vBuf[Idx::rA]);
 	}
 
 	{
@@ -513,7 +657,7 @@ void Prover::ExtractABCD()
 
 		c.m_L_Reduced = m_Witness.m_L;
 		c.m_pCfg = &m_Cfg;
-		c.Calculate(m_Proof.m_Part1.m_B, mm, m_vBuf[Idx::rB]);
+		c.Calculate(pRes[1], mm, m_vBuf[Idx::rB]);
 	}
 
 	{
@@ -538,7 +682,7 @@ void Prover::ExtractABCD()
 		c.m_p = this;
 		c.m_pCfg = &m_Cfg;
 		c.m_L_Reduced = m_Witness.m_L;
-		c.Calculate(m_Proof.m_Part1.m_C, mm, m_vBuf[Idx::rC]);
+		c.Calculate(pRes[2], mm, m_vBuf[Idx::rC]);
 	}
 
 	{
@@ -555,8 +699,16 @@ void Prover::ExtractABCD()
 
 		c.m_p = this;
 		c.m_pCfg = &m_Cfg;
-		c.Calculate(m_Proof.m_Part1.m_D, mm, m_vBuf[Idx::rD]);
+		c.Calculate(pRes[3], mm, m_vBuf[Idx::rD]);
 	}
+
+	Point pPt[_countof(pRes)];
+	Point::Native::ExportBatch(pPt, pRes, _countof(pRes));
+
+	m_Proof.m_Part1.m_A = pPt[0];
+	m_Proof.m_Part1.m_B = pPt[1];
+	m_Proof.m_Part1.m_C = pPt[2];
+	m_Proof.m_Part1.m_D = pPt[3];
 }
 
 struct Prover::GB
@@ -579,30 +731,28 @@ void Prover::ExtractG_Part(GB* pGB, uint32_t i0, uint32_t i1)
 
 	Point::Native comm;
 
-	const uint32_t N = m_Cfg.get_N();
-	assert(N);
+	std::unique_ptr<Scalar::Native[]> pP(new Scalar::Native[nSizeNaggle * m_Cfg.M]);
 
 	while (i0 < i1)
 	{
 		m_List.Import(mm, i0, std::min(nSizeNaggle, i1 - i0));
 		mm.m_ReuseFlag = MultiMac::Reuse::Generate;
 
-		Scalar::Native* pP = m_p;
+		get_P(pP.get(), nSizeNaggle, i0, static_cast<uint32_t>(mm.m_Casual));
+
 		for (uint32_t k = 0; k < m_Cfg.M; k++)
 		{
 			GB& gb = pGB[k];
 
-			mm.m_pKCasual = pP + i0;
+			mm.m_pKCasual = pP.get() + nSizeNaggle * k;
 
 			for (uint32_t i = 0; i < static_cast<uint32_t>(mm.m_Casual); i++)
-				gb.m_kBias += pP[i0 + i];
+				gb.m_kBias += mm.m_pKCasual[i];
 
 			mm.Calculate(comm);
 			gb.m_G += comm;
 
 			mm.m_ReuseFlag = MultiMac::Reuse::UseGenerated;
-
-			pP += N;
 		}
 
 		i0 += mm.m_Casual;
@@ -673,10 +823,11 @@ void Prover::ExtractG(const Point::Native& ptBias)
 	mm.m_Casual = 1;
 	mm.m_ReuseFlag = MultiMac::Reuse::Generate;
 
-	ECC::Point::Native comm;
+	std::vector<Point::Native> vG(m_Cfg.M);
 	for (uint32_t k = 0; k < m_Cfg.M; k++)
 	{
 		GB& gb = t.m_vGB[k];
+		Point::Native& comm = vG[k];
 
 		mm.m_pKPrep = m_Tau + k;
 		mm.m_pKCasual = &gb.m_kBias;
@@ -692,9 +843,9 @@ void Prover::ExtractG(const Point::Native& ptBias)
 			mm.m_ReuseFlag = MultiMac::Reuse::UseGenerated;
 			mm.m_Prepared = 1;
 		}
-
-		m_Proof.m_Part1.m_vG[k] = comm;
 	}
+
+	Point::Native::ExportBatch(&m_Proof.m_Part1.m_vG.front(), &vG.front(), m_Cfg.M);
 }
 
 void Prover::ExtractBlinded(Scalar& out, const Scalar::Native& sk, const Scalar::Native& challenge, const Scalar::Native& nonce)
@@ -762,12 +913,24 @@ void Prover::Generate(const uintBig& seed, Oracle& oracle, const Point::Native&
 	// Since this is a heavy proof, do it in 'fast' mode. Use 'secure' mode only for the most sensitive part - the SpendSk
 	Mode::Scope scope(Mode::Fast);
 
-	const uint32_t N = m_Cfg.get_N();
-	assert(N);
+	assert(m_Cfg.get_N());
 
 	if (Phase::Step2 != ePhase)
 	{
-		m_vBuf.reset(new Scalar::Native[Idx::count + m_Cfg.M * (1 + m_Cfg.n + N)]);
+		// precalculate the coefficients for as many lower digits as allowed
+		m_nLoDigits = 0;
+		m_nLo = 1;
+
+		while ((m_nLoDigits < m_Cfg.M) && (m_nLo * m_Cfg.n <= m_nPrecalcMax))
+		{
+			m_nLoDigits++;
+			m_nLo *= m_Cfg.n;
+		}
+
+		// the higher coefficient is needed as well, unless all the digits are covered
+		uint32_t nRows = std::min(m_nLoDigits + 1, m_Cfg.M);
+
+		m_vBuf.reset(new Scalar::Native[Idx::count + m_Cfg.M * (1 + m_Cfg.n) + nRows * m_nLo]);
 
 		m_Tau = m_vBuf.get() + Idx::count;
 		m_a = m_Tau + m_Cfg.M;
@@ -110,11 +110,16 @@ namespace Sigma {
 		ECC::Scalar::Native* m_a;
 		ECC::Scalar::Native* m_Tau;
 
-		// precalculated coeffs
+		// precalculated coeffs, for the lower digits only
 		ECC::Scalar::Native* m_p;
+		uint32_t m_nLoDigits;
+		uint32_t m_nLo; // n^m_nLoDigits, the stride of m_p
 
 		void InitNonces(const ECC::uintBig& seed);
 		void CalculateP();
+		void CalculateP_Part(uint32_t j, uint32_t nPwr, uint32_t t0, uint32_t t1);
+		void CalculateP_Hi(ECC::Scalar::Native* pQ, uint32_t iHi) const;
+		void get_P(ECC::Scalar::Native* pRes, uint32_t nStride, uint32_t i0, uint32_t nCount) const;
 		void ExtractABCD();
 		void ExtractG(const ECC::Point::Native& ptOut);
 		struct GB;
@@ -153,6 +158,10 @@ namespace Sigma {
 
 		const UserData* m_pUserData = nullptr;
 
+		// Max number of elements for which the polynomial coefficients are precalculated. The memory is proportional to it rather than to N.
+		// For the rest the coefficients are evaluated on-the-fly, the list is consumed in a single pass (per thread).
+		uint32_t m_nPrecalcMax = 0x1000;
+
 		enum struct Phase {
 			SinglePass, // regular
 			Step1, // export Part1
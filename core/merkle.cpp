@@ -466,6 +466,73 @@ void FixedMmr::SaveElement(const Hash& hv, const Position& pos)
 	m_vHashes[Pos2Idx(pos)] = hv;
 }
 
+void FixedMmr::Assign(const Hash* pElements, uint64_t nCount)
+{
+	struct MyBulk
+		:public BulkMmr
+	{
+		FixedMmr& m_This;
+		MyBulk(FixedMmr& x) :m_This(x) {}
+
+		virtual void OnNode(const Hash& hv, const Position& pos) override
+		{
+			m_This.SaveElement(hv, pos);
+		}
+	};
+
+	Resize(nCount);
+	m_Count = nCount;
+
+	Hash hv;
+	MyBulk(*this).Evaluate(hv, pElements, nCount);
+}
+
+/////////////////////////////
+// BulkMmr
+void BulkMmr::get_Hash(Hash& hv, const Hash* pElements, uint64_t nCount)
+{
+	BulkMmr().Evaluate(hv, pElements, nCount);
+}
+
+void BulkMmr::Evaluate(Hash& hvRoot, const Hash* pElements, uint64_t nCount)
+{
+	hvRoot = Zero;
+	if (!nCount)
+		return;
+
+	std::vector<Hash> v0, v1;
+	bool bEmpty = true;
+
+	Position pos;
+	for (pos.H = 0; ; pos.H++)
+	{
+		for (pos.X = 0; pos.X < nCount; pos.X++)
+			OnNode(pElements[pos.X], pos);
+
+		if (1 & nCount)
+		{
+			// the rightmost element at this height is a peak. Peaks are merged in the same order as in Mmr::get_HashForRange()
+			if (bEmpty)
+			{
+				hvRoot = pElements[nCount - 1];
+				bEmpty = false;
+			}
+			else
+				Interpret(hvRoot, pElements[nCount - 1], false);
+		}
+
+		nCount >>= 1;
+		if (!nCount)
+			break;
+
+		v1.resize(nCount);
+		ECC::Hash::Multi::CalculatePairs(&v1.front(), pElements, static_cast<uint32_t>(nCount));
+
+		v0.swap(v1);
+		pElements = &v0.front();
+	}
+}
+
 /////////////////////////////
 // FlyMmr
 struct FlyMmr::Inner
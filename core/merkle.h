@@ -178,6 +178,9 @@ namespace Merkle {
 		FixedMmr(uint64_t nTotal = 0) { Resize(nTotal); }
 		void Resize(uint64_t nTotal);
 
+		// Resizes and builds the whole Mmr at once (bulk). Faster than appending the elements one by one.
+		void Assign(const Hash* pElements, uint64_t nCount);
+
 		const std::vector<Hash>& get_Data() const { return m_vHashes; }
 
 	protected:
@@ -203,6 +206,18 @@ namespace Merkle {
 		virtual void LoadElement(Hash& hv, uint64_t n) const = 0;
 	};
 
+	// Evaluation of the whole Mmr when all the elements are known in advance. The tree is built bottom-up, so that all the nodes
+	// of the same height are hashed at once (multi-buffer hashing). The root is the same as for the Mmr with those elements appended.
+	class BulkMmr
+	{
+	public:
+		static void get_Hash(Hash&, const Hash* pElements, uint64_t nCount);
+		void Evaluate(Hash& hvRoot, const Hash* pElements, uint64_t nCount);
+
+	protected:
+		virtual void OnNode(const Hash&, const Position&) {}
+	};
+
 	// Structure to effective encode proofs to multiple elements at-once.
 	// The elements must be specified in a sorter order (straight or reverse).
 	// All the proofs are "merged", so that no hash is added twice.
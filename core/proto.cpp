@@ -272,6 +272,24 @@ bool Bbs::IsHashValid(const ECC::Hash::Value& hv)
 	return nHigh < (1 << 10); // upper 22 bits should be zero, probability ~ 1 / 4mln
 }
 
+uint64_t Reconcile::get_Diff(uint64_t a, uint64_t b, uint16_t q)
+{
+	uint64_t nMin = std::min(a, b);
+	return std::max(a, b) - nMin + ((nMin * std::min(q, s_DiffRatioMax)) / s_DiffRatioOne) + 1;
+}
+
+uint16_t Reconcile::get_DiffRatio(uint64_t a, uint64_t b, uint64_t nDiff)
+{
+	uint64_t nMin = std::min(a, b);
+	if (!nMin)
+		return s_DiffRatioDef;
+
+	uint64_t nDelta = std::max(a, b) - nMin;
+	uint64_t q = (nDiff > nDelta) ? ((nDiff - nDelta) * s_DiffRatioOne / nMin) : 0;
+
+	return static_cast<uint16_t>(std::min<uint64_t>(q, s_DiffRatioMax));
+}
+
 union HighestMsgCode
 {
 #define THE_MACRO(code, msg) uint8_t m_pBuf_##msg[code + 1];
@@ -23,6 +23,7 @@
 #include "../utility/io/timer.h"
 #include "aes.h"
 #include "block_crypt.h"
+#include "iblt.h"
 
 namespace beam {
 namespace proto {
@@ -213,6 +214,20 @@ namespace proto {
 #define BeamNodeMsg_BbsResetSync(macro) \
     macro(Timestamp, TimeFrom)
 
+#define BeamNodeMsg_ReconcileRequest(macro) \
+    macro(uint8_t, Type) \
+    macro(uint32_t, SetSize) \
+    macro(uint16_t, DiffRatio) /* see Reconcile::s_DiffRatioOne */ \
+    macro(uint64_t, Salt)
+
+#define BeamNodeMsg_ReconcileSketch(macro) \
+    macro(uint8_t, Type) \
+    macro(std::vector<Iblt::Cell>, Cells) /* empty - sketch is not beneficial, fall back to flooding */
+
+#define BeamNodeMsg_ReconcileDone(macro) \
+    macro(uint8_t, Type) \
+    macro(bool, Decoded)
+
 #define BeamNodeMsg_SChannelInitiate(macro) \
     macro(PeerID, NoncePub)
 
@@ -233,6 +248,11 @@ namespace proto {
     macro(ECC::Hash::Value, Value) \
     macro(Height, Height) \
 
+#define BeamNodeMsg_EventsPush(macro) \
+    macro(Height, HeightMin) \
+    macro(Height, HeightMax) \
+    macro(ByteBuffer, Events)
+
 #define BeamNodeMsg_GetBlockFinalization(macro) \
     macro(Height, Height) \
     macro(Amount, Fees)
@@ -358,6 +378,7 @@ namespace proto {
     macro(0x2c, GetEvents) \
     macro(0x34, Events) \
     macro(0x37, EventsSerif) \
+    macro(0x51, EventsPush) \
     macro(0x2e, GetBlockFinalization) \
     macro(0x2f, BlockFinalization) \
     /* tx broadcast and replication */ \
@@ -374,6 +395,10 @@ namespace proto {
     macro(0x3b, BbsSubscribe) \
     macro(0x3e, BbsResetSync) \
     macro(0x3f, BbsMsg) \
+    /* announcements reconciliation */ \
+    macro(0x4e, ReconcileRequest) \
+    macro(0x4f, ReconcileSketch) \
+    macro(0x50, ReconcileDone) \
     /* stats */ \
     macro(0x45, GetStateSummary) \
     macro(0x46, StateSummary) \
@@ -416,7 +441,11 @@ namespace proto {
         };
 
         static const uint32_t WantDependentState     = 0x10000; // Please send me dependent state updates
+        static const uint32_t Reconciliation         = 0x20000; // I can announce txs and bbs msgs via periodic set reconciliation
+        static const uint32_t WantEventsPush         = 0x40000; // Please push my new events upon new tip, once I'm in sync with them
         static_assert(!(WantDependentState  & Extension::Msk));
+        static_assert(!(Reconciliation  & Extension::Msk));
+        static_assert(!(WantEventsPush  & Extension::Msk));
 	};
 
     struct IDType
@@ -609,6 +638,27 @@ namespace proto {
 		bool Decrypt(uint8_t*& p, uint32_t& n, const ECC::Scalar::Native& privateAddr);
 	};
 
+	struct Reconcile
+	{
+		// Instead of announcing each tx/bbs msg to each peer, the announcements are accumulated per peer, and periodically reconciled.
+		// The connecting side initiates: it sends its set size, the responder replies with the sketch (Iblt) of its set,
+		// the initiator decodes the difference, announces what the responder lacks, and requests what it lacks itself.
+		// Items known to both sides cancel out, hence the traffic is proportional to the difference rather than to the num of peers.
+		static const uint8_t Tx = 0;
+		static const uint8_t Bbs = 1;
+		static const uint8_t s_Types = 2;
+
+		static const uint32_t s_MaxCells = 1024 * 8;
+
+		// The responder estimates the difference as |a-b| + q*min(a,b) + 1. The initiator evaluates q from the previous rounds (in s_DiffRatioOne units).
+		static const uint16_t s_DiffRatioOne = 0x100;
+		static const uint16_t s_DiffRatioDef = s_DiffRatioOne / 4;
+		static const uint16_t s_DiffRatioMax = s_DiffRatioOne * 2; // the difference can't exceed a+b
+
+		static uint64_t get_Diff(uint64_t a, uint64_t b, uint16_t q);
+		static uint16_t get_DiffRatio(uint64_t a, uint64_t b, uint64_t nDiff);
+	};
+
 	struct TxStatus
 	{
 		// for backward compatibility, since it's former Boolean
@@ -285,6 +285,45 @@ void TestHash()
 	}
 }
 
+void TestHashMulti()
+{
+	// all the message lengths around the block boundaries, in different lanes
+	std::vector<uint8_t> vData(0x200);
+	GenRandom(&vData.front(), static_cast<uint32_t>(vData.size()));
+
+	std::vector<beam::Blob> vMsg;
+	for (uint32_t n = 0; n <= 0x150; n++)
+		vMsg.emplace_back(&vData.front() + (n % 0x20), n);
+
+	std::vector<Hash::Value> vRes(vMsg.size());
+
+	for (uint32_t nCount = 1; nCount <= vMsg.size(); nCount += 37)
+	{
+		Hash::Multi::Calculate(&vRes.front(), &vMsg.front(), nCount);
+
+		for (uint32_t i = 0; i < nCount; i++)
+		{
+			Hash::Value hv;
+			Hash::Processor() << vMsg[i] >> hv;
+			verify_test(hv == vRes[i]);
+		}
+	}
+
+	// Merkle nodes
+	std::vector<Hash::Value> vSrc(0x42);
+	for (size_t i = 0; i < vSrc.size(); i++)
+		SetRandom(vSrc[i]);
+
+	Hash::Multi::CalculatePairs(&vRes.front(), &vSrc.front(), static_cast<uint32_t>(vSrc.size() / 2));
+
+	for (uint32_t i = 0; i < vSrc.size() / 2; i++)
+	{
+		Hash::Value hv;
+		beam::Merkle::Interpret(hv, vSrc[i * 2], vSrc[i * 2 + 1]);
+		verify_test(hv == vRes[i]);
+	}
+}
+
 void TestScalars()
 {
 	Scalar::Native s0, s1, s2;
@@ -572,6 +611,180 @@ void TestPoints()
 	verify_test(p0 == Zero);
 }
 
+void TestMultiMac()
+{
+	Mode::Scope scope(Mode::Fast);
+
+	const uint32_t nPippengerMin = MultiMac::s_PippengerMin;
+
+	struct Case {
+		uint32_t m_Casual;
+		uint32_t m_Prepared;
+		uint32_t m_Threads;
+	};
+
+	const Case pCases[] = {
+		{ 1, 0, 0 },
+		{ 0, 3, 0 },
+		{ 10, 10, 0 },
+		{ 300, InnerProduct::nDim * 2, 0 },
+		{ 1500, 7, 0 },
+		{ 2500, 20, 4 }, // parallel
+	};
+
+	for (size_t iCase = 0; iCase < _countof(pCases); iCase++)
+	{
+		const Case& c = pCases[iCase];
+
+		std::vector<Point::Native> vPts(c.m_Casual);
+		std::vector<Scalar::Native> vKs(c.m_Casual + c.m_Prepared);
+
+		for (uint32_t i = 0; i < c.m_Casual; i++)
+		{
+			if (i % 17)
+				SetRandom(vPts[i]);
+			else
+				vPts[i] = Zero;
+		}
+
+		for (size_t i = 0; i < vKs.size(); i++)
+		{
+			switch (i % 13)
+			{
+			case 0:
+				vKs[i] = Zero;
+				break;
+			case 1:
+				vKs[i] = 1U;
+				vKs[i] = -vKs[i]; // all bits set, max carry
+				break;
+			case 2:
+				vKs[i] = static_cast<uint32_t>(i);
+				break;
+			default:
+				SetRandom(vKs[i]);
+			}
+		}
+
+		MultiMac_Dyn mm;
+		mm.Prepare(c.m_Casual, c.m_Prepared);
+
+		Point::Native pRes[2];
+
+		for (uint32_t iMode = 0; iMode < 2; iMode++)
+		{
+			// wNAF, then buckets
+			MultiMac::s_PippengerMin = iMode ? 0 : static_cast<uint32_t>(-1);
+
+			mm.Reset();
+			for (uint32_t i = 0; i < c.m_Casual; i++)
+			{
+				mm.m_pCasual[mm.m_Casual].Init(vPts[i]);
+				mm.m_pKCasual[mm.m_Casual++] = vKs[i];
+			}
+
+			for (uint32_t i = 0; i < c.m_Prepared; i++)
+			{
+				mm.m_ppPrepared[mm.m_Prepared] = &Context::get().m_Ipp.m_pGen_[i & 1][(i >> 1) % InnerProduct::nDim];
+				mm.m_pKPrep[mm.m_Prepared++] = vKs[c.m_Casual + i];
+			}
+
+			if (c.m_Threads)
+			{
+				beam::ExecutorMT_R ex;
+				ex.set_Threads(c.m_Threads);
+				beam::Executor::Scope scopeEx(ex);
+
+				mm.Calculate(pRes[iMode]);
+			}
+			else
+				mm.Calculate(pRes[iMode]);
+		}
+
+		verify_test(pRes[0] == pRes[1]);
+	}
+
+	{
+		// Sigma CmList, the bucket method is fed with the points in the storage form
+		beam::Lelantus::CmListVec lst;
+		lst.m_vec.resize(700);
+
+		std::vector<Scalar::Native> vKs(lst.m_vec.size() + 5);
+		for (size_t i = 0; i < lst.m_vec.size(); i++)
+		{
+			if (i % 17)
+			{
+				Point::Native pt;
+				SetRandom(pt);
+				pt.Export(lst.m_vec[i]);
+			}
+			else
+				ZeroObject(lst.m_vec[i]);
+		}
+
+		for (size_t i = 0; i < vKs.size(); i++)
+			SetRandom(vKs[i]);
+
+		Point::Native pRes[2];
+
+		for (uint32_t iMode = 0; iMode < 2; iMode++)
+		{
+			MultiMac::s_PippengerMin = iMode ? 0 : static_cast<uint32_t>(-1);
+
+			// some terms are beyond the list
+			pRes[iMode] = Zero;
+			lst.Calculate(pRes[iMode], 3, static_cast<uint32_t>(vKs.size() - 3), &vKs.front());
+		}
+
+		verify_test(pRes[0] == pRes[1]);
+		verify_test(!(pRes[0] == Zero));
+	}
+
+	MultiMac::s_PippengerMin = nPippengerMin;
+}
+
+void TestPointsBatch()
+{
+	const uint32_t pCounts[] = { 1, 5, 0x100, 0x101, 0x1234 };
+
+	for (size_t iCase = 0; iCase < _countof(pCounts); iCase++)
+	{
+		const uint32_t nCount = pCounts[iCase];
+
+		std::vector<Point::Native> vPts(nCount);
+		for (uint32_t i = 0; i < nCount; i++)
+		{
+			if (i % 11)
+				SetRandom(vPts[i]);
+			else
+				vPts[i] = Zero;
+		}
+
+		std::vector<Point> vP(nCount);
+
+		for (uint32_t iMode = 0; iMode < 2; iMode++)
+		{
+			if (iMode)
+			{
+				beam::ExecutorMT_R ex;
+				ex.set_Threads(4);
+				beam::Executor::Scope scopeEx(ex);
+
+				Point::Native::ExportBatch(&vP.front(), &vPts.front(), nCount);
+			}
+			else
+				Point::Native::ExportBatch(&vP.front(), &vPts.front(), nCount);
+
+			for (uint32_t i = 0; i < nCount; i++)
+			{
+				Point pt;
+				vPts[i].Export(pt);
+				verify_test(pt == vP[i]);
+			}
+		}
+	}
+}
+
 void TestSigning()
 {
 	for (int i = 0; i < 30; i++)
@@ -1415,6 +1628,56 @@ void TestTransaction()
 	ctx.m_Height.m_Min = g_hFork;
 	verify_test(tm.m_Trans.IsValid(ctx));
 	verify_test(ctx.m_Stats.m_Fee == beam::AmountBig::Type(fee1 + fee2));
+
+	// verified elements cache
+	struct MyCache
+		:public beam::TxBase::Context::IVerifiedCache
+	{
+		std::map<Key, ECC::Point> m_Map;
+		uint32_t m_Hits = 0;
+
+		bool Find(const Key& key, ECC::Point* pSigma) override
+		{
+			auto it = m_Map.find(key);
+			if (m_Map.end() == it)
+				return false;
+
+			if (pSigma)
+				*pSigma = it->second;
+			m_Hits++;
+			return true;
+		}
+
+		void Insert(const Key& key, const ECC::Point::Native* pSigma) override
+		{
+			ECC::Point& pt = m_Map[key];
+			if (pSigma)
+				pSigma->Export(pt);
+			else
+				pt = Zero;
+		}
+	} vc;
+
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		ctx.Reset();
+		ctx.m_Height.m_Min = g_hFork;
+		ctx.m_Params.m_pCache = &vc;
+		verify_test(tm.m_Trans.IsValid(ctx));
+		verify_test(ctx.m_Stats.m_Fee == beam::AmountBig::Type(fee1 + fee2));
+	}
+
+	verify_test(vc.m_Hits == vc.m_Map.size()); // 2nd pass is served from the cache
+	verify_test(vc.m_Hits == tm.m_Trans.m_vOutputs.size() + tm.m_Trans.m_vKernels.size());
+
+	// tampered signature must not hit the cache
+	beam::TxKernelStd& krn = Cast::Up<beam::TxKernelStd>(*tm.m_Trans.m_vKernels.front());
+	krn.m_Signature.m_k.m_Value.Inc();
+
+	ctx.Reset();
+	ctx.m_Height.m_Min = g_hFork;
+	ctx.m_Params.m_pCache = &vc;
+	verify_test(!tm.m_Trans.IsValid(ctx));
 }
 
 void TestCutThrough()
@@ -1956,10 +2219,21 @@ void TestLelantus(bool bWithAsset, bool bMpc)
 
 	PseudoRandomGenerator prg = *PseudoRandomGenerator::s_pOverride; // save prnd state
 
-	for (uint32_t iCycle = 0; iCycle < 3; iCycle++)
+	const uint32_t nPrecalcDef = p.m_Sigma.m_nPrecalcMax;
+
+	for (uint32_t iCycle = 0; iCycle < 6; iCycle++)
 	{
 		beam::ExecutorMT_R ex;
-		ex.set_Threads(1 << iCycle);
+		ex.set_Threads(1 << std::min(iCycle, 2U));
+
+		// then compare the full coefficients table, and streaming with fewer precalculated digits
+		switch (iCycle)
+		{
+		case 3: p.m_Sigma.m_nPrecalcMax = beam::Lelantus::Cfg::Max::N; break;
+		case 4: p.m_Sigma.m_nPrecalcMax = cfg.n; break;
+		case 5: p.m_Sigma.m_nPrecalcMax = 1; break;
+		default: p.m_Sigma.m_nPrecalcMax = nPrecalcDef;
+		}
 
 		beam::Executor::Scope scope(ex);
 
@@ -2013,7 +2287,7 @@ void TestLelantus(bool bWithAsset, bool bMpc)
 			p.Generate(seed, oracle, &hGen);
 
 		if (!bSpecial)
-			printf("\tProof time = %u ms, Threads=%u\n", beam::GetTime_ms() - t, ex.get_Threads());
+			printf("\tProof time = %u ms, Threads=%u, Precalc=%u\n", beam::GetTime_ms() - t, ex.get_Threads(), std::min(p.m_Sigma.m_nPrecalcMax, N));
 
 		// serialization
 		beam::Serializer ser_;
@@ -2021,7 +2295,7 @@ void TestLelantus(bool bWithAsset, bool bMpc)
 
 		if (iCycle)
 		{
-			// verify the result is the same (doesn't depend on thread num)
+			// verify the result is the same (doesn't depend on thread num and precalc)
 			beam::SerializeBuffer sb = ser_.buffer();
 			verify_test((sb.second == bufProof.size()) && !memcmp(sb.first, &bufProof.front(), sb.second));
 		}
@@ -2291,8 +2565,11 @@ void TestAll()
 	TestByteOrder();
 	TestUintBig();
 	TestHash();
+	TestHashMulti();
 	TestScalars();
 	TestPoints();
+	TestMultiMac();
+	TestPointsBatch();
 	TestSigning();
 	TestCommitments();
 	TestRangeProof(false);
@@ -2749,6 +3026,95 @@ void RunBenchmark()
 		} while (bm.ShouldContinue());
 	}
 
+	{
+		Mode::Scope scope(Mode::Fast);
+
+		const uint32_t nMaxTerms = 0x10000;
+		std::vector<Point::Native> vPts(nMaxTerms);
+		std::vector<Scalar::Native> vKs(nMaxTerms);
+
+		for (uint32_t i = 0; i < nMaxTerms; i++)
+		{
+			SetRandom(vPts[i]);
+			SetRandom(vKs[i]);
+		}
+
+		MultiMac_Dyn mm;
+		mm.Prepare(nMaxTerms, 0);
+
+		beam::ExecutorMT_R ex;
+		const uint32_t nPippengerMin = MultiMac::s_PippengerMin;
+
+		for (uint32_t nTerms = 0x400; nTerms <= nMaxTerms; nTerms <<= 2)
+		{
+			for (uint32_t iMode = 0; iMode < 3; iMode++)
+			{
+				// wNAF, buckets, buckets in parallel
+				if (!iMode && (nTerms > 0x4000))
+					continue; // too slow
+
+				MultiMac::s_PippengerMin = iMode ? nPippengerMin : static_cast<uint32_t>(-1);
+
+				std::unique_ptr<beam::Executor::Scope> pScope;
+				if (2 == iMode)
+					pScope = std::make_unique<beam::Executor::Scope>(ex);
+
+				char sz[0x40];
+				snprintf(sz, sizeof(sz), "MultiMac.%s.%uK", iMode ? ((2 == iMode) ? "Buckets.MT" : "Buckets") : "wNAF", nTerms >> 10);
+
+				BenchmarkMeter bm(sz);
+				bm.N = 1;
+				do
+				{
+					for (uint32_t i = 0; i < bm.N; i++)
+					{
+						mm.Reset();
+						for (; static_cast<uint32_t>(mm.m_Casual) < nTerms; mm.m_Casual++)
+						{
+							mm.m_pCasual[mm.m_Casual].Init(vPts[mm.m_Casual]);
+							mm.m_pKCasual[mm.m_Casual] = vKs[mm.m_Casual];
+						}
+
+						mm.Calculate(p0);
+					}
+
+				} while (bm.ShouldContinue());
+			}
+		}
+
+		MultiMac::s_PippengerMin = nPippengerMin;
+	}
+
+	{
+		// Merkle level of 1K nodes
+		std::vector<Hash::Value> vSrc(0x800), vRes(0x400);
+		for (size_t i = 0; i < vSrc.size(); i++)
+			SetRandom(vSrc[i]);
+
+		{
+			BenchmarkMeter bm("Hash.Merkle-1K");
+			bm.N = 10;
+			do
+			{
+				for (uint32_t i = 0; i < bm.N; i++)
+					for (uint32_t j = 0; j < vRes.size(); j++)
+						beam::Merkle::Interpret(vRes[j], vSrc[j * 2], vSrc[j * 2 + 1]);
+
+			} while (bm.ShouldContinue());
+		}
+
+		{
+			BenchmarkMeter bm("Hash.Multi.Merkle-1K");
+			bm.N = 10;
+			do
+			{
+				for (uint32_t i = 0; i < bm.N; i++)
+					Hash::Multi::CalculatePairs(&vRes.front(), &vSrc.front(), static_cast<uint32_t>(vRes.size()));
+
+			} while (bm.ShouldContinue());
+		}
+	}
+
 	{
 		AES::Encoder enc;
 		enc.Init(hv.m_pData);
@@ -15,6 +15,7 @@
 #include <iostream>
 #include "../radixtree.h"
 #include "../navigator.h"
+#include "../iblt.h"
 #include "../../utility/serialize.h"
 
 #ifndef WIN32
@@ -548,6 +549,13 @@ namespace beam
 			verify_test(hvRoot == hvRoot3);
 			flymmr.get_Hash(hvRoot);
 			verify_test(hvRoot == hvRoot3);
+			Merkle::BulkMmr::get_Hash(hvRoot, &vHashes.front(), i + 1);
+			verify_test(hvRoot == hvRoot3);
+
+			Merkle::FixedMmr fmmr2;
+			fmmr2.Assign(&vHashes.front(), i + 1);
+			fmmr2.get_Hash(hvRoot);
+			verify_test(hvRoot == hvRoot3);
 
 			vSet.clear();
 
@@ -564,6 +572,10 @@ namespace beam
 				fmmr.get_Proof(bld, j);
 				verify_test(proof == bld.m_Proof);
 
+				bld.m_Proof.clear();
+				fmmr2.get_Proof(bld, j);
+				verify_test(proof == bld.m_Proof);
+
 				if (i < 40) // flymmr is too heavy (everything is literally recalculated every time).
 				{
 					bld.m_Proof.clear();
@@ -669,6 +681,86 @@ namespace beam
 
 	}
 
+	void SetRandomIbltKey(Iblt::Key& key)
+	{
+		for (uint32_t i = 0; i < key.nBytes; i++)
+			key.m_pData[i] = (uint8_t) rand();
+	}
+
+	void TestIblt()
+	{
+		uint32_t nFailed = 0;
+
+		for (uint32_t iCycle = 0; iCycle < 300; iCycle++)
+		{
+			uint32_t nCommon = rand() % 500;
+			uint32_t nA = rand() % 40;
+			uint32_t nB = rand() % 40;
+
+			uint64_t salt = rand();
+
+			Iblt a, b;
+			a.Reset(Iblt::get_CellsFor(nA + nB), salt);
+			b.Reset(Iblt::get_CellsFor(nA + nB), salt);
+
+			Iblt::Key key;
+			for (uint32_t i = 0; i < nCommon; i++)
+			{
+				SetRandomIbltKey(key);
+				a.Add(key);
+				b.Add(key);
+			}
+
+			std::set<Iblt::Key> sA, sB;
+			for (uint32_t i = 0; i < nA; i++)
+			{
+				SetRandomIbltKey(key);
+				a.Add(key);
+				sA.insert(key);
+			}
+
+			for (uint32_t i = 0; i < nB; i++)
+			{
+				SetRandomIbltKey(key);
+				b.Add(key);
+				sB.insert(key);
+			}
+
+			verify_test(a.Subtract(b.m_vCells));
+
+			std::vector<Iblt::Key> vPos, vNeg;
+			if (!a.Decode(vPos, vNeg))
+			{
+				nFailed++;
+				continue;
+			}
+
+			verify_test(vPos.size() == sA.size());
+			verify_test(vNeg.size() == sB.size());
+
+			for (const auto& x : vPos)
+				verify_test(sA.count(x));
+			for (const auto& x : vNeg)
+				verify_test(sB.count(x));
+		}
+
+		verify_test(nFailed < 5); // rare decode failures are acceptable
+
+		// the difference is too large for the table
+		Iblt x;
+		x.Reset(Iblt::get_CellsFor(4), 0);
+
+		Iblt::Key key;
+		for (uint32_t i = 0; i < 200; i++)
+		{
+			SetRandomIbltKey(key);
+			x.Add(key);
+		}
+
+		std::vector<Iblt::Key> vPos, vNeg;
+		verify_test(!x.Decode(vPos, vNeg));
+	}
+
 } // namespace beam
 
 int main()
@@ -676,6 +768,7 @@ int main()
 	beam::TestNavigator();
 	beam::TestUtxoTree();
 	beam::TestMmr();
+	beam::TestIblt();
 
 	return g_TestsFailed ? -1 : 0;
 }
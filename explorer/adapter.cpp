@@ -41,6 +41,7 @@ namespace beam { namespace explorer {
 namespace {
 
 static const size_t PACKER_FRAGMENTS_SIZE = 4096;
+static const size_t BLOCK_CACHE_MAX_SIZE = 1024 * 1024 * 64;
 
 const unsigned int FAKE_SEED = 10283UL;
 const char WALLET_DB_PATH[] = "explorer-wallet.db";
@@ -525,12 +526,189 @@ private:
             _nextHook->OnStateChanged();
 
         EnsureHaveCumulativeStats();
+
+        _stateVersion++;
+        _blockCache.OnNewBlocks(_nodeBackend);
     }
 
     void OnRolledBack(const Block::SystemState::ID& id) override {
         if (_nextHook) _nextHook->OnRolledBack(id);
+
+        _stateVersion++;
+        _blockCache.OnRolledBack(id.m_Height);
+    }
+
+    uint64_t get_StateVersion() override
+    {
+        return _stateVersion;
     }
 
+    // Rendered blocks, stored compactly (MessagePack), per height and mode. Only the blocks that can't be rolled back are cached.
+    // Yet a block is changed when its outputs are spent, hence each new block evicts the blocks it spends from,
+    // and remembers them in case it's rolled back.
+    struct BlockCache
+    {
+        typedef std::pair<Height, int> Key;
+
+        struct Entry
+        {
+            ByteBuffer m_Data;
+            std::list<Key>::iterator m_itLru;
+        };
+
+        typedef std::map<Key, Entry> Map;
+        Map m_Map;
+        std::list<Key> m_lstLru; // the most recently used first
+        size_t m_Size = 0;
+
+        std::map<Height, std::vector<Height> > m_mapSpent; // recent block -> the heights its inputs were created at
+        Height m_hTip = 0; // processed
+        Height m_hSpent0 = MaxHeight; // the spent heights are known for the blocks above this
+
+        static bool IsFinal(Height h, Height hTip)
+        {
+            return h + Rules::get().MaxRollback <= hTip;
+        }
+
+        void Delete(Map::iterator it)
+        {
+            m_Size -= it->second.m_Data.size();
+            m_lstLru.erase(it->second.m_itLru);
+            m_Map.erase(it);
+        }
+
+        void DeleteFrom(Height h0, Height h1)
+        {
+            for (auto it = m_Map.lower_bound(Key(h0, 0)); (m_Map.end() != it) && (it->first.first <= h1); )
+                Delete(it++);
+        }
+
+        void Clear()
+        {
+            m_Map.clear();
+            m_lstLru.clear();
+            m_Size = 0;
+            m_mapSpent.clear();
+        }
+
+        const ByteBuffer* Find(const Key& key)
+        {
+            auto it = m_Map.find(key);
+            if (m_Map.end() == it)
+                return nullptr;
+
+            m_lstLru.splice(m_lstLru.begin(), m_lstLru, it->second.m_itLru);
+            return &it->second.m_Data;
+        }
+
+        void Insert(const Key& key, ByteBuffer&& buf)
+        {
+            if (buf.size() > BLOCK_CACHE_MAX_SIZE / 16)
+                return; // too large, not worth it
+
+            while (!m_lstLru.empty() && (m_Size + buf.size() > BLOCK_CACHE_MAX_SIZE))
+                Delete(m_Map.find(m_lstLru.back()));
+
+            auto it = m_Map.find(key);
+            if (m_Map.end() != it)
+                Delete(it);
+
+            m_lstLru.push_front(key);
+
+            Entry& e = m_Map[key];
+            e.m_Data = std::move(buf);
+            e.m_itLru = m_lstLru.begin();
+            m_Size += e.m_Data.size();
+        }
+
+        void OnNewBlocks(NodeProcessor& proc)
+        {
+            Height hTip = proc.m_Cursor.m_Full.m_Height;
+            if (hTip <= m_hTip)
+                return; // rollbacks are handled separately
+
+            const Height hMaxRollback = Rules::get().MaxRollback;
+            if (hTip - m_hTip > hMaxRollback)
+            {
+                // initial sync, or the cache is too outdated
+                Clear();
+                m_hTip = hTip;
+                m_hSpent0 = hTip;
+                return;
+            }
+
+            NodeDB& db = proc.get_DB();
+            std::vector<NodeDB::StateInput> vIns;
+
+            for (Height h = m_hTip + 1; h <= hTip; h++)
+            {
+                vIns.clear();
+                db.get_StateInputs(db.FindActiveStateStrict(h), vIns);
+
+                auto& vSpent = m_mapSpent[h];
+                vSpent.reserve(vIns.size());
+
+                for (const auto& inp : vIns)
+                {
+                    TxoID id = inp.get_ID();
+                    if (id < proc.m_Extra.m_TxosTreasury)
+                        vSpent.push_back(0);
+                    else
+                    {
+                        NodeDB::StateID sid;
+                        db.FindStateByTxoID(sid, id);
+                        vSpent.push_back(sid.m_Height);
+                    }
+                }
+
+                std::sort(vSpent.begin(), vSpent.end());
+                vSpent.erase(std::unique(vSpent.begin(), vSpent.end()), vSpent.end());
+
+                for (Height hCreate : vSpent)
+                    DeleteFrom(hCreate, hCreate);
+            }
+
+            m_hTip = hTip;
+
+            // older blocks can't be rolled back
+            while (!m_mapSpent.empty() && IsFinal(m_mapSpent.begin()->first, hTip))
+            {
+                m_hSpent0 = m_mapSpent.begin()->first;
+                m_mapSpent.erase(m_mapSpent.begin());
+            }
+        }
+
+        void OnRolledBack(Height h)
+        {
+            if (h < m_hSpent0)
+            {
+                // not supposed to happen, unless the node has just started
+                Clear();
+                m_hSpent0 = h;
+            }
+            else
+            {
+                // the outputs spent by the reverted blocks are unspent now
+                for (auto it = m_mapSpent.upper_bound(h); m_mapSpent.end() != it; )
+                {
+                    for (Height hCreate : it->second)
+                        DeleteFrom(hCreate, hCreate);
+                    m_mapSpent.erase(it++);
+                }
+            }
+
+            if (h >= Rules::get().MaxRollback)
+                DeleteFrom(h - Rules::get().MaxRollback + 1, MaxHeight);
+            else
+                DeleteFrom(0, MaxHeight);
+
+            m_hTip = h;
+        }
+
+    } _blockCache;
+
+    uint64_t _stateVersion = 0;
+
     struct TresEntry
         :public intrusive::set_base_hook<Height>
     {
@@ -2624,7 +2802,27 @@ private:
                 *prevRow = 0;
             }
         }
-        return ok && extract_block_from_row(out, row, height);
+        return ok && extract_block_cached(out, row, height);
+    }
+
+    bool extract_block_cached(json& out, uint64_t row, Height height) {
+        if (!BlockCache::IsFinal(height, _nodeBackend.m_Cursor.m_Full.m_Height))
+            return extract_block_from_row(out, row, height);
+
+        BlockCache::Key key(height, static_cast<int>(m_Mode));
+
+        const ByteBuffer* pBuf = _blockCache.Find(key);
+        if (pBuf)
+        {
+            out = json::from_msgpack(*pBuf);
+            return true;
+        }
+
+        if (!extract_block_from_row(out, row, height))
+            return false;
+
+        _blockCache.Insert(key, json::to_msgpack(out));
+        return true;
     }
 
     json get_block_impl(uint64_t height, uint64_t& row, uint64_t* prevRow) {
@@ -65,6 +65,9 @@ struct IAdapter {
 
     virtual void Initialize() = 0; // call after node init
 
+    /// Changes on every node state change (new tip or rollback). The responses that depend only on the node state remain valid until then
+    virtual uint64_t get_StateVersion() = 0;
+
     /// Returns body for /status request
     virtual json get_status() = 0;
     virtual json get_block(uint64_t height) = 0;
@@ -31,6 +31,7 @@ static const uint64_t SERVER_RESTART_TIMER = 1;
 static const uint64_t ACL_REFRESH_TIMER = 2;
 static const unsigned SERVER_RESTART_INTERVAL = 1000;
 static const unsigned ACL_REFRESH_INTERVAL = 5555;
+static const size_t RESPONSE_CACHE_MAX_SIZE = 1024 * 1024 * 32;
 
 } //namespace
 
@@ -607,6 +608,19 @@ void jsonExp(json& obj, uint32_t nDepth)
 }
 
 
+std::string make_etag(const io::SerializedMsg& body)
+{
+    ECC::Hash::Processor hp;
+    for (const auto& f : body)
+        hp << Blob(f.data, static_cast<uint32_t>(f.size));
+
+    ECC::Hash::Value hv;
+    hp >> hv;
+
+    // 128 bits are enough
+    return '"' + to_hex(hv.m_pData, hv.nBytes / 2) + '"';
+}
+
 bool Server::on_request(uint64_t id, const HttpMsgReader::Message& msg)
 {
     auto it = _connections.find(id);
@@ -637,6 +651,7 @@ bool Server::on_request(uint64_t id, const HttpMsgReader::Message& msg)
     const HttpConnection::Ptr& conn = it->second;
 
     json (Server::*pFn)(const HttpConnection::Ptr&) = 0;
+    bool isCacheable = false;
 
     if (_currentUrl.parse(path, m_Dirs))
     {
@@ -649,6 +664,22 @@ bool Server::on_request(uint64_t id, const HttpMsgReader::Message& msg)
         default: // suppress warning
             break;
         }
+
+        switch ((DirType) _currentUrl.dir)
+        {
+        case DirType::block:
+        case DirType::blocks:
+        case DirType::hdrs:
+        case DirType::contracts:
+        case DirType::contract:
+        case DirType::asset:
+        case DirType::assets:
+            isCacheable = true; // depend only on the node state
+            break;
+
+        default: // status includes the peers count, the rest are unrelated to the node state
+            break;
+        }
     }
 
     bool keepalive = false;
@@ -675,29 +706,79 @@ bool Server::on_request(uint64_t id, const HttpMsgReader::Message& msg)
         {
             try
             {
-                json j = (this->*pFn)(conn);
+                uint64_t stateVersion = _backend.get_StateVersion();
+                if (_cache.stateVersion != stateVersion)
+                {
+                    _cache.items.clear();
+                    _cache.size = 0;
+                    _cache.stateVersion = stateVersion;
+                }
 
-                io::SerializedMsg sm;
+                const CachedResponse* pCached = nullptr;
+                if (isCacheable)
+                {
+                    auto itCache = _cache.items.find(path);
+                    if (_cache.items.end() != itCache)
+                        pCached = &itCache->second;
+                }
 
-                switch (_backend.m_Mode)
+                if (!pCached)
                 {
-                case IAdapter::Mode::AutoHtml:
+                    json j = (this->*pFn)(conn);
+
+                    switch (_backend.m_Mode)
                     {
-                        HtmlConverter cvt(path);
-                        cvt.Convert(j);
-                        cvt.get_Res(_body);
+                    case IAdapter::Mode::AutoHtml:
+                        {
+                            HtmlConverter cvt(path);
+                            cvt.Convert(j);
+                            cvt.get_Res(_body);
+                        }
+                        break;
+
+                    case IAdapter::Mode::ExplicitType:
+                        jsonExp(j, 0);
+                        // no break;
+
+                    default:
+                        json2Msg(j, _body);
                     }
-                    break;
 
-                case IAdapter::Mode::ExplicitType:
-                    jsonExp(j, 0);
-                    // no break;
-
-                default:
-                    json2Msg(j, _body);
+                    if (isCacheable)
+                    {
+                        size_t bodySize = 0;
+                        for (const auto& f : _body) { bodySize += f.size; }
+
+                        if (_cache.size + bodySize > RESPONSE_CACHE_MAX_SIZE)
+                        {
+                            _cache.items.clear();
+                            _cache.size = 0;
+                        }
+
+                        CachedResponse& x = _cache.items[path];
+                        x.body = _body; // the fragments are shared
+                        x.etag = make_etag(_body);
+                        x.isHtml = (IAdapter::Mode::AutoHtml == _backend.m_Mode);
+                        _cache.size += bodySize;
+
+                        pCached = &x;
+                    }
                 }
+                else
+                    _body = pCached->body;
 
-                keepalive = send(conn, 200, "OK", IAdapter::Mode::AutoHtml == _backend.m_Mode);
+                if (pCached)
+                {
+                    if (msg.msg->get_header("If-None-Match") == pCached->etag)
+                    {
+                        _body.clear();
+                        keepalive = send(conn, 304, "Not Modified", pCached->isHtml, pCached->etag.c_str());
+                    }
+                    else
+                        keepalive = send(conn, 200, "OK", pCached->isHtml, pCached->etag.c_str());
+                }
+                else
+                    keepalive = send(conn, 200, "OK", IAdapter::Mode::AutoHtml == _backend.m_Mode);
             }
             catch (const std::exception& e)
             {
@@ -892,26 +973,33 @@ OnRequest(assets)
     return _backend.get_assets_at(height);
 }
 
-bool Server::send(const HttpConnection::Ptr& conn, int code, const char* message, bool isHtml)
+bool Server::send(const HttpConnection::Ptr& conn, int code, const char* message, bool isHtml, const char* etag)
 {
     assert(conn);
 
     size_t bodySize = 0;
     for (const auto& f : _body) { bodySize += f.size; }
 
-    HeaderPair pHp[2];
+    HeaderPair pHp[3];
     ZeroObject(pHp);
     pHp[0].head = "Access-Control-Allow-Origin";
     pHp[0].content_str = "*";
     pHp[1].head = "Access-Control-Allow-Headers";
     pHp[1].content_str = "*";
 
+    size_t numHeaders = 2;
+    if (etag)
+    {
+        pHp[numHeaders].head = "ETag";
+        pHp[numHeaders++].content_str = etag;
+    }
+
     bool ok = _msgCreator.create_response(
         _headers,
         code,
         message,
         pHp, //headers,
-        _countof(pHp), //sizeof(headers) / sizeof(HeaderPair),
+        numHeaders,
         1,
         isHtml ? "text/html" : "application/json",
         bodySize
@@ -929,7 +1017,7 @@ bool Server::send(const HttpConnection::Ptr& conn, int code, const char* message
 
     _headers.clear();
     _body.clear();
-    return (ok && code == 200);
+    return (ok && (code == 200 || code == 304));
 }
 
 Server::IPAccessControl::IPAccessControl(const std::string &ipsFileName) :
@@ -19,6 +19,7 @@
 #include "utility/helpers.h"
 #include <string_view>
 #include <set>
+#include <map>
 #include "nlohmann/json.hpp"
 
 #define ExplorerNodeDirs(macro) \
@@ -63,7 +64,23 @@ private:
     void on_stream_accepted(io::TcpStream::Ptr&& newStream, io::ErrorCode errorCode);
 
     bool on_request(uint64_t id, const HttpMsgReader::Message& msg);
-    bool send(const HttpConnection::Ptr& conn, int code, const char* message, bool isHtml = false);
+    bool send(const HttpConnection::Ptr& conn, int code, const char* message, bool isHtml = false, const char* etag = nullptr);
+
+    // Rendered responses of the requests that depend only on the node state, by the full path.
+    // Valid until the node state changes.
+    struct CachedResponse
+    {
+        io::SerializedMsg body;
+        std::string etag;
+        bool isHtml;
+    };
+
+    struct ResponseCache
+    {
+        std::map<std::string, CachedResponse> items;
+        uint64_t stateVersion = 0;
+        size_t size = 0;
+    };
 
 #define THE_MACRO(dir) nlohmann::json on_request_##dir(const HttpConnection::Ptr& conn);
     ExplorerNodeDirs(THE_MACRO)
@@ -83,6 +100,7 @@ private:
     IPAccessControl _acl;
     std::vector<uint32_t> _whitelist;
     std::map<std::string_view, int> m_Dirs;
+    ResponseCache _cache;
 };
 
 }} //namespaces
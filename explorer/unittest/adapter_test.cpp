@@ -13,12 +13,17 @@
 // limitations under the License.
 
 #include "explorer/adapter.h"
+#include "explorer/server.h"
 #include "node/node.h"
+#include "http/http_client.h"
 #include "utility/logger.h"
+#include "wallet/unittests/test_helpers.h"
 #include <future>
 #include <boost/filesystem.hpp>
 #include <wallet/core/common_utils.h>
 
+WALLET_TEST_INIT
+
 namespace beam {
 
 struct WaitHandle {
@@ -80,6 +85,166 @@ void cleanup_files() {
     boost::filesystem::remove_all(FILENAME "_");
 }
 
+void raise_height_to(Node& node, Height h) {
+    while (node.get_Processor().m_Cursor.m_ID.m_Height < h) {
+        NodeProcessor::BlockContext bc(node.m_TxPool, 0, *node.m_Keys.m_pMiner, *node.m_Keys.m_pMiner);
+        WALLET_CHECK(node.get_Processor().GenerateNewBlock(bc));
+        node.get_Processor().OnState(bc.m_Hdr, PeerID());
+
+        Block::SystemState::ID id;
+        bc.m_Hdr.get_ID(id);
+        node.get_Processor().OnBlock(id, bc.m_BodyP, bc.m_BodyE, PeerID());
+        node.get_Processor().TryGoUp();
+    }
+}
+
+Transaction::Ptr make_coinbase_spend(Key::IKdf& kdf, Height hCoinbase, Height h) {
+    const Amount fee = 10900000;
+
+    Transaction::Ptr pTx = std::make_shared<Transaction>();
+    ECC::Scalar::Native offset, sk;
+
+    CoinID cidIn(Rules::get_Emission(hCoinbase), hCoinbase, Key::Type::Coinbase);
+    Input::Ptr pInp(new Input);
+    CoinID::Worker(cidIn).Create(sk, pInp->m_Commitment, kdf);
+    pTx->m_vInputs.push_back(std::move(pInp));
+    offset = sk;
+
+    Output::Ptr pOut(new Output);
+    pOut->Create(h + 1, sk, kdf, CoinID(cidIn.m_Value - fee, h, Key::Type::Regular), kdf);
+    pTx->m_vOutputs.push_back(std::move(pOut));
+    offset += -sk;
+
+    TxKernelStd::Ptr pKrn(new TxKernelStd);
+    pKrn->m_Fee = fee;
+    pKrn->m_Height.m_Min = h + 1;
+    kdf.DeriveKey(sk, Key::ID(h, Key::Type::Kernel)); // tests only
+    pKrn->Sign(sk);
+    pTx->m_vKernels.push_back(std::move(pKrn));
+    offset += -sk;
+
+    pTx->m_Offset = offset;
+    pTx->Normalize();
+    return pTx;
+}
+
+// Final blocks are rendered once and cached, yet they change when their outputs are spent (or unspent on rollback).
+// The server responses carry the ETag of the body, a matching If-None-Match is answered with 304.
+void test_block_cache() {
+    const char* szPath = FILENAME "_cache.db";
+    std::string sMappingPath;
+    NodeProcessor::get_MappingPath(sMappingPath, szPath);
+    boost::filesystem::remove(szPath);
+    boost::filesystem::remove(sMappingPath);
+
+    io::Reactor::Ptr reactor = io::Reactor::create();
+    io::Reactor::Scope scope(*reactor);
+
+    Node node;
+    node.m_Cfg.m_sPathLocal = szPath;
+    node.m_Cfg.m_MiningThreads = 0;
+
+    ECC::uintBig seed;
+    ECC::Hash::Processor()
+        << Blob("yyy", 3)
+        >> seed;
+    node.m_Keys.InitSingleKey(seed);
+
+    explorer::IAdapter::Ptr adapter = explorer::create_adapter(node);
+    node.Initialize();
+    adapter->Initialize();
+
+    const Height hFinal = 1;
+    raise_height_to(node, hFinal + Rules::get().MaxRollback + 1);
+    Height h = node.get_Processor().m_Cursor.m_ID.m_Height;
+
+    json j0 = adapter->get_block(hFinal);
+    WALLET_CHECK(j0 == adapter->get_block(hFinal)); // now it's cached
+    WALLET_CHECK(j0.dump().find("spent") == std::string::npos);
+
+    const uint16_t port = NODE_PORT + 1;
+    explorer::Server server(*adapter, *reactor, io::Address::localhost().port(port), "", std::vector<uint32_t>());
+    HttpClient client(*reactor);
+    io::Timer::Ptr pTimer = io::Timer::create(*reactor);
+
+    int status = 0;
+    std::string etag;
+    size_t bodySize = 0;
+
+    auto fnRequest = [&](const char* szIfNoneMatch) {
+        status = 0;
+        etag.clear();
+        bodySize = 0;
+
+        HeaderPair hp;
+        ZeroObject(hp);
+        hp.head = "If-None-Match";
+        hp.content_str = szIfNoneMatch;
+
+        HttpClient::Request req;
+        req.address(io::Address::localhost().port(port))
+            .pathAndQuery("/block?height=1")
+            .headers(&hp)
+            .numHeaders(szIfNoneMatch ? 1 : 0)
+            .callback([&](uint64_t, const HttpMsgReader::Message& msg) -> bool {
+                if (msg.what == HttpMsgReader::http_message) {
+                    status = msg.msg->get_status();
+                    etag = msg.msg->get_header("ETag");
+                    msg.msg->get_body(bodySize);
+                }
+                else
+                    status = -1;
+
+                reactor->stop();
+                return false;
+            });
+
+        // let the server start listening first
+        pTimer->start(100, false, [&]() {
+            if (!client.send_request(req))
+                reactor->stop();
+            else
+                pTimer->start(10000, false, [&]() { reactor->stop(); });
+        });
+
+        reactor->run();
+        pTimer->cancel();
+    };
+
+    fnRequest(nullptr);
+    WALLET_CHECK(status == 200);
+    WALLET_CHECK(!etag.empty());
+    WALLET_CHECK(bodySize > 0);
+    std::string etag0 = etag;
+
+    fnRequest(etag0.c_str());
+    WALLET_CHECK(status == 304);
+    WALLET_CHECK(etag == etag0);
+    WALLET_CHECK(!bodySize);
+
+    // spend its coinbase
+    WALLET_CHECK(proto::TxStatus::Ok == node.OnTransaction(make_coinbase_spend(*node.m_Keys.m_pMiner, hFinal, h), nullptr, nullptr, true, nullptr, nullptr));
+    raise_height_to(node, h + 1);
+
+    json j1 = adapter->get_block(hFinal);
+    WALLET_CHECK(j1 != j0);
+    WALLET_CHECK(j1.dump().find("spent") != std::string::npos);
+
+    fnRequest(etag0.c_str());
+    WALLET_CHECK(status == 200);
+    WALLET_CHECK(!etag.empty() && (etag != etag0));
+    std::string etag1 = etag;
+
+    // roll back the spending block
+    node.get_Processor().ManualRollbackTo(h);
+    WALLET_CHECK(node.get_Processor().m_Cursor.m_ID.m_Height == h);
+    WALLET_CHECK(adapter->get_block(hFinal) == j0);
+
+    fnRequest(etag1.c_str());
+    WALLET_CHECK(status == 200);
+    WALLET_CHECK(etag == etag0);
+}
+
 int test_adapter(int seconds) {
     cleanup_files();
     using namespace beam;
@@ -122,6 +287,8 @@ int main(int argc, char* argv[]) {
     ECC::InitializeContext();
     Rules::get().DA.Target_s = 1; // 1 minute
     Rules::get().DA.Difficulty0 = 1;
+    Rules::get().MaxRollback = 10; // let the blocks become final quickly
+    Rules::get().Maturity.Coinbase = 10;
 
     int seconds = 0;
     if (argc > 1) {
@@ -131,8 +298,12 @@ int main(int argc, char* argv[]) {
         seconds = 4;
         Rules::get().FakePoW = true;
     }
+    Rules::get().UpdateChecksum();
+
+    if (Rules::get().FakePoW)
+        test_block_cache(); // the blocks are generated without PoW
 
     int ret = test_adapter(seconds);
-    return ret;
+    return ret ? ret : WALLET_CHECK_RESULT;
 }
 
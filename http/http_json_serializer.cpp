@@ -31,6 +31,25 @@ bool serialize_json_msg(io::SerializedMsg& out, HttpMsgCreator& packer, const js
     return result;
 }
 
+void serialize_json_array_msg(io::SerializedMsg& out, HttpMsgCreator& packer, const json& header, const std::string& arrayKey, const JsonArrayFiller& fillArray) {
+    size_t initialFragments = out.size();
+    io::FragmentWriter& fw = packer.acquire_writer(out);
+    try {
+        JsonArrayMsgWriter writer(fw, header, arrayKey);
+        fillArray([&writer](const json& item) {
+            writer.write(item);
+        });
+        writer.finalize();
+    } catch (...) {
+        // flush the partial message out of the writer and drop it
+        fw.finalize();
+        packer.release_writer();
+        out.resize(initialFragments);
+        throw;
+    }
+    packer.release_writer();
+}
+
 } //namespace
 
 
@@ -15,6 +15,8 @@
 #pragma once
 #include "nlohmann/json_fwd.hpp"
 #include "utility/io/buffer.h"
+#include <functional>
+#include <string>
 
 namespace beam {
 
@@ -23,5 +25,10 @@ class HttpMsgCreator;
 // appends json msg to out by http packer
 bool serialize_json_msg(io::SerializedMsg& out, HttpMsgCreator& packer, const nlohmann::json& o);
 
+// appends json msg with an array member, whose items are written by fillArray one by one (see JsonArrayMsgWriter).
+// Nothing is appended if fillArray throws, the exception is passed on
+using JsonArrayFiller = std::function<void(const std::function<void(const nlohmann::json&)>&)>;
+void serialize_json_array_msg(io::SerializedMsg& out, HttpMsgCreator& packer, const nlohmann::json& header, const std::string& arrayKey, const JsonArrayFiller& fillArray);
+
 } //namespace
 
@@ -307,6 +307,70 @@ namespace beam::wallet
         return Status::Success;
     }
 
+    void LocalPrivateKeyKeeper2::InvokeAsync(Method::CreateOutput& m, const Handler::Ptr& pHandler)
+    {
+        // The wallet usually requests all the tx outputs in a row. Defer them till the next reactor cycle, and create them together
+        if (m_vPendingOutputs.empty())
+        {
+            if (!m_pFlushOutputs)
+            {
+                io::AsyncEvent::Callback cb = [this]() { FlushOutputs(); };
+                m_pFlushOutputs = io::AsyncEvent::create(io::Reactor::get_Current(), std::move(cb));
+            }
+
+            m_pFlushOutputs->post();
+        }
+
+        auto& x = m_vPendingOutputs.emplace_back();
+        x.m_pMethod = &m;
+        x.m_pHandler = pHandler;
+    }
+
+    void LocalPrivateKeyKeeper2::FlushOutputs()
+    {
+        struct MyTask
+            :public Executor::TaskSync
+        {
+            LocalPrivateKeyKeeper2* m_pThis;
+            std::vector<PendingOutput> m_vItems;
+            std::vector<Status::Type> m_vRes;
+
+            void Exec(Executor::Context& ctx) override
+            {
+                uint32_t i0, nCount;
+                ctx.get_Portion(i0, nCount, static_cast<uint32_t>(m_vItems.size()));
+
+                // CreateOutput only reads the keys, safe to invoke concurrently
+                for (uint32_t i = i0; i < i0 + nCount; i++)
+                    m_vRes[i] = m_pThis->InvokeSync(*m_vItems[i].m_pMethod);
+            }
+
+        } t;
+
+        t.m_pThis = this;
+        t.m_vItems.swap(m_vPendingOutputs);
+        t.m_vRes.resize(t.m_vItems.size(), Status::Unspecified);
+
+        if (t.m_vItems.size() > 1)
+            get_Executor().ExecAll(t);
+        else
+        {
+            for (size_t i = 0; i < t.m_vItems.size(); i++)
+                t.m_vRes[i] = InvokeSync(*t.m_vItems[i].m_pMethod);
+        }
+
+        for (size_t i = 0; i < t.m_vItems.size(); i++)
+            PushOut(t.m_vRes[i], t.m_vItems[i].m_pHandler);
+    }
+
+    Executor& LocalPrivateKeyKeeper2::get_Executor()
+    {
+        if (!m_pExecutor)
+            m_pExecutor = std::make_unique<ExecutorMT_R>();
+
+        return *m_pExecutor;
+    }
+
     IPrivateKeyKeeper2::Status::Type LocalPrivateKeyKeeper2::InvokeSync(Method::CreateInputShielded& x)
     {
         assert(x.m_pKernel && x.m_pList);
@@ -330,8 +394,7 @@ namespace beam::wallet
         x.m_pKernel->UpdateMsg();
         x.get_SkOut(prover.m_Witness.m_R_Output, x.m_pKernel->m_Fee, *m_pKdf);
 
-        ExecutorMT_R exec;
-        Executor::Scope scope(exec);
+        Executor::Scope scope(get_Executor());
         x.m_pKernel->Sign(prover, x.m_AssetID);
 
         return Status::Success;
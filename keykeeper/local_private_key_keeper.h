@@ -31,6 +31,19 @@ namespace beam::wallet
 
         struct Aggregation;
 
+        struct PendingOutput
+        {
+            Method::CreateOutput* m_pMethod;
+            Handler::Ptr m_pHandler;
+        };
+
+        std::vector<PendingOutput> m_vPendingOutputs;
+        io::AsyncEvent::Ptr m_pFlushOutputs;
+        std::unique_ptr<ExecutorMT_R> m_pExecutor;
+
+        Executor& get_Executor();
+        void FlushOutputs();
+
     public:
 
         LocalPrivateKeyKeeper2(const ECC::Key::IKdf::Ptr&);
@@ -41,6 +54,10 @@ namespace beam::wallet
         KEY_KEEPER_METHODS(THE_MACRO)
 #undef THE_MACRO
 
+        // Outputs requested asynchronously are accumulated, and then created all at once, their rangeproofs are generated in parallel
+        using PrivateKeyKeeper_AsyncNotify::InvokeAsync;
+        void InvokeAsync(Method::CreateOutput&, const Handler::Ptr&) override;
+
     protected:
 
         ECC::Key::IKdf::Ptr m_pKdf;
@@ -63,6 +63,9 @@ void Node::RefreshCongestions()
         if (!t.m_bNeeded)
             DeleteUnassignedTask(t);
     }
+
+	if (m_Cfg.m_BodySync.m_WindowSize)
+		CheckBodyStall();
 }
 
 void Node::UpdateSyncStatus()
@@ -371,35 +374,53 @@ bool Node::TryAssignTask(Task& t, Peer& p)
 	// assign
 	if (t.m_Key.second)
 	{
-		if (m_nTasksPackBody >= m_Cfg.m_MaxConcurrentBlocksRequest)
-			return false; // too many blocks requested
-
-		Height hCountExtra = t.m_sidTrg.m_Height - t.m_Key.first.m_Height;
+		if (nBlocks)
+			return false; // a single window per peer, the rest should be downloaded from others concurrently
 
 		proto::GetBodyPack msg;
 
+		NodeDB::StateID sidTop = t.m_sidTrg;
+
 		if (t.m_Key.first.m_Height <= m_Processor.m_SyncData.m_Target.m_Height)
 		{
 			// fast-sync mode, diluted blocks request.
-			msg.m_Top.m_Height = m_Processor.m_SyncData.m_Target.m_Height;
-			if (m_Processor.IsFastSync())
-				m_Processor.get_DB().get_StateHash(m_Processor.m_SyncData.m_Target.m_Row, msg.m_Top.m_Hash);
-			else
-				msg.m_Top.m_Hash = Zero; // treasury
+			if (!t.m_Key.first.m_Height || (sidTop.m_Height > m_Processor.m_SyncData.m_Target.m_Height))
+				sidTop = m_Processor.m_SyncData.m_Target;
 
-			msg.m_CountExtra = m_Processor.m_SyncData.m_Target.m_Height - t.m_Key.first.m_Height;
 			msg.m_Height0 = m_Processor.m_SyncData.m_h0;
 			msg.m_HorizonLo1 = m_Processor.m_SyncData.m_TxoLo;
 			msg.m_HorizonHi1 = m_Processor.m_SyncData.m_Target.m_Height;
 		}
-		else
+
+		Height hCountExtra = sidTop.m_Height - t.m_Key.first.m_Height;
+		uint32_t nMaxCount = get_BodyPackCount(p);
+
+		if (m_Cfg.m_BodySync.m_WindowSize && (hCountExtra >= nMaxCount))
 		{
-			// std blocks request
-			msg.m_Top.m_Height = t.m_sidTrg.m_Height;
-			m_Processor.get_DB().get_StateHash(t.m_sidTrg.m_Row, msg.m_Top.m_Hash);
-			msg.m_CountExtra = hCountExtra;
+			// shrink the request wrt this peer. The rest of the window will be requested once this part is received
+			NodeDB::StateID sid = sidTop;
+			Height dh = hCountExtra - (nMaxCount - 1);
+
+			for (; dh; dh--)
+				if (!m_Processor.get_DB().get_Prev(sid))
+					break;
+
+			if (!dh)
+			{
+				sidTop = sid;
+				hCountExtra = nMaxCount - 1;
+				t.m_sidTrg = sidTop;
+			}
 		}
 
+		msg.m_Top.m_Height = sidTop.m_Height;
+		if (sidTop.m_Height)
+			m_Processor.get_DB().get_StateHash(sidTop.m_Row, msg.m_Top.m_Hash);
+		else
+			msg.m_Top.m_Hash = Zero; // treasury
+
+		msg.m_CountExtra = hCountExtra;
+
 		p.Send(msg);
 
 		t.m_nCount = std::min(static_cast<uint32_t>(msg.m_CountExtra), m_Cfg.m_BandwidthCtl.m_MaxBodyPackCount) + 1; // just an estimate, the actual num of blocks can be smaller
@@ -458,6 +479,74 @@ bool Node::TryAssignTask(Task& t, Peer& p)
     return true;
 }
 
+uint32_t Node::get_BodyPackCount(const Peer& p) const
+{
+	uint32_t nCount = m_Cfg.m_BandwidthCtl.m_MaxBodyPackCount;
+
+	if (m_Cfg.m_BodySync.m_WindowSize && p.m_pInfo)
+	{
+		// should fit the pack size limit, and the peer should be able to send it well before it's considered stalling
+		uint64_t nSize = static_cast<uint64_t>(PeerManager::Rating::ToBps(p.m_pInfo->m_RawRating.m_Value)) * m_Cfg.m_BodySync.m_Stall_ms / 2000;
+		std::setmin(nSize, m_Cfg.m_BandwidthCtl.m_MaxBodyPackSize);
+
+		uint64_t nBlockSize = m_BodySizeAvg ? m_BodySizeAvg : Rules::get().MaxBodySize; // be conservative until the actual size is known
+		std::setmin(nCount, static_cast<uint32_t>(std::max<uint64_t>(nSize / std::max<uint64_t>(nBlockSize, 1), 1)));
+	}
+
+	return std::max(nCount, 1U);
+}
+
+Node::Task* Node::get_LowestBodyTask()
+{
+	Task* pRet = nullptr;
+	for (TaskSet::iterator it = m_setTasks.begin(); m_setTasks.end() != it; ++it)
+	{
+		Task& t = *it;
+		if (t.m_Key.second && t.m_pOwner && (!pRet || (t.m_Key.first.m_Height < pRet->m_Key.first.m_Height)))
+			pRet = &t;
+	}
+	return pRet;
+}
+
+void Node::OnBodyPack(const Task& t, size_t nBlocks, size_t nSize)
+{
+	if (nBlocks)
+	{
+		// moving average, roughly over the last 16 packs
+		uint32_t nAvg = static_cast<uint32_t>(std::min<size_t>(nSize / nBlocks, Rules::get().MaxBodySize));
+		m_BodySizeAvg = m_BodySizeAvg ? (m_BodySizeAvg - (m_BodySizeAvg >> 4) + (nAvg >> 4)) : nAvg;
+	}
+
+	const Task* pLowest = get_LowestBodyTask();
+	if (pLowest && (pLowest != &t))
+		m_TimeBodyDone_ms = PeerManager::TimePoint::get(); // a higher window is received, whereas the lowest one is still in progress
+}
+
+void Node::CheckBodyStall()
+{
+	// If the lowest window is still in progress, whereas a higher one was received after it was assigned - its owner may stall the sync.
+	// Give it m_Stall_ms since the assignment, then disconnect. The window would be reassigned.
+	Task* pLowest = get_LowestBodyTask();
+	if (!pLowest || (&pLowest->m_pOwner->m_lstTasks.front() != pLowest))
+		return;
+
+	uint32_t dt_ms = m_TimeBodyDone_ms - pLowest->m_TimeAssigned_ms;
+	if (!dt_ms || (dt_ms >= 0x80000000U))
+		return; // nothing was received since it was assigned
+
+	dt_ms = PeerManager::TimePoint::get() - pLowest->m_TimeAssigned_ms;
+	if (dt_ms >= m_Cfg.m_Timeout.m_GetBlock_ms)
+		return; // the std timeout is already due
+
+	uint32_t timeout_ms = (dt_ms < m_Cfg.m_BodySync.m_Stall_ms) ? (m_Cfg.m_BodySync.m_Stall_ms - dt_ms) : 0;
+	if (timeout_ms >= m_Cfg.m_Timeout.m_GetBlock_ms - dt_ms)
+		return;
+
+	Peer& p = *pLowest->m_pOwner;
+	assert(p.m_pTimerRequest);
+	p.m_pTimerRequest->start(timeout_ms, false, [&p]() { p.OnRequestTimeout(); });
+}
+
 void Node::Peer::SetTimerWrtFirstTask()
 {
 	if (m_lstTasks.empty())
@@ -582,6 +671,8 @@ void Node::DeleteOutdated()
             x.m_Hist.m_Height = m_Processor.m_Cursor.m_ID.m_Height;
             m_TxPool.SetState(x, TxPool::Fluff::State::Outdated);
         }
+        else
+            x.m_Profit.m_Stats.SetBvmCharge(nBvmCharge); // may change wrt the new state
 	}
 
     for (TxPool::Stem::TimeSet::iterator it = m_Dandelion.m_setTime.begin(); m_Dandelion.m_setTime.end() != it; )
@@ -651,6 +742,8 @@ void Node::Processor::OnNewState()
         get_ParentObj().m_Miner.SetTimer(0, true); // async start mining
     }
 
+    get_ParentObj().PushEvents(); // before the NewTip, so that the wallets won't poll for them
+
     proto::NewTip msg;
     msg.m_Description = m_Cursor.m_Full;
 
@@ -768,8 +861,9 @@ void Node::Processor::OnRolledBack()
 		TxPool::Fluff::Element& x = (it++)->get_ParentObj();
         if (!IsShieldedInPool(*x.m_pValue))
         {
-            get_ParentObj().OnTransactionDeferred(std::move(x.m_pValue), nullptr, nullptr, true);
-            get_ParentObj().m_TxPool.Delete(x);
+            Transaction::Ptr pTx = std::move(x.m_pValue);
+            get_ParentObj().m_TxPool.Delete(x); // before it's deferred, otherwise it'd be considered a duplicate
+            get_ParentObj().OnTransactionDeferred(std::move(pTx), nullptr, nullptr, true);
         }
 	}
 
@@ -792,6 +886,13 @@ void Node::Processor::OnRolledBack()
 
     get_ParentObj().m_TxDependent.Clear();
 
+    // events above are reverted, push the new ones from here
+    for (PeerList::iterator it = get_ParentObj().m_lstPeers.begin(); get_ParentObj().m_lstPeers.end() != it; ++it)
+    {
+        if (it->m_hEventsPush)
+            std::setmin(it->m_hEventsPush, m_Cursor.m_ID.m_Height + 1);
+    }
+
 	IObserver* pObserver = get_ParentObj().m_Cfg.m_Observer;
 	if (pObserver)
 		pObserver->OnRolledBack(m_Cursor.m_ID);
@@ -857,6 +958,16 @@ void Node::Processor::Stop()
     }
 }
 
+void Node::Processor::get_BodyWindows(BodyWindows& bw)
+{
+	const Config& cfg = get_ParentObj().m_Cfg; // alias
+	if (cfg.m_BodySync.m_WindowSize)
+	{
+		bw.m_Size = std::min(cfg.m_BodySync.m_WindowSize, cfg.m_BandwidthCtl.m_MaxBodyPackCount);
+		bw.m_Count = std::max(cfg.m_BodySync.m_Windows, 1U);
+	}
+}
+
 Height Node::Processor::get_MaxAutoRollback()
 {
     Height h = NodeProcessor::get_MaxAutoRollback();
@@ -1525,6 +1636,9 @@ void Node::Peer::SetupLogin(proto::Login& msg)
 
 	if (m_This.m_Cfg.m_Bbs.IsEnabled())
 		msg.m_Flags |= proto::LoginFlags::Bbs; // indicate ability to receive and broadcast BBS messages
+
+	if (m_This.m_Cfg.m_Reconciliation.m_Period_ms)
+		msg.m_Flags |= proto::LoginFlags::Reconciliation;
 }
 
 Height Node::Peer::get_MinPeerFork()
@@ -2358,6 +2472,7 @@ void Node::Peer::OnMsg(proto::BodyPack&& msg)
 			BEAM_LOG_INFO() << id << " Block pack received " << id.m_Height << "-" << (id.m_Height + msg.m_Bodies.size() - 1);
 
 			eStatus = NodeProcessor::DataStatus::Accepted;
+			m_This.OnBodyPack(t, msg.m_Bodies.size(), nSize);
 
 			for (Height h = 0; h < msg.m_Bodies.size(); h++)
 			{
@@ -2409,7 +2524,7 @@ void Node::Peer::OnMsg(proto::NewTransaction&& msg)
         std::ostringstream errInfo;
 
         proto::Status msgOut;
-        msgOut.m_Value = m_This.OnTransaction(std::move(msg.m_Transaction), std::move(msg.m_Context), pSender, msg.m_Fluff, &errInfo);
+        msgOut.m_Value = m_This.OnTransaction(std::move(msg.m_Transaction), std::move(msg.m_Context), pSender, msg.m_Fluff, &errInfo, nullptr);
 
         msgOut.m_ExtraInfo = errInfo.str();
         Send(msgOut);
@@ -2422,60 +2537,165 @@ void Node::Peer::OnMsg(proto::NewTransaction&& msg)
 
 void Node::OnTransactionDeferred(Transaction::Ptr&& pTx, std::unique_ptr<Merkle::Hash>&& pCtx, const PeerID* pSender, bool bFluff)
 {
+    Transaction::KeyType keyTx;
+    pTx->get_Key(keyTx);
+
+    // drop duplicates before any crypto
+    auto itDup = m_TxDeferred.m_mapKeys.find(keyTx);
+    if (m_TxDeferred.m_mapKeys.end() != itDup)
+    {
+        TxDeferred::Element& x = *itDup->second;
+        if (bFluff && !x.m_pCtx && !pCtx)
+            x.m_Fluff = true;
+
+        m_TxDeferred.m_Stats.m_Duplicates++;
+        return;
+    }
+
+    bool bKnown = (m_TxReject.end() != m_TxReject.find(keyTx));
+    if (!bKnown)
+    {
+        if (pCtx)
+        {
+            auto itD = m_TxDependent.m_setTxs.find(keyTx, TxPool::Dependent::Element::Tx::Comparator());
+            bKnown = (m_TxDependent.m_setTxs.end() != itD) && (itD->get_ParentObj().m_Fluff || !bFluff);
+        }
+        else
+        {
+            auto itF = m_TxPool.m_setTxs.find(keyTx, TxPool::Fluff::Element::Tx::Comparator());
+            bKnown = (m_TxPool.m_setTxs.end() != itF) && (TxPool::Fluff::State::Fluffed == itF->get_ParentObj().m_State);
+        }
+    }
+
+    if (bKnown)
+    {
+        m_TxDeferred.m_Stats.m_Duplicates++;
+        return;
+    }
+
     TxDeferred::Element txd;
     txd.m_pTx = std::move(pTx);
     txd.m_pCtx = std::move(pCtx);
+    txd.m_Key = keyTx;
     txd.m_Fluff = bFluff;
+    txd.m_Arrived_ms = GetTime_ms();
 
     if (pSender)
         txd.m_Sender = *pSender;
     else
         txd.m_Sender = Zero;
 
-    //if (m_Cfg.m_LogTxFluff)
-    //{
-    //    Transaction::KeyType key;
-    //    txd.m_pTx->get_Key(key);
-
-    //    BEAM_LOG_INFO() << "Tx " << key << " deferred";
-    //}
-
     if (m_TxDeferred.m_lst.empty())
         m_TxDeferred.start();
     else
     {
         while (m_TxDeferred.m_lst.size() > m_Cfg.m_MaxDeferredTransactions)
-            m_TxDeferred.m_lst.pop_front();
+        {
+            m_TxDeferred.PopFront();
+            m_TxDeferred.m_Stats.m_Overflow++;
+        }
     }
 
     m_TxDeferred.m_lst.push_back(std::move(txd));
+    m_TxDeferred.m_mapKeys[keyTx] = std::prev(m_TxDeferred.m_lst.end());
+
+    std::setmax(m_TxDeferred.m_Stats.m_DepthMax, static_cast<uint32_t>(m_TxDeferred.m_lst.size()));
+}
+
+void Node::TxDeferred::PopFront()
+{
+    assert(!m_lst.empty());
+    m_mapKeys.erase(m_lst.front().m_Key);
+    m_lst.pop_front();
 }
 
 void Node::TxDeferred::OnSchedule()
 {
-    if (!m_lst.empty())
+    Node& n = get_ParentObj();
+
+    // Detach the batch first, the admission may append more txs
+    std::vector<Element> vBatch;
+    vBatch.reserve(std::min<size_t>(m_lst.size(), std::max(n.m_Cfg.m_TxAdmission.m_BatchMax, 1U)));
+
+    while (!m_lst.empty() && (vBatch.size() < vBatch.capacity()))
     {
-        TxDeferred::Element& x = m_lst.front();
-        get_ParentObj().OnTransaction(std::move(x.m_pTx), std::move(x.m_pCtx), &x.m_Sender, x.m_Fluff, nullptr);
-        m_lst.pop_front();
+        vBatch.push_back(std::move(m_lst.front()));
+        PopFront();
     }
 
+    if (!vBatch.empty())
+    {
+        // Stage 1: context-free, in parallel
+        std::vector<NodeProcessor::ContextFreeTx> vCF(vBatch.size());
+        for (size_t i = 0; i < vBatch.size(); i++)
+        {
+            auto& cf = vCF[i];
+            cf.m_pTx = vBatch[i].m_pTx.get();
+            cf.m_Ctx.m_Height.m_Min = n.m_Processor.m_Cursor.m_ID.m_Height + 1;
+        }
+
+        n.m_Processor.ValidateAndSummarizeBatch(&vCF.front(), static_cast<uint32_t>(vCF.size()));
+
+        // Stage 2: context-dependent, serialized
+        uint32_t t_ms = GetTime_ms();
+        for (size_t i = 0; i < vBatch.size(); i++)
+        {
+            Element& x = vBatch[i];
+            n.OnTransaction(std::move(x.m_pTx), std::move(x.m_pCtx), &x.m_Sender, x.m_Fluff, nullptr, &vCF[i]);
+
+            uint32_t dt_ms = t_ms - x.m_Arrived_ms;
+            m_Stats.m_Latency_ms += dt_ms;
+            std::setmax(m_Stats.m_LatencyMax_ms, dt_ms);
+        }
+
+        m_Stats.m_Admitted += vBatch.size();
+        m_Stats.m_Batches++;
+
+        BEAM_LOG_DEBUG() << "Tx admission batch=" << vBatch.size() << ", pending=" << m_lst.size() << ", latency avg=" << (m_Stats.m_Latency_ms / m_Stats.m_Admitted) << " ms, max=" << m_Stats.m_LatencyMax_ms << " ms";
+    }
+
+    if (m_bPostponed)
+        RequestPostponed();
+
     if (m_lst.empty())
         cancel();
 
 }
 
-uint8_t Node::OnTransaction(Transaction::Ptr&& pTx, std::unique_ptr<Merkle::Hash>&& pCtx, const PeerID* pSender, bool bFluff, std::ostream* pExtraInfo)
+void Node::TxDeferred::RequestPostponed()
+{
+    Node& n = get_ParentObj();
+
+    uint32_t nBackPressure = n.m_Cfg.m_TxAdmission.m_BackPressure;
+    if (m_lst.size() >= nBackPressure)
+        return;
+
+    // request no more than the queue can take before it's congested again, the rest waits for the next drain
+    uint32_t nMax = nBackPressure - static_cast<uint32_t>(m_lst.size());
+    m_bPostponed = false;
+
+    for (PeerList::iterator it = n.m_lstPeers.begin(); n.m_lstPeers.end() != it; ++it)
+    {
+        Peer& peer = *it;
+        if (nMax)
+            peer.RequestPostponedTxs(nMax);
+
+        if (!peer.m_setTxPostponed.empty())
+            m_bPostponed = true;
+    }
+}
+
+uint8_t Node::OnTransaction(Transaction::Ptr&& pTx, std::unique_ptr<Merkle::Hash>&& pCtx, const PeerID* pSender, bool bFluff, std::ostream* pExtraInfo, const NodeProcessor::ContextFreeTx* pCF)
 {
     return 
         pCtx ?
-            OnTransactionDependent(std::move(pTx), *pCtx, pSender, bFluff, pExtraInfo) :
+            OnTransactionDependent(std::move(pTx), *pCtx, pSender, bFluff, pExtraInfo, pCF) :
             bFluff ?
-                OnTransactionFluff(std::move(pTx), pExtraInfo, pSender, nullptr) :
-                OnTransactionStem(std::move(pTx), pExtraInfo);
+                OnTransactionFluff(std::move(pTx), pExtraInfo, pSender, nullptr, pCF) :
+                OnTransactionStem(std::move(pTx), pExtraInfo, pCF);
 }
 
-uint8_t Node::ValidateTx(TxPool::Stats& stats, const Transaction& tx, const Transaction::KeyType& keyTx, std::ostream* pExtraInfo, bool& bAlreadyRejected)
+uint8_t Node::ValidateTx(TxPool::Stats& stats, const Transaction& tx, const Transaction::KeyType& keyTx, std::ostream* pExtraInfo, bool& bAlreadyRejected, const NodeProcessor::ContextFreeTx* pCF)
 {
     auto it = m_TxReject.find(keyTx);
     if (m_TxReject.end() != it)
@@ -2488,16 +2708,13 @@ uint8_t Node::ValidateTx(TxPool::Stats& stats, const Transaction& tx, const Tran
     uint32_t nBvmCharge = 0;
     Amount feeReserve = 0;
 
-    uint8_t nRet = ValidateTx2(ctx, tx, nBvmCharge, feeReserve, nullptr, pExtraInfo, nullptr);
+    uint8_t nRet = ValidateTx2(ctx, tx, nBvmCharge, feeReserve, nullptr, pExtraInfo, nullptr, pCF);
     if (proto::TxStatus::Ok == nRet)
     {
         if (AmountBig::get_Hi(ctx.m_Stats.m_Fee))
             nRet = proto::TxStatus::LowFee; // actually it's ridiculously-high fee
         else
-        {
-            auto nSizeCorrection = (uint32_t)(((uint64_t)nBvmCharge) * Rules::get().MaxBodySize / bvm2::Limits::BlockCharge);
-            stats.From(tx, ctx, feeReserve, nSizeCorrection);
-        }
+            stats.From(tx, ctx, feeReserve, nBvmCharge);
     }
 
     if (proto::TxStatus::Ok != nRet)
@@ -2509,12 +2726,23 @@ uint8_t Node::ValidateTx(TxPool::Stats& stats, const Transaction& tx, const Tran
     return nRet;
 }
 
-uint8_t Node::ValidateTx2(Transaction::Context& ctx, const Transaction& tx, uint32_t& nBvmCharge, Amount& feeReserve, TxPool::Dependent::Element* pParent, std::ostream* pExtraInfo, Merkle::Hash* pNewCtx)
+uint8_t Node::ValidateTx2(Transaction::Context& ctx, const Transaction& tx, uint32_t& nBvmCharge, Amount& feeReserve, TxPool::Dependent::Element* pParent, std::ostream* pExtraInfo, Merkle::Hash* pNewCtx, const NodeProcessor::ContextFreeTx* pCF)
 {
     ctx.m_Height.m_Min = m_Processor.m_Cursor.m_ID.m_Height + 1;
 
     std::string sErr;
-    bool bValid = m_Processor.ValidateAndSummarize(ctx, tx, tx.get_Reader(), sErr);
+    bool bValid;
+
+    if (pCF && (pCF->m_pTx == &tx) && (pCF->m_Ctx.m_Height.m_Min == ctx.m_Height.m_Min))
+    {
+        bValid = pCF->m_Valid;
+        if (bValid)
+            ctx = pCF->m_Ctx;
+        else
+            sErr = pCF->m_sErr;
+    }
+    else
+        bValid = m_Processor.ValidateAndSummarize(ctx, tx, tx.get_Reader(), sErr);
     if (bValid)
     {
         try {
@@ -2670,7 +2898,7 @@ uint32_t Node::RandomUInt32(uint32_t threshold)
     return threshold;
 }
 
-uint8_t Node::OnTransactionStem(Transaction::Ptr&& ptx, std::ostream* pExtraInfo)
+uint8_t Node::OnTransactionStem(Transaction::Ptr&& ptx, std::ostream* pExtraInfo, const NodeProcessor::ContextFreeTx* pCF)
 {
 	TxStats s;
 	ptx->get_Reader().AddStats(s);
@@ -2714,7 +2942,7 @@ uint8_t Node::OnTransactionStem(Transaction::Ptr&& ptx, std::ostream* pExtraInfo
     if (!bTested)
     {
         bool bAlreadyRejected = false;
-        uint8_t nCode = ValidateTx(stats, *ptx, keyTx, pExtraInfo, bAlreadyRejected);
+        uint8_t nCode = ValidateTx(stats, *ptx, keyTx, pExtraInfo, bAlreadyRejected, pCF);
         if (proto::TxStatus::Ok != nCode)
         {
             if (!bAlreadyRejected)
@@ -2815,7 +3043,7 @@ void Node::OnTransactionAggregated(Transaction::Ptr&& pTx, const TxPool::Stats&
     else
     {
         LogTxStem(*pTx, "Going to fluff");
-        OnTransactionFluff(std::move(pTx), nullptr, nullptr, &stats);
+        OnTransactionFluff(std::move(pTx), nullptr, nullptr, &stats, nullptr);
     }
 }
 
@@ -3033,7 +3261,7 @@ Height Node::SampleDummySpentHeight()
 	return h;
 }
 
-uint8_t Node::OnTransactionFluff(Transaction::Ptr&& ptxArg, std::ostream* pExtraInfo, const PeerID* pSender, const TxPool::Stats* pStats)
+uint8_t Node::OnTransactionFluff(Transaction::Ptr&& ptxArg, std::ostream* pExtraInfo, const PeerID* pSender, const TxPool::Stats* pStats, const NodeProcessor::ContextFreeTx* pCF)
 {
     Transaction::Ptr ptx;
     ptx.swap(ptxArg);
@@ -3056,7 +3284,7 @@ uint8_t Node::OnTransactionFluff(Transaction::Ptr&& ptxArg, std::ostream* pExtra
             const auto& pTxToTest = pF ? pF->m_pValue : ptx; // avoid ambiguity
 
             bool bAlreadyRejected = false;
-            uint8_t nCode = ValidateTx(stats, *pTxToTest, keyTx, pExtraInfo, bAlreadyRejected);
+            uint8_t nCode = ValidateTx(stats, *pTxToTest, keyTx, pExtraInfo, bAlreadyRejected, pCF);
 
             if (!bAlreadyRejected)
                 LogTx(*pTxToTest, nCode, keyTx);
@@ -3094,9 +3322,6 @@ void Node::OnTransactionFluff(TxPool::Fluff::Element& x, const PeerID* pSender)
 {
     m_TxPool.SetState(x, TxPool::Fluff::State::Fluffed);
 
-    proto::HaveTransaction msgOut;
-    msgOut.m_ID = x.m_Tx.m_Key;
-
     for (PeerList::iterator it2 = m_lstPeers.begin(); m_lstPeers.end() != it2; ++it2)
     {
         Peer& peer = *it2;
@@ -3105,14 +3330,14 @@ void Node::OnTransactionFluff(TxPool::Fluff::Element& x, const PeerID* pSender)
         if (!(peer.m_LoginFlags & proto::LoginFlags::SpreadingTransactions) || peer.IsChocking())
             continue;
 
-        peer.Send(msgOut);
+        peer.Announce(proto::Reconcile::Tx, x.m_Tx.m_Key);
         peer.SetTxCursor(x.m_pSend);
     }
 
-    m_Miner.SoftRestart();
+    m_Miner.OnTxFluffed(x.m_Profit);
 }
 
-uint8_t Node::OnTransactionDependent(Transaction::Ptr&& pTx, const Merkle::Hash& hvCtx, const PeerID* pSender, bool bFluff, std::ostream* pExtraInfo)
+uint8_t Node::OnTransactionDependent(Transaction::Ptr&& pTx, const Merkle::Hash& hvCtx, const PeerID* pSender, bool bFluff, std::ostream* pExtraInfo, const NodeProcessor::ContextFreeTx* pCF)
 {
     Transaction::KeyType keyTx;
     pTx->get_Key(keyTx);
@@ -3139,7 +3364,7 @@ uint8_t Node::OnTransactionDependent(Transaction::Ptr&& pTx, const Merkle::Hash&
         uint32_t nBvmCharge = 0;
         Amount feeReserve = 0;
         Merkle::Hash hvCtxNew;
-        uint8_t nRes = ValidateTx2(ctx, *pTx, nBvmCharge, feeReserve, pParent, pExtraInfo, &hvCtxNew);
+        uint8_t nRes = ValidateTx2(ctx, *pTx, nBvmCharge, feeReserve, pParent, pExtraInfo, &hvCtxNew, pCF);
 
         if (proto::TxStatus::Ok != nRes)
             return nRes;
@@ -3147,10 +3372,7 @@ uint8_t Node::OnTransactionDependent(Transaction::Ptr&& pTx, const Merkle::Hash&
         if (m_TxDependent.m_setContexts.find(hvCtxNew, TxPool::Dependent::Element::Context::Comparator()) != m_TxDependent.m_setContexts.end())
             return proto::TxStatus::DependentNoNewCtx;
         
-        pElem = m_TxDependent.AddValidTx(std::move(pTx), ctx, keyTx, hvCtxNew, pParent);
-        pElem->m_BvmCharge = nBvmCharge;
-        if (pParent)
-            pElem->m_BvmCharge += pParent->m_BvmCharge;
+        pElem = m_TxDependent.AddValidTx(std::move(pTx), ctx, keyTx, hvCtxNew, nBvmCharge, pParent);
     }
 
     struct MySelector :public Peer::ISelector {
@@ -3273,6 +3495,8 @@ void Node::Peer::OnLogin(proto::Login&& msg, uint32_t nFlagsPrev)
 		m_This.m_Miner.OnFinalizerChanged(b ? NULL : this);
 	}
 
+	OnLoginReconcile();
+
 	BroadcastTxs();
 	BroadcastBbs();
 }
@@ -3341,9 +3565,7 @@ void Node::Peer::BroadcastTxs()
 			continue; // already deleted
         auto& x = *m_pCursorTx->m_pThis;
 
-		proto::HaveTransaction msgOut;
-		msgOut.m_ID = x.m_Tx.m_Key;
-		Send(msgOut);
+		Announce(proto::Reconcile::Tx, x.m_Tx.m_Key);
 
 		nExtra += x.m_Profit.m_Stats.m_Size;
 		if (IsChocking(nExtra))
@@ -3368,9 +3590,7 @@ void Node::Peer::BroadcastBbs()
 	wlk.m_ID = m_CursorBbs;
 	for (db.EnumAllBbsSeq(wlk); wlk.MoveNext(); )
 	{
-		proto::BbsHaveMsg msgOut;
-		msgOut.m_Key = wlk.m_Key;
-		Send(msgOut);
+		Announce(proto::Reconcile::Bbs, wlk.m_Key);
 
 		nExtra += wlk.m_Size;
 		if (IsChocking(nExtra))
@@ -3380,6 +3600,289 @@ void Node::Peer::BroadcastBbs()
 	m_CursorBbs = wlk.m_ID;
 }
 
+void Node::Peer::Announce(uint8_t iType, const ECC::Hash::Value& key)
+{
+	const Config::Reconciliation& cfg = m_This.m_Cfg.m_Reconciliation;
+
+	bool bFlood =
+		!IsReconciling(iType) ||
+		(!(Flags::Accepted & m_Flags) && (m_This.RandomUInt32(0x10000) < cfg.m_FloodProbability)); // keep the fast propagation path
+
+	if (!bFlood)
+	{
+		std::set<ECC::Hash::Value>& s = m_pReconcile[iType].m_setPending;
+		if (s.size() < cfg.m_MaxPending)
+		{
+			s.insert(key);
+			return;
+		}
+	}
+
+	SendHave(iType, key);
+}
+
+void Node::Peer::SendHave(uint8_t iType, const ECC::Hash::Value& key)
+{
+	if (proto::Reconcile::Tx == iType)
+	{
+		proto::HaveTransaction msgOut;
+		msgOut.m_ID = key;
+		Send(msgOut);
+	}
+	else
+	{
+		proto::BbsHaveMsg msgOut;
+		msgOut.m_Key = key;
+		Send(msgOut);
+	}
+}
+
+void Node::Peer::OnPeerHave(uint8_t iType, const ECC::Hash::Value& key)
+{
+	if (proto::Reconcile::Tx == iType)
+	{
+		proto::HaveTransaction msg;
+		msg.m_ID = key;
+		OnMsg(std::move(msg));
+	}
+	else
+	{
+		proto::BbsHaveMsg msg;
+		msg.m_Key = key;
+		OnMsg(std::move(msg));
+	}
+}
+
+bool Node::Peer::IsReconciling(uint8_t iType) const
+{
+	if (!m_This.m_Cfg.m_Reconciliation.m_Period_ms || !(proto::LoginFlags::Reconciliation & m_LoginFlags))
+		return false;
+
+	if (proto::Reconcile::Tx == iType)
+		return !!(proto::LoginFlags::SpreadingTransactions & m_LoginFlags);
+
+	return m_This.m_Cfg.m_Bbs.IsEnabled() && (proto::LoginFlags::Bbs & m_LoginFlags);
+}
+
+bool Node::Peer::IsReconcileRelevant(uint8_t iType, const ECC::Hash::Value& key)
+{
+	if (proto::Reconcile::Tx == iType)
+	{
+		TxPool::Fluff::TxSet::iterator it = m_This.m_TxPool.m_setTxs.find(key, TxPool::Fluff::Element::Tx::Comparator());
+		return
+			(m_This.m_TxPool.m_setTxs.end() != it) &&
+			(TxPool::Fluff::State::Fluffed == it->get_ParentObj().m_State);
+	}
+
+	return !!m_This.m_Processor.get_DB().BbsFind(key);
+}
+
+void Node::Peer::ReconcilePrune(uint8_t iType)
+{
+	// forget those that are already mined/expired
+	std::set<ECC::Hash::Value>& s = m_pReconcile[iType].m_setPending;
+	for (auto it = s.begin(); s.end() != it; )
+	{
+		if (IsReconcileRelevant(iType, *it))
+			++it;
+		else
+			it = s.erase(it);
+	}
+}
+
+void Node::Peer::ReconcileFlush(uint8_t iType)
+{
+	std::set<ECC::Hash::Value>& s = m_pReconcile[iType].m_setPending;
+	for (const auto& key : s)
+		SendHave(iType, key);
+
+	s.clear();
+}
+
+void Node::Peer::OnLoginReconcile()
+{
+	bool bAny = false;
+	for (uint8_t iType = 0; iType < proto::Reconcile::s_Types; iType++)
+	{
+		if (IsReconciling(iType))
+			bAny = true;
+		else
+			ReconcileFlush(iType); // in case the peer changed its mind
+	}
+
+	if (Flags::Accepted & m_Flags)
+		return; // the connecting side initiates
+
+	if (bAny)
+	{
+		if (!m_pTimerReconcile)
+			m_pTimerReconcile = io::Timer::create(io::Reactor::get_Current());
+
+		m_pTimerReconcile->start(m_This.m_Cfg.m_Reconciliation.m_Period_ms, true, [this]() { OnReconcileTimer(); });
+	}
+	else
+	{
+		if (m_pTimerReconcile)
+			m_pTimerReconcile->cancel();
+	}
+}
+
+void Node::Peer::OnReconcileTimer()
+{
+	if (IsChocking())
+		return;
+
+	for (uint8_t iType = 0; iType < proto::Reconcile::s_Types; iType++)
+	{
+		ReconcileState& rs = m_pReconcile[iType];
+		if (rs.m_bRound || !IsReconciling(iType))
+			continue;
+
+		ReconcilePrune(iType);
+
+		proto::ReconcileRequest msg;
+		msg.m_Type = iType;
+		msg.m_SetSize = static_cast<uint32_t>(rs.m_setPending.size());
+		msg.m_DiffRatio = rs.m_DiffRatio;
+		m_This.NextNonce().ExportWord<0>(msg.m_Salt);
+
+		rs.m_Salt = msg.m_Salt;
+		rs.m_bRound = true;
+
+		Send(msg);
+	}
+}
+
+void Node::Peer::OnMsg(proto::ReconcileRequest&& msg)
+{
+	if ((msg.m_Type >= proto::Reconcile::s_Types) || !(Flags::Accepted & m_Flags))
+		ThrowUnexpected();
+
+	ReconcileState& rs = m_pReconcile[msg.m_Type];
+	if (rs.m_bRound)
+		ThrowUnexpected();
+
+	proto::ReconcileSketch msgOut;
+	msgOut.m_Type = msg.m_Type;
+
+	if (IsReconciling(msg.m_Type))
+	{
+		ReconcilePrune(msg.m_Type);
+
+		uint64_t nMy = rs.m_setPending.size();
+		uint64_t nDiff = proto::Reconcile::get_Diff(nMy, msg.m_SetSize, msg.m_DiffRatio);
+
+		if (nDiff < proto::Reconcile::s_MaxCells)
+		{
+			uint32_t nCells = Iblt::get_CellsFor(static_cast<uint32_t>(nDiff));
+
+			// the sketch should be smaller than the announcements it replaces
+			if ((nCells <= proto::Reconcile::s_MaxCells) && (nCells < nMy + msg.m_SetSize))
+			{
+				Iblt iblt;
+				iblt.Reset(nCells, msg.m_Salt);
+
+				for (const auto& key : rs.m_setPending)
+					iblt.Add(key);
+
+				msgOut.m_Cells.swap(iblt.m_vCells);
+			}
+		}
+
+		rs.m_vSketched.assign(rs.m_setPending.begin(), rs.m_setPending.end());
+		rs.m_setPending.clear();
+	}
+
+	rs.m_bRound = true;
+	Send(msgOut);
+}
+
+void Node::Peer::OnMsg(proto::ReconcileSketch&& msg)
+{
+	if ((msg.m_Type >= proto::Reconcile::s_Types) ||
+		(msg.m_Cells.size() > proto::Reconcile::s_MaxCells) ||
+		(msg.m_Cells.size() % Iblt::s_Hashes))
+		ThrowUnexpected();
+
+	ReconcileState& rs = m_pReconcile[msg.m_Type];
+	if (!rs.m_bRound || (Flags::Accepted & m_Flags))
+		ThrowUnexpected();
+
+	rs.m_bRound = false;
+	ReconcilePrune(msg.m_Type);
+
+	proto::ReconcileDone msgOut;
+	msgOut.m_Type = msg.m_Type;
+	msgOut.m_Decoded = false;
+
+	std::vector<Iblt::Key> vMy, vPeer;
+	if (!msg.m_Cells.empty())
+	{
+		Iblt iblt;
+		iblt.Reset(static_cast<uint32_t>(msg.m_Cells.size()), rs.m_Salt);
+
+		for (const auto& key : rs.m_setPending)
+			iblt.Add(key);
+
+		iblt.Subtract(msg.m_Cells);
+		msgOut.m_Decoded = iblt.Decode(vMy, vPeer);
+
+		if (msgOut.m_Decoded)
+		{
+			// peer set size: common items + those that only the peer has
+			uint64_t nMy = rs.m_setPending.size();
+			uint64_t nPeer = nMy - std::min<uint64_t>(nMy, vMy.size()) + vPeer.size();
+			uint16_t q = proto::Reconcile::get_DiffRatio(nMy, nPeer, vMy.size() + vPeer.size());
+
+			rs.m_DiffRatio = static_cast<uint16_t>((rs.m_DiffRatio + q + 1) / 2); // smooth
+		}
+		else
+			rs.m_DiffRatio = std::min<uint16_t>(rs.m_DiffRatio * 2 + 1, proto::Reconcile::s_DiffRatioMax);
+	}
+
+	Send(msgOut);
+
+	std::set<ECC::Hash::Value> s;
+	s.swap(rs.m_setPending);
+
+	if (msgOut.m_Decoded)
+	{
+		for (const auto& key : vMy)
+			if (s.count(key))
+				SendHave(msg.m_Type, key);
+
+		for (const auto& key : vPeer)
+			OnPeerHave(msg.m_Type, key);
+	}
+	else
+	{
+		for (const auto& key : s)
+			SendHave(msg.m_Type, key);
+	}
+}
+
+void Node::Peer::OnMsg(proto::ReconcileDone&& msg)
+{
+	if ((msg.m_Type >= proto::Reconcile::s_Types) || !(Flags::Accepted & m_Flags))
+		ThrowUnexpected();
+
+	ReconcileState& rs = m_pReconcile[msg.m_Type];
+	if (!rs.m_bRound)
+		ThrowUnexpected();
+
+	rs.m_bRound = false;
+
+	if (!msg.m_Decoded)
+	{
+		// fall back to flooding
+		for (const auto& key : rs.m_vSketched)
+			if (IsReconcileRelevant(msg.m_Type, key))
+				SendHave(msg.m_Type, key);
+	}
+
+	rs.m_vSketched.clear();
+}
+
 void Node::Peer::MaybeSendSerif()
 {
     if (!(Flags::Viewer & m_Flags) || (Flags::SerifSent & m_Flags))
@@ -3442,6 +3945,8 @@ void Node::Peer::MaybeSendDependent()
 
 void Node::Peer::OnMsg(proto::HaveTransaction&& msg)
 {
+    m_pReconcile[proto::Reconcile::Tx].m_setPending.erase(msg.m_ID); // no need to announce it back
+
     TxPool::Fluff::Element::Tx key;
     key.m_Key = msg.m_ID;
 
@@ -3462,6 +3967,18 @@ void Node::Peer::OnMsg(proto::HaveTransaction&& msg)
     if (m_This.m_TxReject.end() != m_This.m_TxReject.find(msg.m_ID))
         return;
 
+    if (m_This.m_TxDeferred.m_lst.size() >= m_This.m_Cfg.m_TxAdmission.m_BackPressure)
+    {
+        // congested. Don't request it now. It won't be announced again (neither flooded, nor reconciled), hence request it later.
+        // Beyond the limit it's lost, same as if the deferred queue overflows
+        if (m_setTxPostponed.size() < m_This.m_Cfg.m_TxAdmission.m_PostponedMax)
+        {
+            m_setTxPostponed.insert(msg.m_ID);
+            m_This.m_TxDeferred.m_bPostponed = true;
+        }
+        return;
+    }
+
     if (!m_This.m_Wtx.Add(key.m_Key))
         return; // already waiting for it
 
@@ -3470,8 +3987,23 @@ void Node::Peer::OnMsg(proto::HaveTransaction&& msg)
     Send(msgOut);
 }
 
+void Node::Peer::RequestPostponedTxs(uint32_t& nMax)
+{
+    while (nMax && !m_setTxPostponed.empty())
+    {
+        proto::HaveTransaction msg;
+        msg.m_ID = *m_setTxPostponed.begin();
+        m_setTxPostponed.erase(m_setTxPostponed.begin());
+        nMax--;
+
+        OnMsg(std::move(msg)); // re-check, it may have arrived meanwhile
+    }
+}
+
 void Node::Peer::OnMsg(proto::GetTransaction&& msg)
 {
+    m_pReconcile[proto::Reconcile::Tx].m_setPending.erase(msg.m_ID);
+
     TxPool::Fluff::Element::Tx key;
     key.m_Key = msg.m_ID;
 
@@ -3584,6 +4116,9 @@ void Node::Peer::OnMsg(proto::GetProofKernel&& msg)
 
 void Node::Peer::OnMsg(proto::GetProofKernel2&& msg)
 {
+    if (m_This.m_Cfg.m_Observer)
+        m_This.m_Cfg.m_Observer->OnPeerRequest(proto::GetProofKernel2::s_Code);
+
     proto::ProofKernel2 msgOut;
 
 	Processor& p = m_This.m_Processor;
@@ -3594,6 +4129,9 @@ void Node::Peer::OnMsg(proto::GetProofKernel2&& msg)
 
 void Node::Peer::OnMsg(proto::GetProofUtxo&& msg)
 {
+    if (m_This.m_Cfg.m_Observer)
+        m_This.m_Cfg.m_Observer->OnPeerRequest(proto::GetProofUtxo::s_Code);
+
     struct Traveler :public UtxoTree::ITraveler
     {
         proto::ProofUtxo m_Msg;
@@ -3728,6 +4266,9 @@ void Node::Peer::OnMsg(proto::GetProofShieldedInp&& msg)
 
 void Node::Peer::OnMsg(proto::GetProofAsset&& msg)
 {
+    if (m_This.m_Cfg.m_Observer)
+        m_This.m_Cfg.m_Observer->OnPeerRequest(proto::GetProofAsset::s_Code);
+
     proto::ProofAsset msgOut;
     msgOut.m_Info.m_Deposit = Rules::get().CA.DepositForList2; // for backward compatibility, if asset not found - older deserialization should work
 
@@ -3765,6 +4306,9 @@ void Node::Peer::OnMsg(proto::GetProofAsset&& msg)
 
 void Node::Peer::OnMsg(proto::GetShieldedList&& msg)
 {
+	if (m_This.m_Cfg.m_Observer)
+		m_This.m_Cfg.m_Observer->OnPeerRequest(proto::GetShieldedList::s_Code);
+
 	proto::ShieldedList msgOut;
 
 	Processor& p = m_This.m_Processor;
@@ -3908,10 +4452,6 @@ void Node::Peer::OnMsg(proto::BbsMsg&& msg)
 	m_This.m_Bbs.m_Totals.m_Size += wlk.m_Data.m_Message.n;
 
     // 1. Send to other BBS-es
-
-    proto::BbsHaveMsg msgOut;
-    msgOut.m_Key = wlk.m_Data.m_Key;
-
     for (PeerList::iterator it = m_This.m_lstPeers.begin(); m_This.m_lstPeers.end() != it; ++it)
     {
         Peer& peer = *it;
@@ -3921,7 +4461,7 @@ void Node::Peer::OnMsg(proto::BbsMsg&& msg)
         if (!(peer.m_LoginFlags & proto::LoginFlags::Bbs) || peer.IsChocking())
             continue;
 
-        peer.Send(msgOut);
+        peer.Announce(proto::Reconcile::Bbs, wlk.m_Data.m_Key);
     }
 
     // 2. Send to subscribed
@@ -3950,6 +4490,8 @@ void Node::Peer::OnMsg(proto::BbsHaveMsg&& msg)
     if (!m_This.m_Cfg.m_Bbs.IsEnabled())
 		ThrowUnexpected();
 
+    m_pReconcile[proto::Reconcile::Bbs].m_setPending.erase(msg.m_Key); // no need to announce it back
+
     NodeDB& db = m_This.m_Processor.get_DB();
 	if (db.BbsFind(msg.m_Key)) {
 		// stupid compiler insists on parentheses here!
@@ -3971,6 +4513,8 @@ void Node::Peer::OnMsg(proto::BbsGetMsg&& msg)
 	if (!m_This.m_Cfg.m_Bbs.IsEnabled())
 		ThrowUnexpected();
 
+	m_pReconcile[proto::Reconcile::Bbs].m_setPending.erase(msg.m_Key);
+
 	NodeDB& db = m_This.m_Processor.get_DB();
     NodeDB::WalkerBbs wlk;
 
@@ -4051,6 +4595,41 @@ void Node::Peer::OnMsg(proto::BbsResetSync&& msg)
 	BroadcastBbs();
 }
 
+bool Node::get_Events(ByteBuffer& buf, const NodeProcessor::Account& acc, Height hMin)
+{
+	NodeDB& db = m_Processor.get_DB();
+	NodeDB::WalkerEvent wlk;
+
+	Height hLast = 0;
+	uint32_t nCount = 0;
+	bool bComplete = true;
+
+	Serializer ser;
+
+	for (db.EnumEvents(wlk, acc.m_iAccount, hMin); wlk.MoveNext(); hLast = wlk.m_Pos.m_Height)
+	{
+		if ((nCount >= proto::Event::s_Max) && (wlk.m_Pos.m_Height != hLast))
+		{
+			bComplete = false;
+			break;
+		}
+
+		if (m_Processor.IsFastSync() && (wlk.m_Pos.m_Height > m_Processor.m_SyncData.m_h0))
+		{
+			bComplete = false;
+			break;
+		}
+
+		ser & wlk.m_Pos.m_Height;
+		ser.WriteRaw(wlk.m_Body.p, wlk.m_Body.n);
+
+		nCount++;
+	}
+
+	ser.swap_buf(buf);
+	return bComplete;
+}
+
 void Node::Peer::OnMsg(proto::GetEvents&& msg)
 {
     proto::Events msgOut;
@@ -4058,35 +4637,59 @@ void Node::Peer::OnMsg(proto::GetEvents&& msg)
     if (Flags::Viewer & m_Flags)
     {
         assert(m_pAccount);
-		Processor& p = m_This.m_Processor;
-		NodeDB& db = p.get_DB();
-        NodeDB::WalkerEvent wlk;
+        bool bComplete = m_This.get_Events(msgOut.m_Events, *m_pAccount, msg.m_HeightMin);
 
-        Height hLast = 0;
-        uint32_t nCount = 0;
+        // once the peer has all the events up to the current tip - further events can be pushed to it
+        m_hEventsPush = (bComplete && (proto::LoginFlags::WantEventsPush & m_LoginFlags)) ?
+            std::max(msg.m_HeightMin, m_This.m_Processor.m_Cursor.m_Sid.m_Height + 1) :
+            0;
+    }
+    else
+        BEAM_LOG_WARNING() << "Peer " << m_RemoteAddr << " Unauthorized Utxo events request.";
 
-        Serializer ser, serCvt;
+    Send(msgOut);
+}
 
-        for (db.EnumEvents(wlk, m_pAccount->m_iAccount, msg.m_HeightMin); wlk.MoveNext(); hLast = wlk.m_Pos.m_Height)
-        {
-            if ((nCount >= proto::Event::s_Max) && (wlk.m_Pos.m_Height != hLast))
-                break;
+void Node::PushEvents()
+{
+    // Many peers (wallets) usually share the same account and cursor, the events are enumerated once for them
+    std::map<std::pair<const NodeProcessor::Account*, Height>, proto::EventsPush> cache;
 
-			if (p.IsFastSync() && (wlk.m_Pos.m_Height > p.m_SyncData.m_h0))
-				break;
+    for (PeerList::iterator it = m_lstPeers.begin(); m_lstPeers.end() != it; ++it)
+        it->MaybePushEvents(cache);
+}
 
-            ser & wlk.m_Pos.m_Height;
-            ser.WriteRaw(wlk.m_Body.p, wlk.m_Body.n);
+void Node::Peer::MaybePushEvents(std::map<std::pair<const NodeProcessor::Account*, Height>, proto::EventsPush>& cache)
+{
+    if (!m_hEventsPush)
+        return;
+    assert((Flags::Viewer & m_Flags) && m_pAccount);
 
-            nCount++;   
-		}
+    Height hTip = m_This.m_Processor.m_Cursor.m_Sid.m_Height;
+    if (m_hEventsPush > hTip)
+        return; // no new blocks
 
-        ser.swap_buf(msgOut.m_Events);
+    auto key = std::make_pair(m_pAccount, m_hEventsPush);
+    auto it = cache.find(key);
+    if (cache.end() == it)
+    {
+        it = cache.emplace(key, proto::EventsPush()).first;
+        proto::EventsPush& msg = it->second;
+
+        msg.m_HeightMin = m_hEventsPush;
+        msg.m_HeightMax = hTip;
+        if (!m_This.get_Events(msg.m_Events, *m_pAccount, m_hEventsPush))
+            msg.m_HeightMax = 0; // too many, the peer should request them explicitly
     }
-    else
-        BEAM_LOG_WARNING() << "Peer " << m_RemoteAddr << " Unauthorized Utxo events request.";
 
-    Send(msgOut);
+    const proto::EventsPush& msg = it->second;
+    if (msg.m_HeightMax)
+    {
+        Send(msg);
+        m_hEventsPush = hTip + 1;
+    }
+    else
+        m_hEventsPush = 0;
 }
 
 void Node::Peer::OnMsg(proto::BlockFinalization&& msg)
@@ -4244,6 +4847,9 @@ void Node::Peer::OnMsg(proto::GetAssetsListAt&& msg)
 
 void Node::Peer::OnMsg(proto::ContractVarsEnum&& msg)
 {
+    if (m_This.m_Cfg.m_Observer)
+        m_This.m_Cfg.m_Observer->OnPeerRequest(proto::ContractVarsEnum::s_Code);
+
     struct Wrk
         :public NodeProcessor::IWorker
     {
@@ -4460,6 +5066,7 @@ void Node::Miner::Initialize(IExternalPOW* externalPOW)
             PerThread &pt = m_vThreads[i];
             pt.m_pReactor = io::Reactor::create();
             pt.m_pEvt = io::AsyncEvent::create(*pt.m_pReactor, [this, i]() { OnRefresh(i); });
+            pt.m_pIdleTimer = io::Timer::create(*pt.m_pReactor);
             pt.m_Thread = std::thread(&Miner::RunMinerThread, this, pt.m_pReactor, Rules::get());
         }
     }
@@ -4494,6 +5101,17 @@ void Node::Miner::OnFinalizerChanged(Peer* p)
 }
 
 void Node::Miner::OnRefresh(uint32_t iIdx)
+{
+    PerThread& pt = m_vThreads[iIdx];
+    pt.m_pIdleTimer->cancel();
+
+    OnRefreshInternal(iIdx);
+
+    // no task for now. If it stays so - free the solver tables (GBs for BeamHash III), they're re-allocated on the next task
+    pt.m_pIdleTimer->start(get_ParentObj().m_Cfg.m_Timeout.m_MiningIdle_ms, false, []() { Block::PoW::ReleaseSolver(); });
+}
+
+void Node::Miner::OnRefreshInternal(uint32_t iIdx)
 {
     while (true)
     {
@@ -4620,6 +5238,27 @@ void Node::Miner::HardAbortSafe()
 	}
 }
 
+void Node::Miner::OnTxFluffed(const TxPool::Profit& x)
+{
+    // The template is regenerated from scratch, which is expensive. Skip it if the tx won't make it into the block anyway,
+    // or if the fees won't grow enough to push a new job to the miners.
+    if (m_bSlackValid && (m_hSlack == get_ParentObj().m_Processor.m_Cursor.m_ID.m_Height + 1))
+    {
+        if (!m_Slack.IsAffectedBy(x))
+            return;
+
+        // The fees of the new template can grow roughly by the fees of the new txs. Don't regenerate until it may reach the mining threshold
+        Amount fees = m_FeesPending + x.m_Stats.m_Fee;
+        m_FeesPending = (fees < m_FeesPending) ? static_cast<Amount>(-1) : fees;
+
+        fees = m_FeesSlack + m_FeesPending;
+        if ((fees >= m_FeesSlack) && (fees < m_FeesTrg))
+            return;
+    }
+
+    SoftRestart();
+}
+
 void Node::Miner::SoftRestart()
 {
     if (!IsEnabled() || m_pTaskToFinalize)
@@ -4693,6 +5332,7 @@ bool Node::Miner::Restart()
         bc.m_Mode = NodeProcessor::BlockContext::Mode::Assemble;
 
     bool bRes = get_ParentObj().m_Processor.GenerateNewBlock(bc);
+    m_bSlackValid = bRes;
 
     if (!bRes)
     {
@@ -4700,6 +5340,11 @@ bool Node::Miner::Restart()
         return false;
     }
 
+    m_Slack = bc.m_Slack;
+    m_hSlack = bc.m_Hdr.m_Height;
+    m_FeesSlack = bc.m_Fees;
+    m_FeesPending = 0;
+
     if (!IsShouldMine(bc))
         return false;
 
@@ -4732,7 +5377,7 @@ bool Node::Miner::IsShouldMine(const NodeProcessor::GeneratedBlock& bc)
     if (bc.m_Fees >= m_FeesTrg)
         return true;
 
-    BEAM_LOG_INFO() << "Block generation no change";
+    BEAM_LOG_INFO() << "Block generation no change, Fee=" << bc.m_Fees << ", Required=" << m_FeesTrg;
     return false;
 }
 
@@ -4746,7 +5391,12 @@ void Node::Miner::StartMining(Task::Ptr&& pTask)
 
     BEAM_LOG_INFO() << "Block generated: Height=" << x.m_Hdr.m_Height << ", Fee=" << x.m_Fees << ", Difficulty=" << x.m_Hdr.m_PoW.m_Difficulty << ", Size=" << (x.m_BodyP.size() + x.m_BodyE.size());
 
-    m_FeesTrg = x.m_Fees + 1;
+    // Each new template restarts the internal miners and makes the external ones switch the job.
+    // Switch to the next one (for the same tip) only if the fees raise is significant
+    Amount feesDelta = std::max<Amount>(get_ParentObj().m_Cfg.m_MiningFeeThreshold, 1);
+    m_FeesTrg = x.m_Fees + feesDelta;
+    if (m_FeesTrg < x.m_Fees)
+        m_FeesTrg = static_cast<Amount>(-1); // overflow
 
     pTask->m_hvNonceSeed = get_ParentObj().NextNonce();
 
@@ -4807,6 +5457,7 @@ IExternalPOW::BlockFoundResult Node::Miner::OnMinedExternal()
 
 	assert(m_External.m_pSolver);
 	m_External.m_pSolver->get_last_found_block(jobID_, h, POW);
+	bool bVerified = m_External.m_pSolver->is_last_found_block_verified();
 
 	char* szEnd = nullptr;
 	uint64_t jobID = strtoul(jobID_.c_str(), &szEnd, 10);
@@ -4834,7 +5485,8 @@ IExternalPOW::BlockFoundResult Node::Miner::OnMinedExternal()
 	pTask->m_Hdr.m_PoW.m_Nonce = POW.m_Nonce;
 	pTask->m_Hdr.m_PoW.m_Indices = POW.m_Indices;
 
-    if (!pTask->m_Hdr.IsValidPoW())
+	// the stratum server verifies the shares off the reactor thread, against the same job input
+    if (!bVerified && !pTask->m_Hdr.IsValidPoW())
     {
         BEAM_LOG_INFO() << "invalid solution from external miner";
         return IExternalPOW::solution_rejected;
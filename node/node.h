@@ -47,6 +47,9 @@ struct Node
 		};
 
 		virtual void OnSyncError(Error error = Unknown) {}
+
+		// A data/proof request from a peer (i.e. a fly client) is about to be served
+		virtual void OnPeerRequest(uint8_t nMsgCode) {}
 	};
 
 	struct Config
@@ -66,15 +69,23 @@ struct Node
 			uint32_t m_GetTx_ms		= 1000 * 5;
 			uint32_t m_GetBbsMsg_ms	= 1000 * 10;
 			uint32_t m_MiningSoftRestart_ms = 1000;
+			uint32_t m_MiningIdle_ms = 1000 * 60 * 5; // then the miner threads free the solver memory
 			uint32_t m_TopPeersUpd_ms = 1000 * 60 * 10; // once in 10 minutes
 			uint32_t m_PeersUpdate_ms	= 1000; // reconsider every second
 			uint32_t m_PeersDbFlush_ms = 1000 * 60; // 1 minute
 		} m_Timeout;
 
-		uint32_t m_MaxConcurrentBlocksRequest = 18;
 		uint32_t m_MaxPoolTransactions = 100 * 1000;
 		uint32_t m_MaxDeferredTransactions = 100 * 1000;
+
+		struct TxAdmission
+		{
+			uint32_t m_BatchMax = 64; // deferred txs are verified (context-free) in batches, then admitted one-by-one
+			uint32_t m_BackPressure = 1000 * 10; // don't request announced txs while the deferred queue is bigger
+			uint32_t m_PostponedMax = 1000 * 10; // per peer, announced txs to request once the deferred queue drains
+		} m_TxAdmission;
 		uint32_t m_MiningThreads = 0; // by default disabled
+		Amount m_MiningFeeThreshold = 0; // while the tip is unchanged, the miners switch to a new template only if it raises the fees at least by this
 
 		bool m_LogEvents = false; // may be insecure. Off by default.
 		bool m_LogTxStem = true;
@@ -117,6 +128,14 @@ struct Node
 
 		} m_Bbs;
 
+		struct Reconciliation
+		{
+			uint32_t m_Period_ms = 1000 * 2; // set to 0 to disable (announcements are always flooded)
+			uint32_t m_MaxPending = 1024 * 4; // per peer and type, if exceeded - further announcements are flooded
+			uint16_t m_FloodProbability = 0x4000; // for the peers we've connected to. Normalized wrt 16 bit. Equals to 0.25. The rest is reconciled
+
+		} m_Reconciliation;
+
 		struct BandwidthCtl
 		{
 			size_t m_Chocking = 1024 * 1024;
@@ -127,6 +146,16 @@ struct Node
 
 		} m_BandwidthCtl;
 
+		struct BodySync
+		{
+			// Missing block bodies are split into windows, each downloaded from a different peer, and processed strictly in order.
+			// The actual request size is adapted to the BandwidthCtl limits, the observed block size, and the peer bandwidth.
+			uint32_t m_WindowSize = 1024; // blocks, should not exceed BandwidthCtl::m_MaxBodyPackCount. Set to 0 to request from a single peer
+			uint32_t m_Windows = 8; // max windows in flight
+			uint32_t m_Stall_ms = 1000 * 5; // the lowest window owner is disconnected if it holds it for longer, while other windows are received
+
+		} m_BodySync;
+
 		struct TestMode {
 			// for testing only!
 			uint32_t m_FakePowSolveTime_ms = 0;
@@ -225,7 +254,7 @@ struct Node
 	bool DecodeAndCheckHdrs(std::vector<Block::SystemState::Full>&, const proto::HdrPack&);
 	static bool DecodeAndCheckHdrsImpl(std::vector<Block::SystemState::Full>&, const proto::HdrPack&, ExecutorMT&);
 
-	uint8_t OnTransaction(Transaction::Ptr&&, std::unique_ptr<Merkle::Hash>&&, const PeerID*, bool bFluff, std::ostream* pExtraInfo);
+	uint8_t OnTransaction(Transaction::Ptr&&, std::unique_ptr<Merkle::Hash>&&, const PeerID*, bool bFluff, std::ostream* pExtraInfo, const NodeProcessor::ContextFreeTx* pCF);
 
 		// for step-by-step tests
 	void GenerateFakeBlocks(uint32_t n);
@@ -250,6 +279,7 @@ private:
 		void OnDummy(const CoinID&, Height) override;
 		void InitializeUtxosProgress(uint64_t done, uint64_t total) override;
 		Height get_MaxAutoRollback() override;
+		void get_BodyWindows(BodyWindows&) override;
 		void OnInvalidBlock(const Block::SystemState::Full&, const Block::Body&) override;
 		void Stop();
 
@@ -314,6 +344,8 @@ private:
 
 	uint32_t m_nTasksPackHdr = 0;
 	uint32_t m_nTasksPackBody = 0;
+	uint32_t m_BodySizeAvg = 0; // observed, used to fit the body requests into the BandwidthCtl limits
+	uint32_t m_TimeBodyDone_ms = 0;
 
 	TaskList m_lstTasksUnassigned;
 	TaskSet m_setTasks;
@@ -324,12 +356,18 @@ private:
 	void TryAssignTask(Task&);
 	bool TryAssignTask(Task&, Peer&);
 	void DeleteUnassignedTask(Task&);
+	uint32_t get_BodyPackCount(const Peer&) const;
+	Task* get_LowestBodyTask();
+	void OnBodyPack(const Task&, size_t nBlocks, size_t nSize);
+	void CheckBodyStall();
 
 	void InitKeys();
 	void InitIDs();
 	void RefreshAccounts();
 	struct AccountRefreshCtx;
 	void MaybeGenerateRecovery();
+	void PushEvents();
+	bool get_Events(ByteBuffer&, const NodeProcessor::Account&, Height hMin); // returns false if truncated
 
 	struct Wanted
 	{
@@ -391,22 +429,40 @@ private:
 		{
 			Transaction::Ptr m_pTx;
 			std::unique_ptr<Merkle::Hash> m_pCtx;
+			Transaction::KeyType m_Key;
 			PeerID m_Sender;
+			uint32_t m_Arrived_ms;
 			bool m_Fluff;
 		};
 
-		std::list<Element> m_lst;
+		typedef std::list<Element> List;
+		List m_lst;
+		std::map<Transaction::KeyType, List::iterator> m_mapKeys; // to drop duplicates before verification
+		bool m_bPostponed = false; // some peers have postponed tx announcements
 
+		struct Stats
+		{
+			uint64_t m_Admitted = 0; // passed to the context-dependent stage
+			uint64_t m_Duplicates = 0; // dropped before verification
+			uint64_t m_Overflow = 0; // dropped due to queue overflow
+			uint64_t m_Batches = 0;
+			uint64_t m_Latency_ms = 0; // total, since arrival until admission
+			uint32_t m_LatencyMax_ms = 0;
+			uint32_t m_DepthMax = 0;
+		} m_Stats;
+
+		void PopFront();
+		void RequestPostponed();
 		virtual void OnSchedule() override;
 
 		IMPLEMENT_GET_PARENT_OBJ(Node, m_TxDeferred)
 	} m_TxDeferred;
 
 	void OnTransactionDeferred(Transaction::Ptr&&, std::unique_ptr<Merkle::Hash>&&, const PeerID*, bool bFluff);
-	uint8_t OnTransactionStem(Transaction::Ptr&&, std::ostream* pExtraInfo);
-	uint8_t OnTransactionFluff(Transaction::Ptr&&, std::ostream* pExtraInfo, const PeerID*, const TxPool::Stats*);
+	uint8_t OnTransactionStem(Transaction::Ptr&&, std::ostream* pExtraInfo, const NodeProcessor::ContextFreeTx* pCF);
+	uint8_t OnTransactionFluff(Transaction::Ptr&&, std::ostream* pExtraInfo, const PeerID*, const TxPool::Stats*, const NodeProcessor::ContextFreeTx* pCF);
 	void OnTransactionFluff(TxPool::Fluff::Element&, const PeerID*);
-	uint8_t OnTransactionDependent(Transaction::Ptr&& pTx, const Merkle::Hash& hvCtx, const PeerID* pSender, bool bFluff, std::ostream* pExtraInfo);
+	uint8_t OnTransactionDependent(Transaction::Ptr&& pTx, const Merkle::Hash& hvCtx, const PeerID* pSender, bool bFluff, std::ostream* pExtraInfo, const NodeProcessor::ContextFreeTx* pCF);
 	void OnTransactionAggregated(Transaction::Ptr&&, const TxPool::Stats&);
 	void PerformAggregation(Dandelion::Element&);
 	void AddDummyInputs(Transaction&, TxPool::Stats&);
@@ -416,8 +472,8 @@ private:
 	Height SampleDummySpentHeight();
 	void DeleteOutdated();
 
-	uint8_t ValidateTx(TxPool::Stats&, const Transaction&, const Transaction::KeyType& keyTx, std::ostream* pExtraInfo, bool& bAlreadyRejected); // complete validation
-	uint8_t ValidateTx2(Transaction::Context&, const Transaction&, uint32_t& nBvmCharge, Amount& feeReserve, TxPool::Dependent::Element* pParent, std::ostream* pExtraInfo, Merkle::Hash* pNewCtx);
+	uint8_t ValidateTx(TxPool::Stats&, const Transaction&, const Transaction::KeyType& keyTx, std::ostream* pExtraInfo, bool& bAlreadyRejected, const NodeProcessor::ContextFreeTx* pCF); // complete validation
+	uint8_t ValidateTx2(Transaction::Context&, const Transaction&, uint32_t& nBvmCharge, Amount& feeReserve, TxPool::Dependent::Element* pParent, std::ostream* pExtraInfo, Merkle::Hash* pNewCtx, const NodeProcessor::ContextFreeTx* pCF); // pCF: context-free validation, if already done
 	static bool CalculateFeeReserve(const TxStats&, const HeightRange&, const AmountBig::Type&, uint32_t nBvmCharge, Amount& feeReserve);
 	void LogTx(const Transaction&, uint8_t nStatus, const Transaction::KeyType&);
 	void LogTxStem(const Transaction&, const char* szTxt);
@@ -546,7 +602,22 @@ private:
 		uint64_t m_CursorBbs;
 		TxPool::Fluff::Element::Send* m_pCursorTx;
 
+		struct ReconcileState
+		{
+			std::set<ECC::Hash::Value> m_setPending; // not announced to this peer yet
+			std::vector<ECC::Hash::Value> m_vSketched; // responder: included in the last sketch, awaiting the outcome
+			uint64_t m_Salt = 0;
+			uint16_t m_DiffRatio = proto::Reconcile::s_DiffRatioDef; // initiator: evaluated from the previous rounds
+			bool m_bRound = false;
+		};
+
+		ReconcileState m_pReconcile[proto::Reconcile::s_Types];
+		io::Timer::Ptr m_pTimerReconcile;
+
+		std::set<ECC::Hash::Value> m_setTxPostponed; // announced by this peer while the tx admission was congested
+
 		const NodeProcessor::Account* m_pAccount = nullptr;
+		Height m_hEventsPush = 0; // next height of events to push on new tip. 0 if not subscribed (yet)
 
 		TaskList m_lstTasks;
 		std::set<Task::Key> m_setRejected; // data that shouldn't be requested from this peer. Reset after reconnection or on receiving NewTip
@@ -572,9 +643,20 @@ private:
 		void BroadcastBbs();
 		void BroadcastBbs(Bbs::Subscription&);
 		void MaybeSendSerif();
+		void MaybePushEvents(std::map<std::pair<const NodeProcessor::Account*, Height>, proto::EventsPush>& cache);
 		void MaybeSendDependent();
 		void OnChocking();
 		void SetTxCursor(TxPool::Fluff::Element::Send*);
+		void Announce(uint8_t iType, const ECC::Hash::Value&); // either floods or adds to the reconciliation set
+		void SendHave(uint8_t iType, const ECC::Hash::Value&);
+		void OnPeerHave(uint8_t iType, const ECC::Hash::Value&);
+		void RequestPostponedTxs(uint32_t& nMax);
+		bool IsReconciling(uint8_t iType) const;
+		bool IsReconcileRelevant(uint8_t iType, const ECC::Hash::Value&);
+		void ReconcilePrune(uint8_t iType);
+		void ReconcileFlush(uint8_t iType);
+		void OnLoginReconcile();
+		void OnReconcileTimer();
 		bool GetBlock(proto::BodyBuffers&, const NodeDB::StateID&, const proto::GetBodyPack&, bool bActive);
 
 		bool IsChocking(size_t nExtra = 0);
@@ -645,6 +727,9 @@ private:
 		virtual void OnMsg(proto::BbsGetMsg&&) override;
 		virtual void OnMsg(proto::BbsSubscribe&&) override;
 		virtual void OnMsg(proto::BbsResetSync&&) override;
+		virtual void OnMsg(proto::ReconcileRequest&&) override;
+		virtual void OnMsg(proto::ReconcileSketch&&) override;
+		virtual void OnMsg(proto::ReconcileDone&&) override;
 		virtual void OnMsg(proto::GetEvents&&) override;
 		virtual void OnMsg(proto::BlockFinalization&&) override;
 		virtual void OnMsg(proto::GetStateSummary&&) override;
@@ -711,6 +796,7 @@ private:
 	{
 		io::Reactor::Ptr m_pReactor;
 		io::AsyncEvent::Ptr m_pEvt;
+		io::Timer::Ptr m_pIdleTimer; // used on the miner thread
 		std::thread m_Thread;
 	};
 
@@ -739,7 +825,9 @@ private:
 		void Initialize(IExternalPOW* externalPOW=nullptr);
 
 		void SoftRestart();
+		void OnTxFluffed(const TxPool::Profit&);
 		void OnRefresh(uint32_t iIdx);
+		void OnRefreshInternal(uint32_t iIdx);
 		void OnRefreshExternal();
 		void OnMined();
 		IExternalPOW::BlockFoundResult OnMinedExternal();
@@ -770,6 +858,14 @@ private:
 		bool m_bTimerPending = false;
 		uint32_t m_LastRestart_ms;
 		Amount m_FeesTrg = 0;
+
+		// the state of the most recently generated template
+		NodeProcessor::GeneratedBlock::Slack m_Slack;
+		Height m_hSlack = 0;
+		Amount m_FeesSlack = 0;
+		Amount m_FeesPending = 0; // fees of the txs fluffed since then, that may get into the block
+		bool m_bSlackValid = false;
+
 		void OnTimer();
 		void SetTimer(uint32_t timeout_ms, bool bHard);
 
@@ -796,12 +796,7 @@ void NodeProcessor::EnumCongestions()
 			if (IsFastSync() && !x.IsContained(m_SyncData.m_Target))
 				continue; // ignore irrelevant branches
 
-			NodeDB::StateID sid;
-			sid.m_Height = x.m_Height - (x.m_Rows.size() - 1);
-			sid.m_Row = x.m_Rows.at(x.m_Rows.size() - 1);
-
-			m_DB.get_StateID(sid, id);
-			RequestDataInternal(id, sid.m_Row, true, sidTrg);
+			RequestBodies(x);
 		}
 		else
 		{
@@ -818,6 +813,60 @@ void NodeProcessor::EnumCongestions()
 	}
 }
 
+void NodeProcessor::RequestBodies(CongestionCache::TipCongestion& x)
+{
+	BodyWindows bw;
+	get_BodyWindows(bw);
+
+	NodeDB::StateID sid;
+	sid.m_Height = x.m_Height - (x.m_Rows.size() - 1); // lowest missing
+	sid.m_Row = x.m_Rows.at(x.m_Rows.size() - 1);
+
+	Block::SystemState::ID id;
+
+	if (!bw.m_Size)
+	{
+		NodeDB::StateID sidTrg;
+		sidTrg.m_Height = x.m_Height;
+		sidTrg.m_Row = x.m_Rows.at(0);
+
+		m_DB.get_StateID(sid, id);
+		RequestDataInternal(id, sid.m_Row, true, sidTrg);
+		return;
+	}
+
+	// Don't look beyond the range of m_Count windows from the lowest missing block. If its owner stalls - the sync doesn't run away
+	Height hWndLo = sid.m_Height - (sid.m_Height % bw.m_Size);
+	Height hMax = x.m_Height;
+	if (bw.m_Size * bw.m_Count <= hMax - hWndLo)
+		hMax = hWndLo + bw.m_Size * bw.m_Count - 1;
+
+	while (sid.m_Height <= hMax)
+	{
+		sid.m_Row = x.m_Rows.at(x.m_Height - sid.m_Height);
+
+		if (NodeDB::StateFlags::Functional & m_DB.GetStateFlags(sid.m_Row))
+		{
+			sid.m_Height++; // already received, but not reachable yet
+			continue;
+		}
+
+		NodeDB::StateID sidTrg;
+		sidTrg.m_Height = std::min(sid.m_Height - (sid.m_Height % bw.m_Size) + bw.m_Size - 1, hMax);
+
+		// in fast-sync mode blocks up to the target are requested diluted, don't mix them with the std blocks above
+		if (IsFastSync() && (sid.m_Height <= m_SyncData.m_Target.m_Height))
+			std::setmin(sidTrg.m_Height, m_SyncData.m_Target.m_Height);
+
+		sidTrg.m_Row = x.m_Rows.at(x.m_Height - sidTrg.m_Height);
+
+		m_DB.get_StateID(sid, id);
+		RequestDataInternal(id, sid.m_Row, true, sidTrg);
+
+		sid.m_Height = sidTrg.m_Height + 1;
+	}
+}
+
 const uint64_t* NodeProcessor::get_CachedRows(const NodeDB::StateID& sid, Height nCountExtra)
 {
 	EnumCongestionsInternal();
@@ -1292,6 +1341,7 @@ struct NodeProcessor::MultiblockContext
 
 	MultiblockContext(NodeProcessor& np)
 		:m_This(np)
+		,m_Vc(np.m_VerCache)
 	{
 		m_InProgress.m_Max = m_This.m_Cursor.m_ID.m_Height;
 		m_InProgress.m_Min = m_InProgress.m_Max + 1;
@@ -1329,6 +1379,7 @@ struct NodeProcessor::MultiblockContext
 
 	MultiShieldedContext m_Msc;
 	MultiAssetContext m_Mac;
+	VerifiedCache::Pending m_Vc;
 
 	size_t m_SizePending = 0;
 	bool m_bFail = false;
@@ -1378,6 +1429,25 @@ struct NodeProcessor::MultiblockContext
 			virtual void Exec(uint32_t iVerifier) override;
 		};
 
+		struct SharedTx
+			:public Shared
+		{
+			typedef std::shared_ptr<SharedTx> Ptr;
+
+			TxBase::Context* m_pCtx;
+			const TxBase* m_pTx;
+			TxBase::IReader::Ptr m_pR;
+
+			SharedTx(MultiblockContext& mbc)
+				:Shared(mbc)
+			{
+			}
+
+			virtual ~SharedTx() {} // auto
+
+			virtual void Exec(uint32_t iVerifier) override;
+		};
+
 		Shared::Ptr m_pShared;
 		uint32_t m_iVerifier;
 	};
@@ -1550,6 +1620,7 @@ struct NodeProcessor::MultiblockContext
 
 		pars.m_pAbort = &m_bFail;
 		pars.m_nVerifiers = ex.get_Threads();
+		pars.m_pCache = &m_Vc;
 
 		for (uint32_t i = 0; i < pars.m_nVerifiers; i++)
 		{
@@ -2172,23 +2243,6 @@ bool NodeProcessor::TxoIsNaked(const Blob& v)
 
 }
 
-struct NodeProcessor::KrnFlyMmr
-	:public Merkle::FlyMmr
-{
-	const TxVectors::Eternal& m_Txve;
-
-	KrnFlyMmr(const TxVectors::Eternal& txve)
-		:m_Txve(txve)
-	{
-		m_Count = txve.m_vKernels.size();
-	}
-
-	virtual void LoadElement(Merkle::Hash& hv, uint64_t n) const override {
-		assert(n < m_Count);
-		hv = m_Txve.m_vKernels[n]->m_Internal.m_ID;
-	}
-};
-
 void NodeProcessor::EnsureCursorKernels()
 {
 	if (!m_Cursor.m_bKernels && m_Cursor.m_Sid.m_Row)
@@ -2196,8 +2250,7 @@ void NodeProcessor::EnsureCursorKernels()
 		TxVectors::Eternal txve;
 		ReadKrns(m_Cursor.m_Sid.m_Row, txve);
 
-		KrnFlyMmr fmmr(txve);
-		fmmr.get_Hash(m_Cursor.m_hvKernels);
+		get_KrnMmrHash(m_Cursor.m_hvKernels, txve.m_vKernels);
 		m_Cursor.m_bKernels = true;
 
 	}
@@ -2297,15 +2350,17 @@ void NodeProcessor::ProofBuilderHard::OnProof(Merkle::Hash& hv, bool bNewOnRight
 	m_Proof.back() = hv;
 }
 
-uint64_t NodeProcessor::ProcessKrnMmr(Merkle::Mmr& mmr, std::vector<TxKernel::Ptr>& vKrn, const Merkle::Hash& idKrn, TxKernel::Ptr* ppRes)
+uint64_t NodeProcessor::ProcessKrnMmr(Merkle::FixedMmr& mmr, std::vector<TxKernel::Ptr>& vKrn, const Merkle::Hash& idKrn, TxKernel::Ptr* ppRes)
 {
 	uint64_t iRet = uint64_t (-1);
 
+	std::vector<Merkle::Hash> vIDs(vKrn.size());
+
 	for (size_t i = 0; i < vKrn.size(); i++)
 	{
 		TxKernel::Ptr& p = vKrn[i];
 		const Merkle::Hash& hv = p->m_Internal.m_ID;
-		mmr.Append(hv);
+		vIDs[i] = hv;
 
 		if (hv == idKrn)
 		{
@@ -2315,9 +2370,20 @@ uint64_t NodeProcessor::ProcessKrnMmr(Merkle::Mmr& mmr, std::vector<TxKernel::Pt
 		}
 	}
 
+	mmr.Assign(vIDs.empty() ? nullptr : &vIDs.front(), vIDs.size());
+
 	return iRet;
 }
 
+void NodeProcessor::get_KrnMmrHash(Merkle::Hash& hv, const std::vector<TxKernel::Ptr>& vKrn)
+{
+	std::vector<Merkle::Hash> vIDs(vKrn.size());
+	for (size_t i = 0; i < vKrn.size(); i++)
+		vIDs[i] = vKrn[i]->m_Internal.m_ID;
+
+	Merkle::BulkMmr::get_Hash(hv, vIDs.empty() ? nullptr : &vIDs.front(), vIDs.size());
+}
+
 struct NodeProcessor::ProofBuilder_PrevState
 	:public ProofBuilder
 {
@@ -2367,7 +2433,6 @@ Height NodeProcessor::get_ProofKernel(Merkle::Proof& proof, TxKernel::Ptr* ppRes
 	ReadKrns(sid.m_Row, txve);
 
 	Merkle::FixedMmr mmr;
-	mmr.Resize(txve.m_vKernels.size());
 	auto iTrg = ProcessKrnMmr(mmr, txve.m_vKernels, idKrn, ppRes);
 
 	if (std::numeric_limits<uint64_t>::max() == iTrg)
@@ -2400,7 +2465,7 @@ Height NodeProcessor::get_ProofKernel(Merkle::Proof& proof, TxKernel::Ptr* ppRes
 
 bool NodeProcessor::get_ProofContractLog(Merkle::Proof& proof, const HeightPos& pos)
 {
-	Merkle::FixedMmr lmmr;
+	std::vector<Merkle::Hash> vLogs;
 	uint64_t iTrg = static_cast<uint64_t>(-1);
 
 	{
@@ -2411,19 +2476,17 @@ bool NodeProcessor::get_ProofContractLog(Merkle::Proof& proof, const HeightPos&
 				continue;
 
 			if (pos.m_Pos == wlk.m_Entry.m_Pos.m_Pos)
-				iTrg = lmmr.m_Count; // found!
-
-			Merkle::Hash hv;
-			Block::get_HashContractLog(hv, wlk.m_Entry.m_Key, wlk.m_Entry.m_Val, wlk.m_Entry.m_Pos.m_Pos);
+				iTrg = vLogs.size(); // found!
 
-			lmmr.Resize(lmmr.m_Count + 1);
-			lmmr.Append(hv);
+			Block::get_HashContractLog(vLogs.emplace_back(), wlk.m_Entry.m_Key, wlk.m_Entry.m_Val, wlk.m_Entry.m_Pos.m_Pos);
 		}
 	}
 
-	if (lmmr.m_Count <= iTrg)
+	if (vLogs.size() <= iTrg)
 		return false;
 
+	Merkle::FixedMmr lmmr;
+	lmmr.Assign(&vLogs.front(), vLogs.size());
 	lmmr.get_Proof(proof, iTrg);
 
 	NodeDB::StateID sid;
@@ -2455,8 +2518,7 @@ bool NodeProcessor::get_ProofContractLog(Merkle::Proof& proof, const HeightPos&
 		TxVectors::Eternal txve;
 		ReadKrns(sid.m_Row, txve);
 
-		KrnFlyMmr fmmr(txve);
-		fmmr.get_Hash(pb.m_hvKernels);
+		get_KrnMmrHash(pb.m_hvKernels, txve.m_vKernels);
 	}
 
 	pb.GenerateProof();
@@ -2748,28 +2810,12 @@ std::ostream& operator << (std::ostream& s, const LogSid& sid)
 
 void NodeProcessor::EvaluatorEx::set_Kernels(const TxVectors::Eternal& txe)
 {
-	KrnFlyMmr fmmr(txe);
-	fmmr.get_Hash(m_hvKernels);
+	get_KrnMmrHash(m_hvKernels, txe.m_vKernels);
 }
 
 void NodeProcessor::EvaluatorEx::set_Logs(const std::vector<Merkle::Hash>& v)
 {
-	struct MyMmr
-		:public Merkle::FlyMmr
-	{
-		const Merkle::Hash* m_pArr;
-
-		virtual void LoadElement(Merkle::Hash& hv, uint64_t n) const override {
-			hv = m_pArr[n];
-		}
-
-	} lmmr;
-
-	lmmr.m_Count = v.size();
-	if (lmmr.m_Count)
-		lmmr.m_pArr = &v.front();
-
-	lmmr.get_Hash(m_Comms.m_hvLogs);
+	Merkle::BulkMmr::get_Hash(m_Comms.m_hvLogs, v.empty() ? nullptr : &v.front(), v.size());
 }
 
 struct NodeProcessor::MyRecognizer
@@ -3059,14 +3105,7 @@ bool NodeProcessor::HandleBlock(const NodeDB::StateID& sid, const Block::SystemS
 			m_DB.set_StateInputs(sid.m_Row, &v.front(), v.size());
 
 		// recognize all
-		MyRecognizer rec(*this);
-
-		for (const auto& acc : m_vAccounts)
-		{
-			rec.m_Handler.m_pAccount = &acc;
-			rec.m_Recognizer.m_Pos = sid.m_Height;
-			rec.m_Recognizer.RecognizeBlock(block, bic.m_ShieldedOuts);
-		}
+		RecognizeAccounts(block, sid.m_Height, bic.m_ShieldedOuts);
 
 		Serializer ser;
 		bic.m_Rollback.clear();
@@ -3186,8 +3225,23 @@ void NodeProcessor::Recognizer::RecognizeBlock(const TxVectors::Full& block, uin
 	for (size_t i = 0; i < block.m_vInputs.size(); i++)
 		Recognize(*block.m_vInputs[i]);
 
-	for (size_t i = 0; i < block.m_vOutputs.size(); i++)
-		Recognize(*block.m_vOutputs[i], *acc.m_pOwner);
+	if (m_pPrepared)
+	{
+		assert(m_pPrepared->m_vOutputs.size() == block.m_vOutputs.size());
+		m_pPrepared->m_iShielded = 0;
+
+		for (size_t i = 0; i < block.m_vOutputs.size(); i++)
+		{
+			const auto& x = m_pPrepared->m_vOutputs[i];
+			if (x.m_Recovered)
+				Recognize(*block.m_vOutputs[i], x.m_Cid, x.m_User);
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < block.m_vOutputs.size(); i++)
+			Recognize(*block.m_vOutputs[i], *acc.m_pOwner);
+	}
 
 	if (!acc.m_vSh.empty())
 	{
@@ -3204,6 +3258,47 @@ void NodeProcessor::Recognizer::RecognizeBlock(const TxVectors::Full& block, uin
 			nOuts; // supporess unused var warning in release
 		}
 	}
+
+	assert(!m_pPrepared || (m_pPrepared->m_iShielded == m_pPrepared->m_vShielded.size()));
+	m_pPrepared = nullptr;
+}
+
+void NodeProcessor::Recognizer::Prepared::Prepare(const TxVectors::Full& block, Height h, const Account& acc)
+{
+	m_vOutputs.resize(block.m_vOutputs.size());
+	for (size_t i = 0; i < block.m_vOutputs.size(); i++)
+	{
+		auto& x = m_vOutputs[i];
+		x.m_Recovered = block.m_vOutputs[i]->Recover(h, *acc.m_pOwner, x.m_Cid, &x.m_User);
+	}
+
+	m_vShielded.clear();
+	m_iShielded = 0;
+
+	if (acc.m_vSh.empty())
+		return;
+
+	struct MyWalker
+		:public IKrnWalker
+	{
+		Prepared& m_This;
+		const Account& m_Acc;
+		MyWalker(Prepared& x, const Account& acc) :m_This(x), m_Acc(acc) {}
+
+		bool OnKrn(const TxKernel& krn) override
+		{
+			if (TxKernel::Subtype::ShieldedOutput == krn.get_Subtype())
+			{
+				auto& x = m_This.m_vShielded.emplace_back();
+				x.m_Recovered = RecoverShielded(Cast::Up<TxKernelShieldedOutput>(krn), m_Height, m_Acc, x.m_nIdx, x.m_Pars);
+			}
+			return true;
+		}
+
+	} wlk(*this, acc);
+
+	wlk.m_Height = h;
+	wlk.Process(block.m_vKernels);
 }
 
 void NodeProcessor::Recognizer::Recognize(const Input& x)
@@ -3287,44 +3382,67 @@ void NodeProcessor::Recognizer::Recognize(const TxKernelShieldedOutput& v, uint3
 {
 	TxoID nID = m_Extra.m_ShieldedOutputs++;
 
+	if (m_pPrepared)
+	{
+		assert(m_pPrepared->m_iShielded < m_pPrepared->m_vShielded.size());
+		const auto& x = m_pPrepared->m_vShielded[m_pPrepared->m_iShielded++];
+
+		if (x.m_Recovered)
+			OnShieldedRecovered(nID, x.m_nIdx, x.m_Pars);
+		return;
+	}
+
 	assert(m_Handler.m_pAccount);
-	const auto& acc = *m_Handler.m_pAccount;
 
-	for (Key::Index nIdx = 0; nIdx < acc.m_vSh.size(); nIdx++)
+	Key::Index nIdx;
+	ShieldedTxo::Data::Params pars;
+	if (RecoverShielded(v, m_Pos.m_Height, *m_Handler.m_pAccount, nIdx, pars))
+		OnShieldedRecovered(nID, nIdx, pars);
+}
+
+bool NodeProcessor::Recognizer::RecoverShielded(const TxKernelShieldedOutput& v, Height h, const Account& acc, Key::Index& nIdx, ShieldedTxo::Data::Params& pars)
+{
+	for (nIdx = 0; nIdx < acc.m_vSh.size(); nIdx++)
 	{
 		const ShieldedTxo& txo = v.m_Txo;
 
-		ShieldedTxo::Data::Params pars;
 		if (!pars.m_Ticket.Recover(txo.m_Ticket, acc.m_vSh[nIdx]))
 			continue;
 
 		ECC::Oracle oracle;
 		oracle << v.m_Msg;
 
-		if (!pars.m_Output.Recover(txo, pars.m_Ticket.m_SharedSecret, m_Pos.m_Height, oracle))
-			continue;
+		if (pars.m_Output.Recover(txo, pars.m_Ticket.m_SharedSecret, h, oracle))
+			return true;
+	}
 
-		proto::Event::Shielded evt;
-		evt.m_TxoID = nID;
-		pars.ToID(evt.m_CoinID);
-		evt.m_CoinID.m_Key.m_nIdx = nIdx;
-		evt.m_Flags = proto::Event::Flags::Add;
+	return false;
+}
 
-		EventKey::Shielded key = pars.m_Ticket.m_SpendPk;
-		key.m_Y |= EventKey::s_FlagShielded;
+void NodeProcessor::Recognizer::OnShieldedRecovered(TxoID nID, Key::Index nIdx, const ShieldedTxo::Data::Params& pars)
+{
+	proto::Event::Shielded evt;
+	evt.m_TxoID = nID;
+	pars.ToID(evt.m_CoinID);
+	evt.m_CoinID.m_Key.m_nIdx = nIdx;
+	evt.m_Flags = proto::Event::Flags::Add;
 
-		AddEvent(evt, key);
-		break;
-	}
+	EventKey::Shielded key = pars.m_Ticket.m_SpendPk;
+	key.m_Y |= EventKey::s_FlagShielded;
+
+	AddEvent(evt, key);
 }
 
 void NodeProcessor::Recognizer::Recognize(const Output& x, Key::IPKdf& keyViewer)
 {
 	CoinID cid;
 	Output::User user;
-	if (!x.Recover(m_Pos.m_Height, keyViewer, cid, &user))
-		return;
+	if (x.Recover(m_Pos.m_Height, keyViewer, cid, &user))
+		Recognize(x, cid, user);
+}
 
+void NodeProcessor::Recognizer::Recognize(const Output& x, const CoinID& cid, const Output::User& user)
+{
 	// filter-out dummies
 	if (cid.IsDummy())
 	{
@@ -3517,6 +3635,61 @@ bool NodeProcessor::BlockInterpretCtx::BvmProcessor::IsOwnedVar(const bvm2::Cont
 		!memcmp(cid.m_pData, key.p, cid.nBytes);
 }
 
+void NodeProcessor::RecognizeAccounts(const Block::Body& block, Height h, uint32_t nShieldedOuts)
+{
+	if (m_vAccounts.empty())
+		return;
+
+	// The key recovery for all the accounts is done in a single parallel pass over the block, events are then added sequentially
+	std::vector<Recognizer::Prepared> vPrepared;
+
+	Executor& ex = get_Executor();
+	if ((m_vAccounts.size() > 1) && (ex.get_Threads() > 1))
+	{
+		struct Task
+			:public Executor::TaskSync
+		{
+			const Block::Body& m_Block;
+			Height m_Height;
+			const AccountsVec& m_vAccounts;
+			std::vector<Recognizer::Prepared>& m_vPrepared;
+
+			Task(const Block::Body& block, Height h, const AccountsVec& vAccounts, std::vector<Recognizer::Prepared>& vPrepared)
+				:m_Block(block)
+				,m_Height(h)
+				,m_vAccounts(vAccounts)
+				,m_vPrepared(vPrepared)
+			{
+			}
+
+			void Exec(Executor::Context& ctx) override
+			{
+				uint32_t i0, nCount;
+				ctx.get_Portion(i0, nCount, static_cast<uint32_t>(m_vAccounts.size()));
+
+				for (uint32_t i = i0; i < i0 + nCount; i++)
+					m_vPrepared[i].Prepare(m_Block, m_Height, m_vAccounts[i]);
+			}
+
+		} t(block, h, m_vAccounts, vPrepared);
+
+		vPrepared.resize(m_vAccounts.size());
+		ex.ExecAll(t);
+	}
+
+	MyRecognizer rec(*this);
+
+	for (size_t i = 0; i < m_vAccounts.size(); i++)
+	{
+		rec.m_Handler.m_pAccount = &m_vAccounts[i];
+		rec.m_Recognizer.m_Pos = h;
+		if (!vPrepared.empty())
+			rec.m_Recognizer.m_pPrepared = &vPrepared[i];
+
+		rec.m_Recognizer.RecognizeBlock(block, nShieldedOuts);
+	}
+}
+
 void NodeProcessor::RescanAccounts(uint32_t nRecent)
 {
 	if (!nRecent)
@@ -6453,6 +6626,9 @@ size_t NodeProcessor::GenerateNewBlockInternal(BlockContext& bc, BlockInterpretC
 		// For now - ignore this optimization
 
 		const auto& x = *vDependent[i];
+		if (x.m_BvmCharge > bvm2::Limits::BlockCharge)
+			break; // cumulative, would exceed the block limit anyway
+
 		Amount txFee = x.m_Fee;
 		auto nSize = x.m_Size;
 		if (x.m_pParent)
@@ -6520,6 +6696,9 @@ size_t NodeProcessor::GenerateNewBlockInternal(BlockContext& bc, BlockInterpretC
 		bool bDelete = !x.m_Profit.m_Stats.m_Hr.IsInRange(bic.m_Height);
 		if (!bDelete)
 		{
+			if (x.m_Profit.m_Stats.m_BvmCharge > bic.m_ChargePerBlock)
+				continue; // don't bother executing it, leave it for the next block
+
 			assert(!bic.m_LimitExceeded);
 			if (HandleValidatedTx(tx, bic))
 			{
@@ -6529,6 +6708,9 @@ size_t NodeProcessor::GenerateNewBlockInternal(BlockContext& bc, BlockInterpretC
 				ssc.m_Counter.m_Value = nSizeNext;
 				offset += ECC::Scalar::Native(tx.m_Offset);
 				++nTxNum;
+
+				bc.m_Slack.m_Last.m_Stats = x.m_Profit.m_Stats;
+				bc.m_Slack.m_HasLast = true;
 			}
 			else
 			{
@@ -6548,6 +6730,11 @@ size_t NodeProcessor::GenerateNewBlockInternal(BlockContext& bc, BlockInterpretC
 
 	BEAM_LOG_INFO() << "GenerateNewBlock: size of block = " << ssc.m_Counter.m_Value << "; amount of tx = " << nTxNum;
 
+	bc.m_Slack.m_Size = nSizeMax - ssc.m_Counter.m_Value;
+	if (!bc.m_Fees)
+		bc.m_Slack.m_Size = (bc.m_Slack.m_Size > m_nSizeUtxoComissionUpperLimit) ? (bc.m_Slack.m_Size - m_nSizeUtxoComissionUpperLimit) : 0; // the 1st fee would add the comission output
+	bc.m_Slack.m_BvmCharge = bic.m_ChargePerBlock;
+
 	if (BlockContext::Mode::Assemble != bc.m_Mode)
 	{
 		if (bc.m_Fees)
@@ -6615,6 +6802,17 @@ void NodeProcessor::GenerateNewHdr(BlockContext& bc, BlockInterpretCtx& bic)
 	std::setmax(bc.m_Hdr.m_TimeStamp, tm);
 }
 
+bool NodeProcessor::GeneratedBlock::Slack::IsAffectedBy(const TxPool::Profit& x) const
+{
+	if (m_HasLast && (x < m_Last))
+		return true; // ranks higher, the selection may change
+
+	// would be considered after all the selected txs, when the block is already filled
+	return
+		(x.m_Stats.m_Size <= m_Size) &&
+		(x.m_Stats.m_BvmCharge <= m_BvmCharge);
+}
+
 NodeProcessor::BlockContext::BlockContext(TxPool::Fluff& txp, Key::Index nSubKey, Key::IKdf& coin, Key::IPKdf& tag)
 	:m_TxPool(txp)
 	,m_pParent(nullptr)
@@ -6748,84 +6946,128 @@ void NodeProcessor::MyExecutor::ExecAll(TaskSync& t)
 	t.Exec(m_Ctx);
 }
 
-bool NodeProcessor::ValidateAndSummarize(TxBase::Context& ctx, const TxBase& txb, TxBase::IReader&& r, std::string& sErr)
+void NodeProcessor::MultiblockContext::MyTask::SharedTx::Exec(uint32_t iVerifier)
 {
-	struct MyShared
-		:public MultiblockContext::MyTask::Shared
-	{
-		TxBase::Context* m_pCtx;
-		const TxBase* m_pTx;
-		TxBase::IReader* m_pR;
-
-		MyShared(MultiblockContext& mbc)
-			:MultiblockContext::MyTask::Shared(mbc)
-		{
-		}
+	TxBase::Context ctx;
+	ctx.m_Params = m_pCtx->m_Params;
+	ctx.m_Height = m_pCtx->m_Height;
+	ctx.m_iVerifier = iVerifier;
 
-		virtual ~MyShared() {} // auto
+	TxBase::IReader::Ptr pR;
+	m_pR->Clone(pR);
 
-		virtual void Exec(uint32_t iThread) override
-		{
-			TxBase::Context ctx;
-			ctx.m_Params = m_pCtx->m_Params;
-			ctx.m_Height = m_pCtx->m_Height;
-			ctx.m_iVerifier = iThread;
+	bool bValid = true;
+	std::string sErr;
 
-			TxBase::IReader::Ptr pR;
-			m_pR->Clone(pR);
+	try {
+		ctx.ValidateAndSummarizeStrict(*m_pTx, std::move(*pR));
+	} catch (const std::exception& e) {
+		bValid = false;
+		sErr = e.what();
+	}
 
-			bool bValid = true;
-			std::string sErr;
+	std::unique_lock<std::mutex> scope(m_Mbc.m_Mutex);
 
+	if (!m_Mbc.m_bFail)
+	{
+		if (bValid)
+		{
 			try {
-				ctx.ValidateAndSummarizeStrict(*m_pTx, std::move(*pR));
+				m_pCtx->MergeStrict(ctx);
 			} catch (const std::exception& e) {
 				bValid = false;
 				sErr = e.what();
 			}
+		}
 
-			std::unique_lock<std::mutex> scope(m_Mbc.m_Mutex);
-
-			if (!m_Mbc.m_bFail)
-			{
-				if (bValid)
-				{
-					try {
-						m_pCtx->MergeStrict(ctx);
-					} catch (const std::exception& e) {
-						bValid = false;
-						sErr = e.what();
-					}
-				}
-
-				if (!bValid)
-				{
-					m_Mbc.m_bFail = true;
-					m_Mbc.m_sErr = std::move(sErr);
-				}
-
-			}
+		if (!bValid)
+		{
+			m_Mbc.m_bFail = true;
+			m_Mbc.m_sErr = std::move(sErr);
 		}
-	};
 
+	}
+}
+
+bool NodeProcessor::ValidateAndSummarize(TxBase::Context& ctx, const TxBase& txb, TxBase::IReader&& r, std::string& sErr)
+{
 	MultiblockContext mbc(*this);
 
-	std::shared_ptr<MyShared> pShared = std::make_shared<MyShared>(mbc);
+	auto pShared = std::make_shared<MultiblockContext::MyTask::SharedTx>(mbc);
 
 	pShared->m_pCtx = &ctx;
 	pShared->m_pTx = &txb;
-	pShared->m_pR = &r;
+	r.Clone(pShared->m_pR);
 
+	mbc.m_Vc.m_Collect = true;
 	mbc.m_InProgress.m_Max++; // dummy, just to emulate ongoing progress
 	mbc.PushTasks(pShared, ctx.m_Params);
 
-	if (mbc.Flush())
+	bool bRes = mbc.Flush();
+	ctx.m_Params.m_pCache = nullptr;
+
+	if (bRes)
+	{
+		mbc.m_Vc.Commit();
 		return true;
+	}
 
 	sErr = std::move(mbc.m_sErr);
 	return false;
 }
 
+void NodeProcessor::ValidateAndSummarizeBatch(ContextFreeTx* pTxs, uint32_t nCount)
+{
+	if (nCount > 1)
+	{
+		// All the txs share the same batch context, the expensive multi-exponentiation is performed once.
+		// If the batch fails - there's no way to tell the culprit, fall back to per-tx verification.
+		MultiblockContext mbc(*this);
+		mbc.m_Vc.m_Collect = true;
+
+		for (uint32_t i = 0; i < nCount; i++)
+		{
+			ContextFreeTx& x = pTxs[i];
+			assert(x.m_pTx);
+
+			auto pShared = std::make_shared<MultiblockContext::MyTask::SharedTx>(mbc);
+
+			pShared->m_pCtx = &x.m_Ctx;
+			pShared->m_pTx = x.m_pTx;
+			x.m_pTx->get_Reader().Clone(pShared->m_pR);
+
+			mbc.PushTasks(pShared, x.m_Ctx.m_Params);
+		}
+
+		mbc.m_InProgress.m_Max++; // dummy, just to emulate ongoing progress
+
+		bool bRes = mbc.Flush();
+		for (uint32_t i = 0; i < nCount; i++)
+			pTxs[i].m_Ctx.m_Params.m_pCache = nullptr;
+
+		if (bRes)
+		{
+			mbc.m_Vc.Commit();
+
+			for (uint32_t i = 0; i < nCount; i++)
+				pTxs[i].m_Valid = true;
+			return;
+		}
+	}
+
+	for (uint32_t i = 0; i < nCount; i++)
+	{
+		ContextFreeTx& x = pTxs[i];
+
+		TxBase::Context ctx;
+		ctx.m_Height = x.m_Ctx.m_Height;
+		ctx.m_Params.m_bAllowUnsignedOutputs = x.m_Ctx.m_Params.m_bAllowUnsignedOutputs;
+
+		x.m_Ctx = ctx; // discard partial results of the failed batch
+		x.m_Valid = ValidateAndSummarize(x.m_Ctx, *x.m_pTx, x.m_pTx->get_Reader(), x.m_sErr);
+	}
+}
+
 void NodeProcessor::ExtractBlockWithExtra(const NodeDB::StateID& sid, std::vector<TxoInfo>& vIns, std::vector<TxoInfo>& vOuts, TxVectors::Eternal& txe, std::vector<ContractInvokeExtraInfo>& vC)
 {
 	{
@@ -7543,6 +7785,85 @@ void NodeProcessor::ValidatedCache::MoveInto(ValidatedCache& dst)
 	}
 }
 
+void NodeProcessor::VerifiedCache::ShrinkTo(uint32_t n)
+{
+	while (m_Mru.size() > n)
+		Delete(m_Mru.back().get_ParentObj());
+}
+
+void NodeProcessor::VerifiedCache::Delete(Entry& x)
+{
+	m_Keys.erase(KeySet::s_iterator_to(x.m_Key));
+	m_Mru.erase(MruList::s_iterator_to(x.m_Mru));
+	delete &x;
+}
+
+bool NodeProcessor::VerifiedCache::Find(const KeyType& val, ECC::Point* pSigma)
+{
+	Entry::Key key;
+	key.m_Value = val;
+
+	std::unique_lock<std::mutex> scope(m_Mutex);
+
+	KeySet::iterator it = m_Keys.find(key);
+	if (m_Keys.end() == it)
+		return false;
+
+	Entry& x = it->get_ParentObj();
+	m_Mru.erase(MruList::s_iterator_to(x.m_Mru));
+	m_Mru.push_front(x.m_Mru);
+
+	if (pSigma)
+		*pSigma = x.m_Sigma;
+
+	return true;
+}
+
+bool NodeProcessor::VerifiedCache::Pending::Find(const Key& key, ECC::Point* pSigma)
+{
+	// pending elements are not verified yet, consult the global cache only
+	return m_Cache.Find(key, pSigma);
+}
+
+void NodeProcessor::VerifiedCache::Pending::Insert(const Key& key, const ECC::Point::Native* pSigma)
+{
+	if (!m_Collect)
+		return;
+
+	ECC::Point pt;
+	if (pSigma)
+		pSigma->Export(pt);
+	else
+		pt = Zero;
+
+	std::unique_lock<std::mutex> scope(m_Mutex);
+	m_vNew.emplace_back(key, pt);
+}
+
+void NodeProcessor::VerifiedCache::Pending::Commit()
+{
+	std::unique_lock<std::mutex> scope(m_Cache.m_Mutex);
+
+	for (const auto& v : m_vNew)
+	{
+		Entry::Key key;
+		key.m_Value = v.first;
+
+		if (m_Cache.m_Keys.end() != m_Cache.m_Keys.find(key))
+			continue;
+
+		Entry* pEntry = new Entry;
+		pEntry->m_Key.m_Value = v.first;
+		pEntry->m_Sigma = v.second;
+
+		m_Cache.m_Keys.insert(pEntry->m_Key);
+		m_Cache.m_Mru.push_front(pEntry->m_Mru);
+	}
+
+	m_vNew.clear();
+	m_Cache.ShrinkTo(m_Cache.m_MaxEntries);
+}
+
 /////////////////////////////
 // Mapped
 struct NodeProcessor::Mapped::Type {
@@ -17,6 +17,7 @@
 #include "../core/radixtree.h"
 #include "../core/proto.h"
 #include "../core/treasury.h"
+#include "../core/shielded.h"
 #include "../core/mapped_file.h"
 #include "../utility/dvector.h"
 #include "../utility/executor.h"
@@ -186,9 +187,8 @@ class NodeProcessor
 	BeamKernelsAll(THE_MACRO)
 #undef THE_MACRO
 
-	static uint64_t ProcessKrnMmr(Merkle::Mmr&, std::vector<TxKernel::Ptr>&, const Merkle::Hash& idKrn, TxKernel::Ptr* ppRes);
-
-	struct KrnFlyMmr;
+	static uint64_t ProcessKrnMmr(Merkle::FixedMmr&, std::vector<TxKernel::Ptr>&, const Merkle::Hash& idKrn, TxKernel::Ptr* ppRes);
+	static void get_KrnMmrHash(Merkle::Hash&, const std::vector<TxKernel::Ptr>&);
 
 	static const uint32_t s_TxoNakedMin = sizeof(ECC::Point); // minimal output size - commitment
 	static const uint32_t s_TxoNakedMax = s_TxoNakedMin + 0x10; // In case the output has the Incubation period - extra size is needed (actually less than this).
@@ -235,6 +235,7 @@ class NodeProcessor
 	} m_CongestionCache;
 
 	CongestionCache::TipCongestion* EnumCongestionsInternal();
+	void RequestBodies(CongestionCache::TipCongestion&);
 
 	struct RecentStates
 	{
@@ -558,7 +559,16 @@ public:
 
 	static bool IsRemoteTipNeeded(const Block::SystemState::Full& sTipRemote, const Block::SystemState::Full& sTipMy);
 
+	struct BodyWindows
+	{
+		// Missing bodies are requested in windows aligned to multiples of m_Size, so that different peers can download them concurrently.
+		// The alignment must not change while the windows are in progress, otherwise they'd overlap.
+		Height m_Size = 0; // 0 - single request from the lowest missing block up to the tip
+		uint32_t m_Count = 1; // max windows, blocks above are not requested until the lower ones are received
+	};
+
 	virtual void RequestData(const Block::SystemState::ID&, bool bBlock, const NodeDB::StateID& sidTrg) {}
+	virtual void get_BodyWindows(BodyWindows&) {}
 	virtual void OnPeerInsane(const PeerID&) {}
 	virtual void OnNewState() {}
 	virtual void OnRolledBack() {}
@@ -591,6 +601,17 @@ public:
 
 	bool ValidateAndSummarize(TxBase::Context&, const TxBase&, TxBase::IReader&&, std::string& sErr);
 
+	struct ContextFreeTx
+	{
+		const Transaction* m_pTx;
+		Transaction::Context m_Ctx; // in: height range and params. out: summary
+		bool m_Valid = false;
+		std::string m_sErr;
+	};
+
+	// Verifies several txs at once, distributed among the executor threads, with a single batch verification
+	void ValidateAndSummarizeBatch(ContextFreeTx*, uint32_t nCount);
+
 	struct Account
 		:public NodeDB::WalkerAccount::Data
 	{
@@ -605,6 +626,7 @@ public:
 	AccountsVec m_vAccounts;
 
 	void RescanAccounts(uint32_t nRecent);
+	void RecognizeAccounts(const Block::Body&, Height, uint32_t nShieldedOuts);
 
 	uint64_t FindActiveAtStrict(Height);
 	Height FindVisibleKernel(const Merkle::Hash&, const BlockInterpretCtx&);
@@ -624,6 +646,18 @@ public:
 		ByteBuffer m_BodyE;
 		Amount m_Fees;
 		Block::Body m_Block; // in/out
+
+		struct Slack
+		{
+			// What remains after the txs are selected. A new tx that ranks below m_Last, and doesn't fit, would not change the selection.
+			size_t m_Size = 0;
+			uint32_t m_BvmCharge = 0;
+			TxPool::Profit m_Last; // the lowest-ranked included tx from the pool
+			bool m_HasLast = false;
+
+			bool IsAffectedBy(const TxPool::Profit&) const;
+
+		} m_Slack;
 	};
 
 
@@ -782,10 +816,38 @@ public:
 		IHandler& m_Handler;
 		Extra& m_Extra;
 
+		// Context-free part of the recognition: owner key recovery of the outputs and shielded outputs. This is the heavy part,
+		// it may be done in advance for many blocks in parallel (from any thread). The events are then added by RecognizeBlock in order.
+		struct Prepared
+		{
+			struct Outp
+			{
+				bool m_Recovered = false;
+				CoinID m_Cid;
+				Output::User m_User;
+			};
+
+			struct Shielded
+			{
+				bool m_Recovered = false;
+				Key::Index m_nIdx;
+				ShieldedTxo::Data::Params m_Pars;
+			};
+
+			std::vector<Outp> m_vOutputs; // same order as in the block
+			std::vector<Shielded> m_vShielded; // in the kernel walk order
+			size_t m_iShielded = 0; // consumed by RecognizeBlock
+
+			void Prepare(const TxVectors::Full&, Height, const Account&);
+		};
+
+		Prepared* m_pPrepared = nullptr; // if set - used by the next RecognizeBlock
+
 		void RecognizeBlock(const TxVectors::Full& block, uint32_t shieldedOuts, bool validateShieldedOuts = true);
 
 		void Recognize(const Input&);
 		void Recognize(const Output&, Key::IPKdf&);
+		void Recognize(const Output&, const CoinID&, const Output::User&); // already recovered
 
 #define THE_MACRO(id, name) void Recognize(const TxKernel##name&, uint32_t nKrnIdx);
 		BeamKernelsAll(THE_MACRO)
@@ -804,6 +866,9 @@ public:
 	private:
 		template <typename TEvt>
 		void AddEventInternal(const TEvt&, const Blob& key);
+
+		static bool RecoverShielded(const TxKernelShieldedOutput&, Height, const Account&, Key::Index& nIdx, ShieldedTxo::Data::Params&);
+		void OnShieldedRecovered(TxoID, Key::Index nIdx, const ShieldedTxo::Data::Params&);
 	};
 
 	struct MyRecognizer;
@@ -891,6 +956,67 @@ public:
 
 	} m_ValCache;
 
+	// Elements that passed the context-free verification in the mempool, reused during the block verification
+	struct VerifiedCache
+	{
+		typedef TxBase::Context::IVerifiedCache::Key KeyType;
+
+		struct Entry
+		{
+			struct Key
+				:public boost::intrusive::set_base_hook<>
+			{
+				KeyType m_Value;
+				bool operator < (const Key& x) const { return m_Value < x.m_Value; }
+				IMPLEMENT_GET_PARENT_OBJ(Entry, m_Key)
+			} m_Key;
+
+			struct Mru
+				:public boost::intrusive::list_base_hook<>
+			{
+				IMPLEMENT_GET_PARENT_OBJ(Entry, m_Mru)
+			} m_Mru;
+
+			ECC::Point m_Sigma;
+		};
+
+		typedef boost::intrusive::set<Entry::Key> KeySet;
+		typedef boost::intrusive::list<Entry::Mru> MruList;
+
+		KeySet m_Keys;
+		MruList m_Mru;
+		std::mutex m_Mutex;
+		uint32_t m_MaxEntries = 1024 * 256; // ~30MB
+
+		~VerifiedCache() {
+			ShrinkTo(0);
+		}
+
+		void ShrinkTo(uint32_t);
+		bool Find(const KeyType&, ECC::Point* pSigma); // thread-safe, modifies MRU if found
+
+		// Collects the newly verified elements, they're added to the cache only once the verification is complete (including batch)
+		struct Pending
+			:public TxBase::Context::IVerifiedCache
+		{
+			VerifiedCache& m_Cache;
+			std::mutex m_Mutex;
+			std::vector<std::pair<KeyType, ECC::Point> > m_vNew;
+			bool m_Collect = false;
+
+			Pending(VerifiedCache& vc) :m_Cache(vc) {}
+
+			virtual bool Find(const Key&, ECC::Point* pSigma) override;
+			virtual void Insert(const Key&, const ECC::Point::Native* pSigma) override;
+
+			void Commit();
+		};
+
+	private:
+		void Delete(Entry&);
+
+	} m_VerCache;
+
 	struct IWorker {
 		virtual void Do() = 0;
 	};
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "processor.h"
+#include "../bvm/bvm2.h"
 #include "../utility/logger.h"
 #include "../utility/logger_checkpoints.h"
 
@@ -30,7 +31,7 @@ void TxPool::Stats::SetSize(const Transaction& tx)
 	m_Size = (uint32_t)tx.get_Reader().get_SizeNetto();
 }
 
-void TxPool::Stats::From(const Transaction& tx, const Transaction::Context& ctx, Amount feeReserve, uint32_t nSizeCorrection)
+void TxPool::Stats::From(const Transaction& tx, const Transaction::Context& ctx, Amount feeReserve, uint32_t nBvmCharge)
 {
 	assert(!AmountBig::get_Hi(ctx.m_Stats.m_Fee)); // ignore such txs atm
 	m_Fee = AmountBig::get_Lo(ctx.m_Stats.m_Fee);
@@ -38,7 +39,14 @@ void TxPool::Stats::From(const Transaction& tx, const Transaction::Context& ctx,
 	m_Hr = ctx.m_Height;
 
 	SetSize(tx);
-	m_SizeCorrection = nSizeCorrection;
+	SetBvmCharge(nBvmCharge);
+	m_SizeCorrection = (uint32_t) (((uint64_t) nBvmCharge) * Rules::get().MaxBodySize / bvm2::Limits::BlockCharge);
+}
+
+void TxPool::Stats::SetBvmCharge(uint32_t nBvmCharge)
+{
+	// doesn't affect m_SizeCorrection, since it's used for ordering
+	m_BvmCharge = nBvmCharge;
 }
 
 bool TxPool::Profit::operator < (const Profit& t) const
@@ -226,6 +234,7 @@ bool TxPool::Stem::TryMerge(Element& trg, Element& src)
 	trg.m_Profit.m_Stats.m_Hr = hr;
 	trg.m_Profit.m_Stats.SetSize(txNew);
 	trg.m_Profit.m_Stats.m_SizeCorrection += src.m_Profit.m_Stats.m_SizeCorrection;
+	trg.m_Profit.m_Stats.m_BvmCharge += src.m_Profit.m_Stats.m_BvmCharge;
 
 	trg.m_pValue->m_vInputs.swap(txNew.m_vInputs);
 	trg.m_pValue->m_vOutputs.swap(txNew.m_vOutputs);
@@ -364,7 +373,7 @@ TxPool::Stem::Element* TxPool::Stem::get_NextTimeout(uint32_t& nTimeout_ms)
 
 /////////////////////////////
 // Dependent
-TxPool::Dependent::Element* TxPool::Dependent::AddValidTx(Transaction::Ptr&& pValue, const Transaction::Context& ctx, const Transaction::KeyType& key, const Merkle::Hash& hvContext, Element* pParent)
+TxPool::Dependent::Element* TxPool::Dependent::AddValidTx(Transaction::Ptr&& pValue, const Transaction::Context& ctx, const Transaction::KeyType& key, const Merkle::Hash& hvContext, uint32_t nBvmCharge, Element* pParent)
 {
 	assert(pValue);
 
@@ -379,10 +388,12 @@ TxPool::Dependent::Element* TxPool::Dependent::AddValidTx(Transaction::Ptr&& pVa
 	m_setTxs.insert(p->m_Tx);
 
 	p->m_Size = (uint32_t) p->m_pValue->get_Reader().get_SizeNetto();
+	p->m_BvmCharge = nBvmCharge;
 	p->m_Depth = 1;
 	if (pParent)
 	{
 		p->m_Size += pParent->m_Size;
+		p->m_BvmCharge += pParent->m_BvmCharge;
 		p->m_Depth += pParent->m_Depth;
 	}
 
@@ -27,13 +27,18 @@ struct TxPool
 		Amount m_Fee;
 		Amount m_FeeReserve;
 		uint32_t m_Size;
-		uint32_t m_SizeCorrection;
+		uint32_t m_SizeCorrection; // bvm charge, converted to the equivalent size
+		uint32_t m_BvmCharge; // as evaluated during the most recent validation
 		HeightRange m_Hr;
 
-		void From(const Transaction&, const Transaction::Context&, Amount feeReserve, uint32_t nSizeCorrection);
+		void From(const Transaction&, const Transaction::Context&, Amount feeReserve, uint32_t nBvmCharge);
+		void SetBvmCharge(uint32_t);
 		void SetSize(const Transaction&);
 	};
 
+	// Ranks the individual txs by the fee per size (incl. the bvm charge correction).
+	// There are no ancestor-package rates: the fluffed txs don't spend each other's outputs, the chained ones are in Dependent,
+	// where the chain with the highest cumulative fee is selected as a whole.
 	struct Profit
 		:public boost::intrusive::set_base_hook<>
 	{
@@ -212,7 +217,7 @@ struct TxPool
 
 		Element* m_pBest;
 
-		Element* AddValidTx(Transaction::Ptr&&, const Transaction::Context&, const Transaction::KeyType& key, const Merkle::Hash&, Element* pParent);
+		Element* AddValidTx(Transaction::Ptr&&, const Transaction::Context&, const Transaction::KeyType& key, const Merkle::Hash&, uint32_t nBvmCharge, Element* pParent);
 		void Clear();
 
 		Dependent() :m_pBest(nullptr) {}
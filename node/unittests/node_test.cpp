@@ -21,6 +21,7 @@
 #include "../../core/serialization_adapters.h"
 #include "../../core/treasury.h"
 #include "../../core/block_rw.h"
+#include "../../core/iblt.h"
 #include "../../utility/test_helpers.h"
 #include "../../utility/serialize.h"
 #include "../../utility/blobmap.h"
@@ -3288,7 +3289,23 @@ namespace beam
 		io::Reactor::Ptr pReactor(io::Reactor::create());
 		io::Reactor::Scope scope(*pReactor);
 
+		struct MyObserver
+			:public Node::IObserver
+		{
+			uint32_t m_ShieldedListRequests = 0;
+
+			virtual void OnSyncProgress() override {}
+
+			virtual void OnPeerRequest(uint8_t nMsgCode) override
+			{
+				if (proto::GetShieldedList::s_Code == nMsgCode)
+					m_ShieldedListRequests++;
+			}
+
+		} obs;
+
 		Node node;
+		node.m_Cfg.m_Observer = &obs;
 		node.m_Cfg.m_sPathLocal = g_sz;
 		node.m_Cfg.m_Listen.port(g_Port);
 		node.m_Cfg.m_Listen.ip(INADDR_ANY);
@@ -3313,8 +3330,10 @@ namespace beam
 			BbsChannel m_LastBbsChannel = 0;
 			bool m_bBbsReceived;
 			Block::SystemState::HistoryMap m_Hist;
+			const MyObserver& m_Obs;
 
-			MyFlyClient()
+			MyFlyClient(const MyObserver& obs)
+				:m_Obs(obs)
 			{
 				m_pTimer = io::Timer::create(io::Reactor::get_Current());
 			}
@@ -3413,6 +3432,19 @@ namespace beam
 					m_nProofsExpected++;
 				}
 
+				// identical requests, should be coalesced or answered from the cache
+				uint32_t nShieldedRequests = m_Obs.m_ShieldedListRequests;
+				std::vector<RequestShieldedList::Ptr> vShielded;
+				for (uint32_t i = 0; i < 5; i++)
+				{
+					RequestShieldedList::Ptr pReq(new RequestShieldedList);
+					pReq->m_Msg.m_Id0 = 0;
+					pReq->m_Msg.m_Count = 100;
+					net.PostRequest(*pReq, *this);
+					m_nProofsExpected++;
+					vShielded.push_back(std::move(pReq));
+				}
+
 				net.BbsSubscribe(m_LastBbsChannel, 0, this);
 
 				RequestEnumHdrs::Ptr pHdrs(new RequestEnumHdrs);
@@ -3435,6 +3467,34 @@ namespace beam
 				KillTimer();
 
 				verify_test(!pHdrs->m_vStates.empty());
+
+				for (const auto& pReq : vShielded)
+				{
+					verify_test(pReq->m_Res.m_State1 == vShielded.front()->m_Res.m_State1);
+					verify_test(pReq->m_Res.m_Items.size() == vShielded.front()->m_Res.m_Items.size());
+				}
+
+				// only one of them reached the node
+				verify_test(m_Obs.m_ShieldedListRequests == nShieldedRequests + 1);
+
+				// repeated after completion, should be served from the cache
+				RequestShieldedList::Ptr pReq(new RequestShieldedList);
+				pReq->m_Msg = vShielded.front()->m_Msg;
+				m_nProofsExpected++;
+				net.PostRequest(*pReq, *this);
+
+				if (m_nProofsExpected)
+				{
+					SetTimer(90 * 1000);
+					m_bRunning = true;
+					io::Reactor::get_Current().run();
+					KillTimer();
+				}
+
+				verify_test(!m_nProofsExpected);
+				verify_test(m_Obs.m_ShieldedListRequests == nShieldedRequests + 1);
+				verify_test(pReq->m_Res.m_State1 == vShielded.front()->m_Res.m_State1);
+				verify_test(pReq->m_Res.m_Items.size() == vShielded.front()->m_Res.m_Items.size());
 			}
 		};
 
@@ -3442,7 +3502,7 @@ namespace beam
 		RaiseHeightTo(node, hThrd1);
 
 
-		MyFlyClient fc;
+		MyFlyClient fc(obs);
 		// simple case
 		fc.SyncSync();
 
@@ -3486,6 +3546,58 @@ namespace beam
 		verify_test(!fc.m_Hist.m_Map.empty() && fc.m_Hist.m_Map.rbegin()->second.m_Height == hThrd2);
 	}
 
+	void TestIblt()
+	{
+		std::vector<Iblt::Key> vA, vB;
+		for (uint32_t i = 0; i < 50; i++)
+			ECC::GenRandom(vA.emplace_back());
+		for (uint32_t i = 0; i < 30; i++)
+			ECC::GenRandom(vB.emplace_back());
+
+		Iblt ibltA, ibltB;
+		uint32_t nCells = Iblt::get_CellsFor(static_cast<uint32_t>(vA.size() + vB.size()));
+		ibltA.Reset(nCells, 17);
+		ibltB.Reset(nCells, 17);
+
+		for (uint32_t i = 0; i < 100; i++)
+		{
+			Iblt::Key key;
+			ECC::GenRandom(key); // common
+			ibltA.Add(key);
+			ibltB.Add(key);
+		}
+
+		for (const auto& key : vA)
+			ibltA.Add(key);
+		for (const auto& key : vB)
+			ibltB.Add(key);
+
+		verify_test(ibltA.Subtract(ibltB.m_vCells));
+
+		std::vector<Iblt::Key> vPos, vNeg;
+		verify_test(ibltA.Decode(vPos, vNeg));
+
+		std::sort(vA.begin(), vA.end());
+		std::sort(vB.begin(), vB.end());
+		std::sort(vPos.begin(), vPos.end());
+		std::sort(vNeg.begin(), vNeg.end());
+		verify_test((vPos == vA) && (vNeg == vB));
+
+		// crafted table: the key is present in its 1st cell only. Once it's peeled, its other cells become pure with
+		// the opposite sign, peeling them restores the 1st one, and so on. Must be rejected, not loop forever
+		Iblt iblt;
+		iblt.Reset(nCells, 17);
+		iblt.Add(vA.front());
+
+		for (uint32_t i = nCells / Iblt::s_Hashes; i < nCells; i++)
+			iblt.m_vCells[i].Reset();
+
+		vPos.clear();
+		vNeg.clear();
+		verify_test(!iblt.Decode(vPos, vNeg));
+		verify_test(vPos.size() + vNeg.size() <= nCells);
+	}
+
 	void TestHalving()
 	{
 		HeightRange hr;
@@ -3860,6 +3972,81 @@ namespace beam
 		}
 	}
 
+	void RunReactorFor(uint32_t timeout_ms)
+	{
+		io::Timer::Ptr pTimer = io::Timer::create(io::Reactor::get_Current());
+		pTimer->start(timeout_ms, false, []() { io::Reactor::get_Current().stop(); });
+		io::Reactor::get_Current().run();
+	}
+
+	void TestMiningFeeThreshold()
+	{
+		io::Reactor::Ptr pReactor(io::Reactor::create());
+		io::Reactor::Scope scope(*pReactor);
+
+		// counts the jobs pushed to the miners
+		struct MyExternalPOW
+			:public IExternalPOW
+		{
+			uint32_t m_Jobs = 0;
+
+			void new_job(const std::string&, const Merkle::Hash&, const Block::PoW&, const Height&, const BlockFound&, const CancelCallback&) override
+			{
+				m_Jobs++;
+			}
+
+			void get_last_found_block(std::string&, Height&, Block::PoW&) override {}
+			void stop_current() override {}
+			void stop() override {}
+
+		} extPow;
+
+		const Amount fee = 10900000;
+
+		MiniWallet wallet;
+		ECC::SetRandom(wallet.m_pKdf);
+
+		Node node;
+		node.m_Cfg.m_sPathLocal = g_sz;
+		node.m_Cfg.m_MiningThreads = 0;
+		node.m_Cfg.m_Treasury = g_Treasury;
+		node.m_Cfg.m_TestMode.m_FakePowSolveTime_ms = 1000 * 3600; // never solved by the node itself
+		node.m_Cfg.m_Timeout.m_MiningSoftRestart_ms = 0;
+		node.m_Cfg.m_MiningFeeThreshold = fee * 5;
+		node.m_Keys.SetSingleKey(wallet.m_pKdf);
+		node.Initialize(&extPow);
+
+		const Height h0 = 3;
+		RaiseHeightTo(node, h0 + Rules::get().Maturity.Coinbase);
+		for (Height h = 1; h <= h0; h++)
+			wallet.AddMyUtxo(CoinID(Rules::get_Emission(h), h, Key::Type::Coinbase));
+
+		RunReactorFor(200);
+		uint32_t nJobs = extPow.m_Jobs;
+		verify_test(nJobs > 0); // the template for the current tip
+
+		Height h = node.get_Processor().m_Cursor.m_ID.m_Height;
+
+		// below the threshold: neither regenerated nor pushed
+		Transaction::Ptr pTx;
+		Amount val = wallet.MakeTxInput(pTx, h);
+		verify_test(val);
+		wallet.MakeTxOutput(*pTx, h, 0, val, fee);
+		verify_test(proto::TxStatus::Ok == node.OnTransaction(std::move(pTx), nullptr, nullptr, true, nullptr, nullptr));
+
+		RunReactorFor(200);
+		verify_test(extPow.m_Jobs == nJobs);
+
+		// above it: the miners switch to the new template
+		val = wallet.MakeTxInput(pTx, h);
+		verify_test(val);
+		wallet.MakeTxOutput(*pTx, h, 0, val, fee * 6);
+		verify_test(proto::TxStatus::Ok == node.OnTransaction(std::move(pTx), nullptr, nullptr, true, nullptr, nullptr));
+
+		RunReactorFor(200);
+		verify_test(extPow.m_Jobs == nJobs + 1);
+	}
+
 
 
 }
@@ -3891,6 +4078,7 @@ void TestAll()
 
 	if (!bClientProtoOnly)
 	{
+		beam::TestIblt();
 		beam::TestHalving();
 		beam::TestChainworkProof();
 	}
@@ -4014,6 +4202,12 @@ void TestAll()
 	beam::TestDependentTxs();
 	beam::DeleteFile(beam::g_sz);
 	beam::DeleteFile(beam::g_sz2);
+
+	printf("Node mining fee threshold test...\n");
+	fflush(stdout);
+
+	beam::TestMiningFeeThreshold();
+	beam::DeleteFile(beam::g_sz);
 }
 
 int main()
@@ -19,6 +19,7 @@
 #include "../../core/treasury.h"
 #include "../../core/serialization_adapters.h"
 #include <boost/core/ignore_unused.hpp>
+#include <random>
 
 #ifndef LOG_VERBOSE_ENABLED
 #define LOG_VERBOSE_ENABLED 0
@@ -924,6 +925,533 @@ struct Context
 
 uint16_t g_LocalNodePort = 16725;
 
+// Synthetic simulation of tx announcements traffic: flooding vs set reconciliation, for different num of peers.
+// No real network is involved. The logic mimics Node::Peer::Announce and the reconciliation rounds, using the real Iblt.
+struct ReconcileSim
+{
+    static const uint32_t s_MsgOverhead = 16; // header + mac, approx.
+    static const uint32_t s_HaveSize = s_MsgOverhead + 32; // HaveTransaction, GetTransaction
+    static const uint32_t s_CellSize = 4 + 4 + 32;
+
+    uint32_t m_Nodes = 100;
+    uint32_t m_Txs = 2000;
+    uint32_t m_TxsPerRound = 50;
+    uint16_t m_FloodProbability = 0x4000;
+    bool m_Reconcile = true;
+
+    struct Link
+    {
+        uint32_t m_iPeer;
+        bool m_Outbound;
+        uint16_t m_DiffRatio;
+        std::set<uint32_t> m_setPending;
+    };
+
+    struct SimNode
+    {
+        std::vector<Link> m_vLinks;
+        std::vector<bool> m_vHas;
+    };
+
+    std::vector<SimNode> m_vNodes;
+    std::vector<Iblt::Key> m_vKeys;
+    std::mt19937 m_Rng;
+
+    struct Event {
+        uint32_t m_iNode;
+        uint32_t m_iTx;
+        uint32_t m_iFrom; // m_Nodes if injected
+    };
+
+    std::vector<Event> m_vQueue;
+
+    uint64_t m_Bytes = 0;
+    uint32_t m_Rounds = 0;
+    uint32_t m_Sketches = 0;
+    uint32_t m_DecodeFailed = 0;
+
+    Link& FindLink(uint32_t iNode, uint32_t iPeer)
+    {
+        for (Link& l : m_vNodes[iNode].m_vLinks)
+            if (l.m_iPeer == iPeer)
+                return l;
+
+        assert(false);
+        return m_vNodes[iNode].m_vLinks.front();
+    }
+
+    void BuildGraph(uint32_t nPeers)
+    {
+        m_vNodes.clear();
+        m_vNodes.resize(m_Nodes);
+
+        for (uint32_t i = 0; i < m_Nodes; i++)
+            m_vNodes[i].m_vHas.resize(m_Txs, false);
+
+        // each node connects to nPeers/2 random others. Roughly nPeers connections per node in total
+        for (uint32_t i = 0; i < m_Nodes; i++)
+        {
+            for (uint32_t nOut = 0; nOut < nPeers / 2; )
+            {
+                uint32_t j = m_Rng() % m_Nodes;
+                if ((i == j) || IsLinked(i, j))
+                    continue;
+
+                Link& l0 = m_vNodes[i].m_vLinks.emplace_back();
+                l0.m_iPeer = j;
+                l0.m_Outbound = true;
+                l0.m_DiffRatio = proto::Reconcile::s_DiffRatioDef;
+
+                Link& l1 = m_vNodes[j].m_vLinks.emplace_back();
+                l1.m_iPeer = i;
+                l1.m_Outbound = false;
+                l1.m_DiffRatio = proto::Reconcile::s_DiffRatioDef;
+
+                nOut++;
+            }
+        }
+    }
+
+    bool IsLinked(uint32_t i, uint32_t j) const
+    {
+        for (const Link& l : m_vNodes[i].m_vLinks)
+            if (l.m_iPeer == j)
+                return true;
+        return false;
+    }
+
+    void OnHave(uint32_t iFrom, uint32_t iTo, uint32_t iTx)
+    {
+        m_Bytes += s_HaveSize;
+        FindLink(iTo, iFrom).m_setPending.erase(iTx);
+
+        if (m_vNodes[iTo].m_vHas[iTx])
+            return;
+
+        m_Bytes += s_HaveSize; // GetTransaction. The tx itself is not accounted, it's the same for both methods
+        m_vNodes[iTo].m_vHas[iTx] = true;
+        m_vQueue.push_back({ iTo, iTx, iFrom });
+    }
+
+    void Flood()
+    {
+        while (!m_vQueue.empty())
+        {
+            Event evt = m_vQueue.back();
+            m_vQueue.pop_back();
+
+            for (Link& l : m_vNodes[evt.m_iNode].m_vLinks)
+            {
+                if (l.m_iPeer == evt.m_iFrom)
+                    continue;
+
+                bool bFlood = !m_Reconcile || (l.m_Outbound && ((m_Rng() & 0xffff) < m_FloodProbability));
+                if (bFlood)
+                    OnHave(evt.m_iNode, l.m_iPeer, evt.m_iTx);
+                else
+                    l.m_setPending.insert(evt.m_iTx);
+            }
+        }
+    }
+
+    void FloodPending(uint32_t iFrom, Link& l)
+    {
+        std::set<uint32_t> s;
+        s.swap(l.m_setPending);
+
+        for (uint32_t iTx : s)
+            OnHave(iFrom, l.m_iPeer, iTx);
+    }
+
+    void Reconcile(uint32_t iNode, Link& l)
+    {
+        Link& l2 = FindLink(l.m_iPeer, iNode);
+
+        m_Bytes += s_MsgOverhead + 1 + 4 + 2 + 8; // ReconcileRequest
+        m_Bytes += s_MsgOverhead + 1 + 1; // ReconcileDone
+
+        uint64_t nMy = l2.m_setPending.size();
+        uint64_t nPeer = l.m_setPending.size();
+        uint64_t nDiff = proto::Reconcile::get_Diff(nMy, nPeer, l.m_DiffRatio);
+        uint32_t nCells = Iblt::get_CellsFor(static_cast<uint32_t>(std::min<uint64_t>(nDiff, proto::Reconcile::s_MaxCells)));
+
+        m_Bytes += s_MsgOverhead + 1;
+
+        if ((nCells > proto::Reconcile::s_MaxCells) || (nCells >= nMy + nPeer))
+        {
+            FloodPending(iNode, l);
+            FloodPending(l.m_iPeer, l2);
+            return;
+        }
+
+        m_Sketches++;
+        m_Bytes += nCells * s_CellSize;
+
+        uint64_t salt = m_Rng();
+
+        Iblt ibltPeer, ibltMy;
+        ibltPeer.Reset(nCells, salt);
+        ibltMy.Reset(nCells, salt);
+
+        for (uint32_t iTx : l2.m_setPending)
+            ibltPeer.Add(m_vKeys[iTx]);
+        for (uint32_t iTx : l.m_setPending)
+            ibltMy.Add(m_vKeys[iTx]);
+
+        ibltMy.Subtract(ibltPeer.m_vCells);
+
+        std::vector<Iblt::Key> vMy, vPeer;
+        if (!ibltMy.Decode(vMy, vPeer))
+        {
+            l.m_DiffRatio = std::min<uint16_t>(l.m_DiffRatio * 2 + 1, proto::Reconcile::s_DiffRatioMax);
+            m_DecodeFailed++;
+            FloodPending(iNode, l);
+            FloodPending(l.m_iPeer, l2);
+            return;
+        }
+
+        uint16_t q = proto::Reconcile::get_DiffRatio(nPeer, nMy, vMy.size() + vPeer.size());
+        l.m_DiffRatio = static_cast<uint16_t>((l.m_DiffRatio + q + 1) / 2);
+
+        std::set<uint32_t> sMy, sPeer;
+        sMy.swap(l.m_setPending);
+        sPeer.swap(l2.m_setPending);
+
+        for (uint32_t iTx : sMy)
+            if (!sPeer.count(iTx))
+                OnHave(iNode, l.m_iPeer, iTx);
+
+        for (uint32_t iTx : sPeer)
+        {
+            if (sMy.count(iTx) || m_vNodes[iNode].m_vHas[iTx])
+                continue;
+
+            m_Bytes += s_HaveSize; // GetTransaction
+            m_vNodes[iNode].m_vHas[iTx] = true;
+            m_vQueue.push_back({ iNode, iTx, l.m_iPeer });
+        }
+    }
+
+    bool IsComplete() const
+    {
+        for (const SimNode& n : m_vNodes)
+        {
+            for (bool b : n.m_vHas)
+                if (!b)
+                    return false;
+
+            for (const Link& l : n.m_vLinks)
+                if (!l.m_setPending.empty())
+                    return false;
+        }
+
+        return true;
+    }
+
+    void Run(uint32_t nPeers)
+    {
+        m_Rng.seed(nPeers);
+        m_vKeys.resize(m_Txs);
+        for (Iblt::Key& key : m_vKeys)
+            for (uint32_t i = 0; i < key.nBytes; i++)
+                key.m_pData[i] = static_cast<uint8_t>(m_Rng());
+
+        BuildGraph(nPeers);
+
+        m_Bytes = 0;
+        m_Rounds = 0;
+        m_Sketches = 0;
+        m_DecodeFailed = 0;
+
+        for (uint32_t iTx = 0; ; m_Rounds++)
+        {
+            for (uint32_t i = 0; (i < m_TxsPerRound) && (iTx < m_Txs); i++, iTx++)
+            {
+                uint32_t iNode = m_Rng() % m_Nodes;
+                m_vNodes[iNode].m_vHas[iTx] = true;
+                m_vQueue.push_back({ iNode, iTx, m_Nodes });
+            }
+
+            Flood();
+
+            if (m_Reconcile)
+            {
+                for (uint32_t iNode = 0; iNode < m_Nodes; iNode++)
+                    for (Link& l : m_vNodes[iNode].m_vLinks)
+                        if (l.m_Outbound)
+                            Reconcile(iNode, l);
+            }
+
+            if ((iTx == m_Txs) && m_vQueue.empty() && IsComplete())
+                break;
+        }
+    }
+
+    static void RunAll()
+    {
+        std::cout << "Announcement traffic per tx per node (bytes), excluding tx bodies" << std::endl;
+
+        for (uint32_t nPeers : { 8, 16, 32, 64 })
+        {
+            ReconcileSim sim;
+
+            sim.m_Reconcile = false;
+            sim.Run(nPeers);
+            double kFlood = double(sim.m_Bytes) / (double(sim.m_Txs) * sim.m_Nodes);
+
+            sim.m_Reconcile = true;
+            sim.Run(nPeers);
+            double kReconcile = double(sim.m_Bytes) / (double(sim.m_Txs) * sim.m_Nodes);
+
+            std::cout << "Peers=" << nPeers
+                << ", Flood=" << kFlood
+                << ", Reconcile=" << kReconcile
+                << ", Rounds=" << sim.m_Rounds
+                << ", Sketches=" << sim.m_Sketches
+                << ", DecodeFailed=" << sim.m_DecodeFailed
+                << std::endl;
+        }
+    }
+};
+
+// Synthetic simulation of the body download: a single request at a time (legacy) vs concurrent windows.
+// Mimics Node::TryAssignTask, NodeProcessor::RequestBodies and Node::CheckBodyStall, with peers of different latencies and bandwidth.
+struct SyncSim
+{
+    struct SimPeer
+    {
+        uint32_t m_Latency_ms;
+        uint32_t m_Bps; // estimated, the peer rating
+        uint32_t m_BpsActual;
+        bool m_Dropped;
+        bool m_Busy;
+        Height m_hLo;
+        Height m_hHi;
+        double m_tAssigned;
+        double m_tDone;
+    };
+
+    static const uint32_t s_Blocks = 20000;
+    static const uint32_t s_MaxBlockSize = 1024 * 1024; // assumed until the actual avg is known
+
+    std::vector<SimPeer> m_vPeers;
+    std::vector<uint32_t> m_vSizes;
+    std::vector<bool> m_vHave;
+    Height m_hLowestMissing;
+
+    Node::Config m_Cfg;
+    uint32_t m_SizeAvg;
+    double m_TimeHigherDone;
+    uint32_t m_Stalls;
+
+    void AddPeer(uint32_t nLatency_ms, uint32_t nBps, uint32_t nBpsActual)
+    {
+        SimPeer& p = m_vPeers.emplace_back();
+        p.m_Latency_ms = nLatency_ms;
+        p.m_Bps = nBps;
+        p.m_BpsActual = nBpsActual;
+    }
+
+    bool IsInFlight(Height h) const
+    {
+        for (const SimPeer& p : m_vPeers)
+            if (p.m_Busy && (p.m_hLo == h))
+                return true;
+        return false;
+    }
+
+    SimPeer* get_LowestBusy()
+    {
+        SimPeer* pRet = nullptr;
+        for (SimPeer& p : m_vPeers)
+            if (p.m_Busy && (!pRet || (p.m_hLo < pRet->m_hLo)))
+                pRet = &p;
+        return pRet;
+    }
+
+    SimPeer* get_BestIdle()
+    {
+        SimPeer* pRet = nullptr;
+        for (SimPeer& p : m_vPeers)
+            if (!p.m_Busy && !p.m_Dropped && (!pRet || (p.m_Bps > pRet->m_Bps)))
+                pRet = &p;
+        return pRet;
+    }
+
+    void Assign(SimPeer& p, Height hLo, Height hHi, double t)
+    {
+        // per-peer count, as in Node::get_BodyPackCount
+        uint64_t nCount = m_Cfg.m_BandwidthCtl.m_MaxBodyPackCount;
+        if (m_Cfg.m_BodySync.m_WindowSize)
+        {
+            uint64_t nSize = std::min<uint64_t>(uint64_t(p.m_Bps) * m_Cfg.m_BodySync.m_Stall_ms / 2000, m_Cfg.m_BandwidthCtl.m_MaxBodyPackSize);
+            nCount = std::max<uint64_t>(std::min<uint64_t>(nCount, nSize / (m_SizeAvg ? m_SizeAvg : s_MaxBlockSize)), 1);
+        }
+
+        std::setmin(hHi, hLo + nCount - 1);
+
+        // the server truncates the pack by size
+        uint64_t nBytes = 0;
+        for (Height h = hLo; h <= hHi; h++)
+        {
+            nBytes += m_vSizes[h];
+            if (nBytes >= m_Cfg.m_BandwidthCtl.m_MaxBodyPackSize)
+            {
+                hHi = h;
+                break;
+            }
+        }
+
+        p.m_Busy = true;
+        p.m_hLo = hLo;
+        p.m_hHi = hHi;
+        p.m_tAssigned = t;
+        p.m_tDone = t + 2e-3 * p.m_Latency_ms + double(nBytes) / p.m_BpsActual;
+    }
+
+    void AssignAll(double t)
+    {
+        Height hTip = m_vSizes.size() - 1;
+        Height nSize = m_Cfg.m_BodySync.m_WindowSize;
+
+        if (!nSize)
+        {
+            if (!get_LowestBusy())
+            {
+                SimPeer* pPeer = get_BestIdle();
+                if (pPeer)
+                    Assign(*pPeer, m_hLowestMissing, hTip, t);
+            }
+            return;
+        }
+
+        Height hWndLo = m_hLowestMissing - (m_hLowestMissing % nSize);
+        Height hMax = std::min(hTip, hWndLo + nSize * m_Cfg.m_BodySync.m_Windows - 1);
+
+        for (Height h = m_hLowestMissing; h <= hMax; )
+        {
+            if (m_vHave[h])
+            {
+                h++;
+                continue;
+            }
+
+            Height hHi = std::min(h - (h % nSize) + nSize - 1, hMax);
+
+            if (!IsInFlight(h))
+            {
+                SimPeer* pPeer = get_BestIdle();
+                if (!pPeer)
+                    break;
+                Assign(*pPeer, h, hHi, t);
+            }
+
+            h = hHi + 1;
+        }
+    }
+
+    void OnDone(SimPeer& p)
+    {
+        uint64_t nBytes = 0;
+        for (Height h = p.m_hLo; h <= p.m_hHi; h++)
+        {
+            m_vHave[h] = true;
+            nBytes += m_vSizes[h];
+        }
+
+        uint32_t nAvg = static_cast<uint32_t>(nBytes / (p.m_hHi - p.m_hLo + 1));
+        m_SizeAvg = m_SizeAvg ? (m_SizeAvg - (m_SizeAvg >> 4) + (nAvg >> 4)) : nAvg;
+
+        if (get_LowestBusy() != &p)
+            m_TimeHigherDone = p.m_tDone;
+
+        p.m_Busy = false;
+
+        while ((m_hLowestMissing < m_vHave.size()) && m_vHave[m_hLowestMissing])
+            m_hLowestMissing++;
+    }
+
+    double Run()
+    {
+        std::mt19937 rng(0);
+        m_vSizes.resize(s_Blocks);
+        for (uint32_t& n : m_vSizes)
+            n = 1024 + rng() % (1024 * 40);
+
+        m_vHave.assign(m_vSizes.size(), false);
+        m_hLowestMissing = 0;
+        m_SizeAvg = 0;
+        m_TimeHigherDone = -1;
+        m_Stalls = 0;
+
+        for (SimPeer& p : m_vPeers)
+        {
+            p.m_Busy = false;
+            p.m_Dropped = false;
+        }
+
+        double t = 0;
+        while (m_hLowestMissing < m_vSizes.size())
+        {
+            AssignAll(t);
+
+            SimPeer* pNext = nullptr;
+            for (SimPeer& p : m_vPeers)
+                if (p.m_Busy && (!pNext || (p.m_tDone < pNext->m_tDone)))
+                    pNext = &p;
+
+            if (!pNext)
+                return -1; // all dropped
+
+            // stall, as in Node::CheckBodyStall
+            SimPeer* pLowest = get_LowestBusy();
+            if (m_Cfg.m_BodySync.m_WindowSize && (m_TimeHigherDone > pLowest->m_tAssigned))
+            {
+                double tStall = pLowest->m_tAssigned + 1e-3 * m_Cfg.m_BodySync.m_Stall_ms;
+                if (tStall < pNext->m_tDone)
+                {
+                    t = std::max(t, tStall);
+                    pLowest->m_Busy = false;
+                    pLowest->m_Dropped = true;
+                    m_Stalls++;
+                    continue;
+                }
+            }
+
+            t = pNext->m_tDone;
+            OnDone(*pNext);
+        }
+
+        return t;
+    }
+
+    static void RunAll()
+    {
+        SyncSim sim;
+        sim.AddPeer(30, 4 << 20, 4 << 20);
+        sim.AddPeer(80, 2 << 20, 2 << 20);
+        sim.AddPeer(150, 1 << 20, 1 << 20);
+        sim.AddPeer(300, 512 << 10, 512 << 10);
+        sim.AddPeer(600, 128 << 10, 128 << 10);
+        sim.AddPeer(100, 2 << 20, 16 << 10); // a staller, its rating is misleading
+
+        std::cout << "Body sync of " << s_Blocks << " blocks, peers=" << sim.m_vPeers.size() << std::endl;
+
+        uint32_t pWnd[] = { 0, 64, 256, 1024, 2048 };
+        for (uint32_t nWnd : pWnd)
+        {
+            sim.m_Cfg.m_BodySync.m_WindowSize = nWnd;
+            double t = sim.Run();
+
+            std::cout << "WindowSize=" << nWnd
+                << ", Windows=" << (nWnd ? sim.m_Cfg.m_BodySync.m_Windows : 1)
+                << ", Time=" << t << " s"
+                << ", Stalls=" << sim.m_Stalls
+                << std::endl;
+        }
+    }
+};
+
 } // namespace beam
 
 
@@ -938,6 +1466,8 @@ int main_Guarded(int argc, char* argv[])
     auto logger = beam::Logger::create(BEAM_LOG_LEVEL_INFO, BEAM_LOG_LEVEL_INFO);
 
     const char szLocalMode[] = "local_mode";
+    const char szReconcileSim[] = "reconcile_sim";
+    const char szSyncSim[] = "sync_sim";
 
 #define THE_MACRO(type, name, def, comment) const char sz##name[] = #name;
     CfgFieldsAll(THE_MACRO)
@@ -948,6 +1478,8 @@ int main_Guarded(int argc, char* argv[])
     options.add_options()
         (cli::SEED_PHRASE, po::value<std::string>()->default_value(""), "seed phrase")
         (szLocalMode, po::value<bool>()->default_value(false), "local mode")
+        (szReconcileSim, po::value<bool>()->default_value(false), "simulate announcement traffic (flooding vs reconciliation) and exit")
+        (szSyncSim, po::value<bool>()->default_value(false), "simulate body download from peers with different latencies and exit")
         
 #define THE_MACRO(type, name, def, comment) (sz##name, po::value<type>()->default_value(def), comment)
         CfgFieldsAll(THE_MACRO)
@@ -957,6 +1489,18 @@ int main_Guarded(int argc, char* argv[])
 
     po::variables_map vm = getOptions(argc, argv, options, true);
 
+    if (vm[szReconcileSim].as<bool>())
+    {
+        ReconcileSim::RunAll();
+        return 0;
+    }
+
+    if (vm[szSyncSim].as<bool>())
+    {
+        SyncSim::RunAll();
+        return 0;
+    }
+
     bool bLocalMode = vm[szLocalMode].as<bool>();
 
     Node node;
@@ -15,6 +15,7 @@
 #include "core/block_crypt.h"
 #include "crypto/equihashR.h"
 #include "crypto/beamHashIII.h"
+#include "beamHashIII_solver.h"
 #include "uint256.h"
 #include "arith_uint256.h"
 #include <utility>
@@ -60,6 +61,15 @@ struct Block::PoW::Helper
 
 		return d.IsTargetReached(hv);
 	}
+
+#ifdef BEAM_BEAMHASH3_CPU_SOLVER
+	static BeamHashIII_Solver& get_SolverIII()
+	{
+		// the tables are large, keep them for the subsequent solutions of this (miner) thread
+		thread_local BeamHashIII_Solver s_Solver;
+		return s_Solver;
+	}
+#endif // BEAM_BEAMHASH3_CPU_SOLVER
 };
 
 bool Block::PoW::Solve(const void* pInput, uint32_t nSizeInput, Height h, const Cancel& fnCancel)
@@ -80,13 +90,28 @@ bool Block::PoW::Solve(const void* pInput, uint32_t nSizeInput, Height h, const
         return fnCancel(false);
     };
 
+#ifdef BEAM_BEAMHASH3_CPU_SOLVER
+	BeamHashIII_Solver::CancelFn fnCancelIII = [&fnCancel]() {
+		return fnCancel(false);
+	};
+#endif // BEAM_BEAMHASH3_CPU_SOLVER
+
     while (true)
     {
 		hlp.Reset(pInput, nSizeInput, m_Nonce, h);
 
 		try {
 
-			if (hlp.getCurrentPoW(h)->OptimisedSolve(hlp.m_Blake, fnValid, fnCancelInternal))
+			PoWScheme* pScheme = hlp.getCurrentPoW(h);
+#ifdef BEAM_BEAMHASH3_CPU_SOLVER
+			bool bSolved = (pScheme == &hlp.BeamHashIII) ?
+				Helper::get_SolverIII().Solve(hlp.m_Blake, fnValid, fnCancelIII) :
+				pScheme->OptimisedSolve(hlp.m_Blake, fnValid, fnCancelInternal);
+#else // BEAM_BEAMHASH3_CPU_SOLVER
+			bool bSolved = pScheme->OptimisedSolve(hlp.m_Blake, fnValid, fnCancelInternal);
+#endif // BEAM_BEAMHASH3_CPU_SOLVER
+
+			if (bSolved)
 				break;
 
 		} catch (const SolverCancelledException&) {
@@ -102,6 +127,13 @@ bool Block::PoW::Solve(const void* pInput, uint32_t nSizeInput, Height h, const
     return true;
 }
 
+void Block::PoW::ReleaseSolver()
+{
+#ifdef BEAM_BEAMHASH3_CPU_SOLVER
+	Helper::get_SolverIII().Release();
+#endif // BEAM_BEAMHASH3_CPU_SOLVER
+}
+
 bool Block::PoW::IsValid(const void* pInput, uint32_t nSizeInput, Height h) const
 {
 	Helper hlp;
@@ -0,0 +1,589 @@
+// Copyright 2020 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "beamHashIII_solver.h"
+#include "crypto/beamHashIII.h"
+#include "utility/executor.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace beam
+{
+	namespace
+	{
+		static_assert(workBitSize == 448 && collisionBitSize == 24 && numRounds == 5, "BeamHash III parameters");
+
+		const uint32_t s_Words = 8; // element bits, padded with the indices for the mix
+		const uint32_t s_IndexBits = collisionBitSize + 1;
+		const uint32_t s_Chunks = 16; // per round, cancellation is checked in between
+
+		// Element length after each round, before the mix
+		const uint32_t s_pRemLen[] = { 448, 424, 400, 376, 288 };
+
+		inline uint64_t rotl(uint64_t x, uint32_t b)
+		{
+			return (x << b) | (x >> (64 - b));
+		}
+
+		uint64_t SipHash24(const uint64_t* pState, uint64_t nonce)
+		{
+			uint64_t v0 = pState[0], v1 = pState[1], v2 = pState[2], v3 = pState[3] ^ nonce;
+
+			auto fnRound = [&]() {
+				v0 += v1; v2 += v3;
+				v1 = rotl(v1, 13);
+				v3 = rotl(v3, 16);
+				v1 ^= v0; v3 ^= v2;
+				v0 = rotl(v0, 32);
+				v2 += v1; v0 += v3;
+				v1 = rotl(v1, 17);
+				v3 = rotl(v3, 21);
+				v1 ^= v2; v3 ^= v0;
+				v2 = rotl(v2, 32);
+			};
+
+			fnRound();
+			fnRound();
+			v0 ^= nonce;
+			v2 ^= 0xff;
+			fnRound();
+			fnRound();
+			fnRound();
+			fnRound();
+
+			return v0 ^ v1 ^ v2 ^ v3;
+		}
+
+		// Same as stepElem::applyMix. The element bits above nRemLen must be zero
+		void Mix(uint64_t* pW, uint32_t nRemLen, const uint32_t* pIdx, uint32_t nIdx)
+		{
+			uint64_t pT[s_Words];
+			memcpy(pT, pW, sizeof(pT));
+
+			uint32_t nPad = std::min((s_Words * 64 - nRemLen + collisionBitSize) / s_IndexBits, nIdx);
+			for (uint32_t i = 0; i < nPad; i++)
+			{
+				uint32_t nPos = nRemLen + i * s_IndexBits;
+				uint32_t iWord = nPos >> 6;
+				uint32_t nShift = nPos & 63;
+
+				pT[iWord] |= static_cast<uint64_t>(pIdx[i]) << nShift;
+				if ((nShift + s_IndexBits > 64) && (iWord + 1 < s_Words))
+					pT[iWord + 1] |= static_cast<uint64_t>(pIdx[i]) >> (64 - nShift);
+			}
+
+			uint64_t res = 0;
+			for (uint32_t i = 0; i < s_Words; i++)
+				res += rotl(pT[i], (29 * (i + 1)) & 63);
+
+			pW[0] = rotl(res, 24);
+		}
+
+		// (a ^ b) >> collisionBitSize, truncated to nRemLen bits
+		void Combine(uint64_t* pRes, const uint64_t* pA, const uint64_t* pB, uint32_t nRemLen)
+		{
+			for (uint32_t i = 0; i + 1 < s_Words; i++)
+				pRes[i] = ((pA[i] ^ pB[i]) >> collisionBitSize) | ((pA[i + 1] ^ pB[i + 1]) << (64 - collisionBitSize));
+			pRes[s_Words - 1] = (pA[s_Words - 1] ^ pB[s_Words - 1]) >> collisionBitSize;
+
+			uint32_t iWord = nRemLen >> 6;
+			if (nRemLen & 63)
+				pRes[iWord++] &= (static_cast<uint64_t>(1) << (nRemLen & 63)) - 1;
+			for (; iWord < s_Words; iWord++)
+				pRes[iWord] = 0;
+		}
+
+		bool IsDistinct(const uint32_t* pA, const uint32_t* pB, uint32_t n)
+		{
+			for (uint32_t i = 0; i < n; i++)
+				for (uint32_t j = 0; j < n; j++)
+					if (pA[i] == pB[j])
+						return false;
+			return true;
+		}
+
+		// Index tree of the combined element: the subtree with the lower first index goes first
+		bool Merge(uint32_t* pRes, const uint32_t* pA, const uint32_t* pB, uint32_t n)
+		{
+			bool bSwap = pB[0] < pA[0];
+			if (bSwap)
+				std::swap(pA, pB);
+
+			memcpy(pRes, pA, sizeof(*pA) * n);
+			memcpy(pRes + n, pB, sizeof(*pB) * n);
+			return bSwap;
+		}
+
+	} // namespace
+
+	struct BeamHashIII_Solver::Rec1
+	{
+		uint64_t m_pW[7];
+		uint32_t m_pIdx[2];
+	};
+
+	struct BeamHashIII_Solver::Rec2
+	{
+		uint64_t m_Mixed; // the rest is restored from the indices
+		uint32_t m_pIdx[4];
+	};
+
+	struct BeamHashIII_Solver::Rec3
+	{
+		uint64_t m_pW[5]; // only the lower 312 bits affect the next round
+		uint32_t m_pIdx[8];
+	};
+
+	struct BeamHashIII_Solver::Rec4
+	{
+		uint64_t m_Mixed; // only the lower 48 bits are checked
+		uint32_t m_pRef[2]; // round 3 slots, in the index tree order
+	};
+
+	static_assert(sizeof(BeamHashIII_Solver::Solution) == 100 + 4, "solution: 32 indices of 25 bits + extra nonce");
+
+	struct BeamHashIII_Solver::Scratch
+	{
+		std::vector<uint64_t> m_vW;
+		std::vector<uint32_t> m_vIdx;
+		std::vector<uint16_t> m_vKey;
+		std::vector<uint16_t> m_vOrder;
+		std::vector<uint32_t> m_vPos;
+
+		void Init()
+		{
+			if (!m_vW.empty())
+				return;
+
+			m_vW.resize(s_BucketSize * s_Words);
+			m_vIdx.resize(s_BucketSize * 8);
+			m_vKey.resize(s_BucketSize);
+			m_vOrder.resize(s_BucketSize);
+			m_vPos.resize(s_Buckets + 1);
+		}
+
+		uint64_t* get_W(uint32_t i) { return &m_vW[i * s_Words]; }
+		uint32_t* get_Idx(uint32_t i) { return &m_vIdx[i * 8]; }
+
+		void set_Key(uint32_t i, uint64_t nMixed)
+		{
+			// the lower half of the collision bits is the bucket
+			m_vKey[i] = static_cast<uint16_t>((nMixed >> s_BucketBits) & (s_Buckets - 1));
+		}
+
+		template <typename Fn>
+		void ForEachPair(uint32_t n, Fn&& fn)
+		{
+			static_assert(s_BucketSize <= 0x10000, "");
+
+			// counting sort by the upper half of the collision bits
+			std::fill(m_vPos.begin(), m_vPos.end(), 0);
+			for (uint32_t i = 0; i < n; i++)
+				m_vPos[m_vKey[i] + 1]++;
+			for (uint32_t k = 1; k <= s_Buckets; k++)
+				m_vPos[k] += m_vPos[k - 1];
+			for (uint32_t i = 0; i < n; i++)
+				m_vOrder[m_vPos[m_vKey[i]]++] = static_cast<uint16_t>(i);
+
+			// now m_vPos[k] is the end of the k-th group
+			for (uint32_t k = 0, i0 = 0; k < s_Buckets; k++)
+			{
+				uint32_t i1 = m_vPos[k];
+				for (uint32_t i = i0; i + 1 < i1; i++)
+					for (uint32_t j = i + 1; j < i1; j++)
+						fn(m_vOrder[i], m_vOrder[j]);
+				i0 = i1;
+			}
+		}
+	};
+
+	struct BeamHashIII_Solver::Task
+		:public Executor::TaskSync
+	{
+		BeamHashIII_Solver* m_pThis;
+		uint32_t m_iRound;
+		uint32_t m_i0;
+		uint32_t m_nCount;
+
+		virtual void Exec(Executor::Context& ctx) override
+		{
+			uint32_t i0, nCount;
+			ctx.get_Portion(i0, nCount, m_nCount);
+
+			m_pThis->RunPart(m_iRound, m_i0 + i0, nCount, m_pThis->m_vScratch[ctx.m_iThread]);
+		}
+	};
+
+	BeamHashIII_Solver::BeamHashIII_Solver()
+	{
+	}
+
+	BeamHashIII_Solver::~BeamHashIII_Solver()
+	{
+	}
+
+	size_t BeamHashIII_Solver::get_MemorySize()
+	{
+		static_assert(sizeof(Rec1) <= sizeof(Rec3), "");
+		static_assert((sizeof(uint32_t) <= sizeof(Rec2)) && (sizeof(Rec4) <= sizeof(Rec2)), "");
+
+		return static_cast<size_t>(s_Slots) * (sizeof(Rec3) + sizeof(Rec2));
+	}
+
+	void BeamHashIII_Solver::Allocate()
+	{
+		if (m_pA)
+			return;
+
+		// not initialized, the pages are committed on the first use
+		m_pA.reset(new uint64_t[static_cast<size_t>(s_Slots) * sizeof(Rec3) / sizeof(uint64_t)]);
+		m_pB.reset(new uint64_t[static_cast<size_t>(s_Slots) * sizeof(Rec2) / sizeof(uint64_t)]);
+		m_pCount.reset(new std::atomic<uint32_t>[s_Tables * s_Buckets]);
+	}
+
+	void BeamHashIII_Solver::Release()
+	{
+		m_pA.reset();
+		m_pB.reset();
+		m_pCount.reset();
+		m_vScratch.clear();
+	}
+
+	uint32_t BeamHashIII_Solver::get_Count(uint32_t iTable, uint32_t iBucket) const
+	{
+		return std::min(m_pCount[iTable * s_Buckets + iBucket].load(std::memory_order_relaxed), s_BucketSize);
+	}
+
+	uint32_t BeamHashIII_Solver::AllocSlot(uint32_t iTable, uint64_t nMixed)
+	{
+		uint32_t iBucket = static_cast<uint32_t>(nMixed) & (s_Buckets - 1);
+		uint32_t n = m_pCount[iTable * s_Buckets + iBucket].fetch_add(1, std::memory_order_relaxed);
+
+		return (n < s_BucketSize) ? (iBucket * s_BucketSize + n) : s_Slots;
+	}
+
+	void BeamHashIII_Solver::Seed(uint64_t* pW, uint32_t nIdx) const
+	{
+		for (uint32_t i = 0; i + 1 < s_Words; i++)
+			pW[i] = SipHash24(m_pPrePow, (static_cast<uint64_t>(nIdx) << 3) + i);
+		pW[s_Words - 1] = 0;
+
+		Mix(pW, s_pRemLen[0], &nIdx, 1);
+	}
+
+	void BeamHashIII_Solver::Restore(uint64_t* pW, uint64_t nMixed, const uint32_t* pIdx, uint32_t iRound) const
+	{
+		// The mix only replaces the lowest word, which is then shifted out by the next round.
+		// Hence the bits above it are the xor of the (unmixed) seeds, shifted by each round.
+		uint32_t nShift = iRound * collisionBitSize;
+		assert(nShift && (nShift < 64));
+
+		uint64_t pS[s_Words + 1] = { 0 };
+		for (uint32_t i = 0; i < (1U << iRound); i++)
+			for (uint32_t k = 1; k + 1 < s_Words; k++)
+				pS[k] ^= SipHash24(m_pPrePow, (static_cast<uint64_t>(pIdx[i]) << 3) + k);
+
+		pW[0] = nMixed;
+		for (uint32_t k = 1; k < s_Words; k++)
+			pW[k] = (pS[k] >> nShift) | (pS[k + 1] << (64 - nShift));
+
+		uint32_t nRemLen = s_pRemLen[iRound];
+		if (nRemLen & 63)
+			pW[nRemLen >> 6] &= (static_cast<uint64_t>(1) << (nRemLen & 63)) - 1;
+	}
+
+	bool BeamHashIII_Solver::Solve(const blake2b_state& base, const ValidFn& fnValid, const CancelFn& fnCancel)
+	{
+		Allocate();
+
+		blake2b_state state = base;
+		uint8_t pExtraNonce[4] = { 0 };
+		blake2b_update(&state, pExtraNonce, sizeof(pExtraNonce));
+		blake2b_final(&state, reinterpret_cast<uint8_t*>(m_pPrePow), sizeof(m_pPrePow));
+
+		for (uint32_t i = 0; i < s_Tables * s_Buckets; i++)
+			m_pCount[i].store(0, std::memory_order_relaxed);
+
+		m_vSolutions.clear();
+
+		Executor* pExec = Executor::s_pInstance;
+		uint32_t nThreads = pExec ? pExec->get_Threads() : 1;
+		if (m_vScratch.size() < nThreads)
+			m_vScratch.resize(nThreads);
+
+		Task t;
+		t.m_pThis = this;
+
+		for (t.m_iRound = 0; t.m_iRound <= s_Tables; t.m_iRound++)
+		{
+			uint32_t nTotal = t.m_iRound ? s_Buckets : (1U << s_IndexBits);
+			t.m_nCount = nTotal / s_Chunks;
+
+			for (t.m_i0 = 0; t.m_i0 < nTotal; t.m_i0 += t.m_nCount)
+			{
+				if (fnCancel())
+					throw SolverCancelledException();
+
+				if (pExec)
+					pExec->ExecAll(t);
+				else
+					RunPart(t.m_iRound, t.m_i0, t.m_nCount, m_vScratch[0]);
+			}
+		}
+
+		// the order in which the threads find the solutions is random
+		std::sort(m_vSolutions.begin(), m_vSolutions.end());
+		m_nLastSolutions = static_cast<uint32_t>(m_vSolutions.size());
+
+		for (const Solution& sol : m_vSolutions)
+			if (fnValid(std::vector<uint8_t>(sol.begin(), sol.end())))
+				return true;
+
+		return false;
+	}
+
+	void BeamHashIII_Solver::RunPart(uint32_t iRound, uint32_t i0, uint32_t nCount, Scratch& s)
+	{
+		if (!iRound)
+		{
+			Generate(i0, nCount);
+			return;
+		}
+
+		s.Init();
+
+		for (uint32_t iBucket = i0; iBucket < i0 + nCount; iBucket++)
+		{
+			switch (iRound)
+			{
+			case 1: Round1(iBucket, s); break;
+			case 2: Round2(iBucket, s); break;
+			case 3: Round3(iBucket, s); break;
+			case 4: Round4(iBucket, s); break;
+			default: Round5(iBucket, s);
+			}
+		}
+	}
+
+	void BeamHashIII_Solver::Generate(uint32_t i0, uint32_t nCount)
+	{
+		uint32_t* pDst = reinterpret_cast<uint32_t*>(m_pB.get());
+
+		for (uint32_t nIdx = i0; nIdx < i0 + nCount; nIdx++)
+		{
+			uint64_t pW[s_Words];
+			Seed(pW, nIdx);
+
+			// only the index is stored, the element is regenerated in the 1st round
+			uint32_t iSlot = AllocSlot(0, pW[0]);
+			if (iSlot < s_Slots)
+				pDst[iSlot] = nIdx;
+		}
+	}
+
+	void BeamHashIII_Solver::Round1(uint32_t iBucket, Scratch& s)
+	{
+		const uint32_t* pSrc = reinterpret_cast<const uint32_t*>(m_pB.get()) + iBucket * s_BucketSize;
+		Rec1* pDst = reinterpret_cast<Rec1*>(m_pA.get());
+
+		uint32_t n = get_Count(0, iBucket);
+		for (uint32_t i = 0; i < n; i++)
+		{
+			*s.get_Idx(i) = pSrc[i];
+			Seed(s.get_W(i), pSrc[i]);
+			s.set_Key(i, *s.get_W(i));
+		}
+
+		s.ForEachPair(n, [this, &s, pDst](uint32_t i, uint32_t j)
+		{
+			uint64_t pW[s_Words];
+			uint32_t pIdx[2];
+			Combine(pW, s.get_W(i), s.get_W(j), s_pRemLen[1]);
+			Merge(pIdx, s.get_Idx(i), s.get_Idx(j), 1);
+			Mix(pW, s_pRemLen[1], pIdx, 2);
+
+			uint32_t iSlot = AllocSlot(1, pW[0]);
+			if (iSlot < s_Slots)
+			{
+				Rec1& r = pDst[iSlot];
+				memcpy(r.m_pW, pW, sizeof(r.m_pW));
+				memcpy(r.m_pIdx, pIdx, sizeof(r.m_pIdx));
+			}
+		});
+	}
+
+	void BeamHashIII_Solver::Round2(uint32_t iBucket, Scratch& s)
+	{
+		const Rec1* pSrc = reinterpret_cast<const Rec1*>(m_pA.get()) + iBucket * s_BucketSize;
+		Rec2* pDst = reinterpret_cast<Rec2*>(m_pB.get());
+
+		uint32_t n = get_Count(1, iBucket);
+		for (uint32_t i = 0; i < n; i++)
+		{
+			uint64_t* pW = s.get_W(i);
+			memcpy(pW, pSrc[i].m_pW, sizeof(pSrc[i].m_pW));
+			pW[s_Words - 1] = 0;
+			memcpy(s.get_Idx(i), pSrc[i].m_pIdx, sizeof(pSrc[i].m_pIdx));
+			s.set_Key(i, *pW);
+		}
+
+		s.ForEachPair(n, [this, &s, pDst](uint32_t i, uint32_t j)
+		{
+			if (!IsDistinct(s.get_Idx(i), s.get_Idx(j), 2))
+				return;
+
+			uint64_t pW[s_Words];
+			uint32_t pIdx[4];
+			Combine(pW, s.get_W(i), s.get_W(j), s_pRemLen[2]);
+			Merge(pIdx, s.get_Idx(i), s.get_Idx(j), 2);
+			Mix(pW, s_pRemLen[2], pIdx, 4);
+
+			uint32_t iSlot = AllocSlot(2, pW[0]);
+			if (iSlot < s_Slots)
+			{
+				Rec2& r = pDst[iSlot];
+				r.m_Mixed = pW[0];
+				memcpy(r.m_pIdx, pIdx, sizeof(r.m_pIdx));
+			}
+		});
+	}
+
+	void BeamHashIII_Solver::Round3(uint32_t iBucket, Scratch& s)
+	{
+		const Rec2* pSrc = reinterpret_cast<const Rec2*>(m_pB.get()) + iBucket * s_BucketSize;
+		Rec3* pDst = reinterpret_cast<Rec3*>(m_pA.get());
+
+		uint32_t n = get_Count(2, iBucket);
+		for (uint32_t i = 0; i < n; i++)
+		{
+			memcpy(s.get_Idx(i), pSrc[i].m_pIdx, sizeof(pSrc[i].m_pIdx));
+			Restore(s.get_W(i), pSrc[i].m_Mixed, s.get_Idx(i), 2);
+			s.set_Key(i, *s.get_W(i));
+		}
+
+		s.ForEachPair(n, [this, &s, pDst](uint32_t i, uint32_t j)
+		{
+			if (!IsDistinct(s.get_Idx(i), s.get_Idx(j), 4))
+				return;
+
+			uint64_t pW[s_Words];
+			uint32_t pIdx[8];
+			Combine(pW, s.get_W(i), s.get_W(j), s_pRemLen[3]);
+			Merge(pIdx, s.get_Idx(i), s.get_Idx(j), 4);
+			Mix(pW, s_pRemLen[3], pIdx, 8);
+
+			uint32_t iSlot = AllocSlot(3, pW[0]);
+			if (iSlot < s_Slots)
+			{
+				Rec3& r = pDst[iSlot];
+				memcpy(r.m_pW, pW, sizeof(r.m_pW));
+				memcpy(r.m_pIdx, pIdx, sizeof(r.m_pIdx));
+			}
+		});
+	}
+
+	void BeamHashIII_Solver::Round4(uint32_t iBucket, Scratch& s)
+	{
+		const Rec3* pSrc = reinterpret_cast<const Rec3*>(m_pA.get()) + iBucket * s_BucketSize;
+		Rec4* pDst = reinterpret_cast<Rec4*>(m_pB.get());
+
+		uint32_t n = get_Count(3, iBucket);
+		for (uint32_t i = 0; i < n; i++)
+		{
+			uint64_t* pW = s.get_W(i);
+			memcpy(pW, pSrc[i].m_pW, sizeof(pSrc[i].m_pW));
+			std::fill(pW + _countof(pSrc[i].m_pW), pW + s_Words, 0);
+			memcpy(s.get_Idx(i), pSrc[i].m_pIdx, sizeof(pSrc[i].m_pIdx));
+			s.set_Key(i, *pW);
+		}
+
+		uint32_t iRef0 = iBucket * s_BucketSize;
+
+		s.ForEachPair(n, [this, &s, pDst, iRef0](uint32_t i, uint32_t j)
+		{
+			if (!IsDistinct(s.get_Idx(i), s.get_Idx(j), 8))
+				return;
+
+			uint64_t pW[s_Words];
+			uint32_t pIdx[16];
+			Combine(pW, s.get_W(i), s.get_W(j), s_pRemLen[4]);
+			bool bSwap = Merge(pIdx, s.get_Idx(i), s.get_Idx(j), 8);
+			Mix(pW, s_pRemLen[4], pIdx, 16);
+
+			uint32_t iSlot = AllocSlot(4, pW[0]);
+			if (iSlot < s_Slots)
+			{
+				Rec4& r = pDst[iSlot];
+				r.m_Mixed = pW[0] & ((static_cast<uint64_t>(1) << (collisionBitSize * 2)) - 1);
+				r.m_pRef[bSwap] = iRef0 + i;
+				r.m_pRef[!bSwap] = iRef0 + j;
+			}
+		});
+	}
+
+	void BeamHashIII_Solver::Round5(uint32_t iBucket, Scratch& s)
+	{
+		const Rec4* pSrc = reinterpret_cast<const Rec4*>(m_pB.get()) + iBucket * s_BucketSize;
+
+		uint32_t n = get_Count(4, iBucket);
+		for (uint32_t i = 0; i < n; i++)
+			s.set_Key(i, pSrc[i].m_Mixed);
+
+		uint32_t iRef0 = iBucket * s_BucketSize;
+
+		s.ForEachPair(n, [this, pSrc, iRef0](uint32_t i, uint32_t j)
+		{
+			// the final element must be zero
+			if (!((pSrc[i].m_Mixed ^ pSrc[j].m_Mixed) >> collisionBitSize))
+				OnCandidate(iRef0 + i, iRef0 + j);
+		});
+	}
+
+	void BeamHashIII_Solver::OnCandidate(uint32_t iRef0, uint32_t iRef1)
+	{
+		const Rec3* pT3 = reinterpret_cast<const Rec3*>(m_pA.get());
+		const Rec4* pT4 = reinterpret_cast<const Rec4*>(m_pB.get());
+
+		uint32_t pHalf[2][16];
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			const Rec4& r = pT4[i ? iRef1 : iRef0];
+			memcpy(pHalf[i], pT3[r.m_pRef[0]].m_pIdx, sizeof(Rec3::m_pIdx));
+			memcpy(pHalf[i] + 8, pT3[r.m_pRef[1]].m_pIdx, sizeof(Rec3::m_pIdx));
+		}
+
+		if (!IsDistinct(pHalf[0], pHalf[1], 16))
+			return;
+
+		uint32_t pIdx[32];
+		Merge(pIdx, pHalf[0], pHalf[1], 16);
+
+		// same as GetMinimalFromIndices: 25-bit indices, little-endian, followed by the extra nonce
+		Solution sol;
+		sol.fill(0);
+
+		for (uint32_t i = 0; i < _countof(pIdx); i++)
+		{
+			uint32_t nPos = i * s_IndexBits;
+			uint64_t val = static_cast<uint64_t>(pIdx[i]) << (nPos & 7);
+			for (uint32_t iByte = nPos >> 3; val; iByte++, val >>= 8)
+				sol[iByte] |= static_cast<uint8_t>(val);
+		}
+
+		std::scoped_lock<std::mutex> scope(m_mxSolutions);
+		m_vSolutions.push_back(sol);
+	}
+
+} // namespace beam
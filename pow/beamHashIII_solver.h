@@ -0,0 +1,101 @@
+// Copyright 2020 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "crypto/powScheme.h"
+
+namespace beam
+{
+	// CPU solver for BeamHash III, should find the same solutions as BeamHash_III::OptimisedSolve (except the invalid ones with repeated indices),
+	// run pow/unittests/beamhash_test to cross-check. Used by Block::PoW::Solve only if built with BEAM_BEAMHASH3_CPU_SOLVER.
+	//
+	// The lists of each round are kept in fixed-size buckets by the lower half of the collision bits, so that
+	// a bucket is collided within a small (L2-sized) per-thread scratch, sorted by the upper half with a counting sort.
+	// Records are flat and minimal: the seed elements are regenerated from their indices, and the 2nd round ones are restored
+	// from the indices and the mixed word instead of being stored. The tables (~3.4GB) are allocated once and reused
+	// by the subsequent attempts.
+	//
+	// If an Executor is set for the calling thread, its threads cooperate on the same nonce.
+	class BeamHashIII_Solver
+	{
+	public:
+		static const uint32_t s_SolutionBytes = 104;
+		typedef std::array<uint8_t, s_SolutionBytes> Solution;
+
+		typedef std::function<bool(const std::vector<uint8_t>&)> ValidFn;
+		typedef std::function<bool()> CancelFn;
+
+		BeamHashIII_Solver();
+		~BeamHashIII_Solver();
+
+		// Reports the found solutions until one is accepted. Throws SolverCancelledException if cancelled.
+		bool Solve(const blake2b_state&, const ValidFn&, const CancelFn&);
+
+		// Number of the solutions found by the last Solve(), including the rejected ones
+		uint32_t get_LastSolutions() const { return m_nLastSolutions; }
+
+		static size_t get_MemorySize();
+		void Release(); // free the tables, they're re-allocated on the next Solve()
+
+	private:
+		static const uint32_t s_BucketBits = 12;
+		static const uint32_t s_Buckets = 1U << s_BucketBits;
+		static const uint32_t s_BucketSize = 8704; // 8192 on average, ~5.5 std deviations above. Excess elements are dropped
+		static const uint32_t s_Slots = s_Buckets * s_BucketSize;
+		static const uint32_t s_Tables = 5;
+
+		struct Rec1;
+		struct Rec2;
+		struct Rec3;
+		struct Rec4;
+		struct Scratch;
+		struct Task;
+
+		uint64_t m_pPrePow[4];
+
+		std::unique_ptr<uint64_t[]> m_pA; // round 1 list, then round 3
+		std::unique_ptr<uint64_t[]> m_pB; // seed list, then round 2, then round 4
+		std::unique_ptr<std::atomic<uint32_t>[]> m_pCount; // per-table bucket fill
+
+		std::vector<Scratch> m_vScratch; // per thread
+
+		std::mutex m_mxSolutions;
+		std::vector<Solution> m_vSolutions;
+		uint32_t m_nLastSolutions = 0;
+
+		void Allocate();
+		uint32_t get_Count(uint32_t iTable, uint32_t iBucket) const;
+		uint32_t AllocSlot(uint32_t iTable, uint64_t nMixed);
+
+		void Seed(uint64_t* pW, uint32_t nIdx) const;
+		void Restore(uint64_t* pW, uint64_t nMixed, const uint32_t* pIdx, uint32_t iRound) const;
+
+		void RunPart(uint32_t iRound, uint32_t i0, uint32_t nCount, Scratch&);
+		void Generate(uint32_t i0, uint32_t nCount);
+		void Round1(uint32_t iBucket, Scratch&);
+		void Round2(uint32_t iBucket, Scratch&);
+		void Round3(uint32_t iBucket, Scratch&);
+		void Round4(uint32_t iBucket, Scratch&);
+		void Round5(uint32_t iBucket, Scratch&);
+		void OnCandidate(uint32_t iRef0, uint32_t iRef1);
+	};
+
+} // namespace beam
@@ -65,6 +65,9 @@ public:
 
     virtual void get_last_found_block(std::string& jobID, Height& jobHeight, Block::PoW& pow) = 0;
 
+    // true if the PoW of the last found block was already checked against its job, so the caller may skip the check
+    virtual bool is_last_found_block_verified() const { return false; }
+
     virtual void stop_current() = 0;
 
     virtual void stop() = 0;
@@ -17,6 +17,7 @@
 #include "utility/io/sslserver.h"
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/trim.hpp>
+#include <algorithm>
 #include <fstream>
 
 #ifndef LOG_VERBOSE_ENABLED
@@ -38,8 +39,12 @@ namespace stratum {
 
 static const uint64_t SERVER_RESTART_TIMER = 1;
 static const uint64_t ACL_REFRESH_TIMER = 2;
+static const uint64_t STATS_TIMER = 3;
 static const unsigned SERVER_RESTART_INTERVAL = 1000;
 static const unsigned ACL_REFRESH_INTERVAL = 5000;
+static const unsigned STATS_INTERVAL = 60000;
+static const size_t MAX_RECENT_JOBS = 64; // as the node keeps
+static const size_t MAX_PENDING_SHARES = 16; // per connection, then it's not read until the results are sent
 
 static const char STS[] = "stratum server ";
 
@@ -51,16 +56,25 @@ Server::Server(const IExternalPOW::Options& o, io::Reactor& reactor, io::Address
     _fw(4096, 0, [this](io::SharedBuffer&& buf){ _currentMsg.push_back(buf); }),
     _acl(o.apiKeysFile),
     _prefixDigits(noncePrefixDigits),
-    _prefixSeed(0)
+    _prefixSeed(0),
+    _loggedSubmitted(0)
 {
     assert(_prefixDigits <= 6);
     _timers.set_timer(SERVER_RESTART_TIMER, 0, BIND_THIS_MEMFN(start_server));
     if (!o.apiKeysFile.empty()) {
         _timers.set_timer(ACL_REFRESH_TIMER, 0, BIND_THIS_MEMFN(refresh_acl));
     }
+    _timers.set_timer(STATS_TIMER, STATS_INTERVAL, BIND_THIS_MEMFN(log_stats));
     if (_prefixDigits > 0) {
         ECC::GenRandom(&_prefixSeed, 8);
     }
+    _submitEvent = io::AsyncEvent::create(reactor, BIND_THIS_MEMFN(on_submit));
+    _verifiedEvent = io::AsyncEvent::create(reactor, BIND_THIS_MEMFN(on_verified));
+}
+
+Server::~Server() {
+    // stop the verifier threads before anything they refer to is destroyed
+    _verifier.reset();
 }
 
 void Server::start_server() {
@@ -150,8 +164,10 @@ bool Server::on_login(uint64_t from, const Login& login) {
 bool Server::on_solution(uint64_t from, const Solution& sol) {
 	BEAM_LOG_DEBUG() << TRACE(sol.nonce) << TRACE(sol.output);
 
+	auto& conn = _connections[from];
+
 	if (_prefixDigits > 0) {
-	    const std::string& nonceprefix = _connections[from]->get_nonceprefix();
+	    const std::string& nonceprefix = conn->get_nonceprefix();
 	    if (
 	        sol.nonce.size() < _prefixDigits ||
 	        memcmp(sol.nonce.c_str(), nonceprefix.c_str(), _prefixDigits) != 0
@@ -159,33 +175,210 @@ bool Server::on_solution(uint64_t from, const Solution& sol) {
             Result res(sol.id, stratum::solution_rejected);
             //res.nonceprefix = nonceprefix;
             append_json_msg(_fw, res);
-            _connections[from]->send_msg(_currentMsg, true, true);
+            conn->send_msg(_currentMsg, true, true);
             _currentMsg.clear();
             return false;
 	    }
 	}
 
-	_recentResult.id = sol.id;
-    sol.fill_pow(_recentResult.pow);
+    auto share = std::make_shared<Share>();
+    share->from = from;
+    share->id = sol.id;
+    share->submitTime = GetTime_ms();
+    share->status = Share::Status::UnknownJob; // the node decides
+
+    auto it = std::find_if(_recentJobs.begin(), _recentJobs.end(), [&sol](const JobInfo& j) { return j.id == sol.id; });
+    if (it != _recentJobs.end()) {
+        share->input = it->input;
+        share->pow = it->pow;
+        share->height = it->height;
+    }
+
+    if (!sol.fill_pow(share->pow)) {
+        share->status = Share::Status::Invalid;
+    } else if (it != _recentJobs.end()) {
+        share->status = Share::Status::Pending;
+
+        if (_toVerify.empty()) {
+            _submitEvent->post();
+        }
+        _toVerify.push_back(share);
+    }
+
+    _shareStats.submitted++;
+    conn->get_shares().push_back(std::move(share));
+
+    if (conn->get_shares().size() == MAX_PENDING_SHARES) {
+        // can't stop reading from within the read callback, the buffer is in use
+        _toPause.push_back(from);
+        _submitEvent->post();
+    }
+
+    return process_shares(from);
+}
+
+struct Server::VerifyTask : public Executor::TaskAsync {
+    Server* server;
+    std::vector<Share::Ptr> shares;
+
+    void Exec(Executor::Context&) override {
+        for (auto& s : shares) {
+            s->powValid = Rules::get().FakePoW || s->pow.IsValid(s->input.m_pData, s->input.nBytes, s->height);
+        }
+
+        std::unique_lock<std::mutex> lock(server->_verifiedMutex);
+
+        if (server->_verified.empty()) {
+            server->_verifiedEvent->post();
+        }
+        server->_verified.insert(server->_verified.end(), shares.begin(), shares.end());
+    }
+};
+
+void Server::on_submit() {
+    for (auto from : _toPause) {
+        auto it = _connections.find(from);
+        if (it != _connections.end() && it->second->get_shares().size() >= MAX_PENDING_SHARES) {
+            it->second->set_reading(false);
+            _shareStats.paused++;
+        }
+    }
+    _toPause.clear();
+
+    if (_toVerify.empty()) return;
+
+    if (!_verifier) {
+        _verifier = std::make_unique<ExecutorMT_R>();
+    }
+
+    // one batch per thread
+    uint32_t threads = _verifier->get_Threads();
+    size_t batchSize = (_toVerify.size() + threads - 1) / threads;
+
+    for (size_t i = 0; i < _toVerify.size(); i += batchSize) {
+        auto task = std::make_unique<VerifyTask>();
+        task->server = this;
+        task->shares.assign(_toVerify.begin() + i, _toVerify.begin() + std::min(i + batchSize, _toVerify.size()));
+        _verifier->Push(std::move(task));
+    }
+
+    _toVerify.clear();
+}
+
+void Server::on_verified() {
+    std::vector<Share::Ptr> verified;
+    {
+        std::unique_lock<std::mutex> lock(_verifiedMutex);
+        verified.swap(_verified);
+    }
+
+    for (auto& s : verified) {
+        s->status = s->powValid ? Share::Status::Valid : Share::Status::Invalid;
+    }
+
+    for (auto& s : verified) {
+        if (!process_shares(s->from)) {
+            on_bad_peer(s->from);
+        }
+    }
+}
+
+bool Server::process_shares(uint64_t from) {
+    while (true) {
+        auto it = _connections.find(from);
+        if (it == _connections.end()) {
+            return true; // already gone, the results are dropped
+        }
+
+        auto& shares = it->second->get_shares();
+        if (shares.empty() || Share::Status::Pending == shares.front()->status) {
+            if (shares.size() < MAX_PENDING_SHARES) {
+                it->second->set_reading(true);
+            }
+            return true;
+        }
+
+        Share::Ptr share = std::move(shares.front());
+        shares.pop_front();
+
+        if (!send_share_result(from, *share)) {
+            return false;
+        }
+    }
+}
+
+bool Server::send_share_result(uint64_t from, const Share& share) {
+    IExternalPOW::BlockFoundResult result = IExternalPOW::solution_rejected;
+
+    if (Share::Status::Invalid == share.status) {
+        BEAM_LOG_INFO() << STS << "invalid solution to " << share.id << " from " << io::Address::from_u64(from);
+    } else {
+        _recentResult.id = share.id;
+        _recentResult.pow = share.pow;
+        _recentResult.verified = (Share::Status::Valid == share.status);
+
+        BEAM_LOG_INFO() << STS << "solution to " << share.id << " from " << io::Address::from_u64(from);
+        result = _recentResult.onBlockFound();
+    }
 
-    BEAM_LOG_INFO() << STS << "solution to " << sol.id << " from " << io::Address::from_u64(from);
-	IExternalPOW::BlockFoundResult result = _recentResult.onBlockFound();
     stratum::ResultCode stratumCode = stratum::solution_rejected;
     if (result == IExternalPOW::solution_accepted) {
         stratumCode = stratum::solution_accepted;
-    } else if (result == IExternalPOW::solution_expired) {
-        stratumCode = stratum::solution_expired;
+        _shareStats.accepted++;
+    } else {
+        if (result == IExternalPOW::solution_expired) {
+            stratumCode = stratum::solution_expired;
+        }
+        _shareStats.rejected++;
     }
-    Result res(sol.id, stratumCode);
+
+    uint32_t latency = GetTime_ms() - share.submitTime;
+    _shareStats.totalLatencyMsec += latency;
+    _shareStats.maxLatencyMsec = std::max(_shareStats.maxLatencyMsec, latency);
+
+    // the callback may have changed the connections
+    auto it = _connections.find(from);
+    if (it == _connections.end()) {
+        return true;
+    }
+
+    Result res(share.id, stratumCode);
     if (result == IExternalPOW::solution_accepted) {
         res.blockhash = result._blockhash;
     }
     append_json_msg(_fw, res);
-    bool sent = _connections[from]->send_msg(_currentMsg, true);
+    bool sent = it->second->send_msg(_currentMsg, true);
     _currentMsg.clear();
     return sent;
 }
 
+Server::ShareStats Server::get_share_stats() const {
+    ShareStats stats = _shareStats;
+    for (const auto& p : _connections) {
+        stats.pending += static_cast<uint32_t>(p.second->get_shares().size());
+    }
+    return stats;
+}
+
+void Server::log_stats() {
+    ShareStats stats = get_share_stats();
+    if (stats.submitted != _loggedSubmitted) {
+        uint64_t done = stats.accepted + stats.rejected;
+        BEAM_LOG_INFO() << STS << "shares: "
+            << (stats.submitted - _loggedSubmitted) * 1000 / STATS_INTERVAL << "/sec"
+            << ", submitted=" << stats.submitted
+            << ", accepted=" << stats.accepted
+            << ", rejected=" << stats.rejected
+            << ", pending=" << stats.pending
+            << ", paused=" << stats.paused
+            << ", avg latency=" << (done ? stats.totalLatencyMsec / done : 0) << " msec"
+            << ", max latency=" << stats.maxLatencyMsec << " msec";
+
+        _loggedSubmitted = stats.submitted;
+    }
+    _timers.set_timer(STATS_TIMER, STATS_INTERVAL, BIND_THIS_MEMFN(log_stats));
+}
+
 void Server::on_bad_peer(uint64_t from) {
     BEAM_LOG_INFO() << STS << "-peer " << io::Address::from_u64(from);
     _connections.erase(from);
@@ -203,6 +396,11 @@ void Server::new_job(
     _recentResult.onBlockFound = callback;
     _recentResult.height = height;	
 
+    _recentJobs.push_front(JobInfo{ id, input, pow, height });
+    if (_recentJobs.size() > MAX_RECENT_JOBS) {
+        _recentJobs.pop_back();
+    }
+
     BEAM_LOG_INFO() << STS << "new job " << id << " will be sent to " << _connections.size() << " connected peers";
 
     Job jobMsg(id, input, pow, height);
@@ -230,6 +428,10 @@ void Server::get_last_found_block(std::string& jobID, Height& jobHeight, Block::
     pow = _recentResult.pow;
 }
 
+bool Server::is_last_found_block_verified() const {
+    return _recentResult.verified;
+}
+
 void Server::stop_current() {
     _recentJob.id.clear();
 }
@@ -289,7 +491,8 @@ Server::Connection::Connection(
     _nonceprefix(std::move(nonceprefix)),
     _stream(std::move(newStream)),
     _lineReader(BIND_THIS_MEMFN(on_raw_message)),
-    _loggedIn(false)
+    _loggedIn(false),
+    _reading(true)
 {
     _stream->enable_keepalive(2);
     _stream->enable_read(BIND_THIS_MEMFN(on_stream_data));
@@ -317,6 +520,16 @@ bool Server::Connection::send_msg(const io::SerializedMsg& msg, bool onlyIfLogge
     return sent;
 }
 
+void Server::Connection::set_reading(bool reading) {
+    if (_reading == reading || !_stream) return;
+    _reading = reading;
+    if (reading) {
+        _stream->enable_read(BIND_THIS_MEMFN(on_stream_data));
+    } else {
+        _stream->disable_read();
+    }
+}
+
 bool Server::Connection::on_message(const stratum::Login& login) {
     return _owner.on_login(_id, login);
 }
@@ -18,8 +18,11 @@
 #include "p2p/line_protocol.h"
 #include "utility/io/tcpserver.h"
 #include "utility/io/coarsetimer.h"
+#include "utility/io/asyncevent.h"
 #include <set>
 #include <map>
+#include <deque>
+#include <mutex>
 
 namespace beam { namespace stratum {
 
@@ -34,8 +37,36 @@ struct ConnectionToServer {
 class Server : public IExternalPOW, public ConnectionToServer {
 public:
     Server(const IExternalPOW::Options& o, io::Reactor& reactor, io::Address listenTo, unsigned noncePrefixDigits);
+    ~Server() override;
+
+    struct ShareStats {
+        uint64_t submitted = 0;
+        uint64_t accepted = 0; // valid PoW, handed over to the node
+        uint64_t rejected = 0;
+        uint64_t totalLatencyMsec = 0; // from submit till the result is sent
+        uint32_t maxLatencyMsec = 0;
+        uint32_t pending = 0;
+        uint64_t paused = 0; // times a connection wasn't read due to too many pending shares
+    };
+
+    ShareStats get_share_stats() const;
 
 private:
+    struct Share {
+        using Ptr = std::shared_ptr<Share>;
+
+        enum struct Status { Pending, Valid, Invalid, UnknownJob };
+
+        uint64_t from;
+        std::string id;
+        Merkle::Hash input;
+        Block::PoW pow;
+        Height height;
+        uint32_t submitTime;
+        Status status;
+        bool powValid = false; // written by the verifier thread, read after the handover only
+    };
+
     class AccessControl {
     public:
         explicit AccessControl(const std::string& keysFileName);
@@ -60,6 +91,11 @@ private:
 
         bool send_msg(const io::SerializedMsg& msg, bool onlyIfLoggedIn, bool shutdown=false);
 
+        // submitted shares, the results are sent in the same order
+        std::deque<Share::Ptr>& get_shares() { return _shares; }
+
+        void set_reading(bool reading);
+
     private:
         bool on_message(const Login& login) override;
 
@@ -79,8 +115,12 @@ private:
         io::TcpStream::Ptr _stream;
         LineReader _lineReader;
         bool _loggedIn;
+        bool _reading;
+        std::deque<Share::Ptr> _shares;
     };
 
+    struct VerifyTask;
+
     void start_server();
 
     void refresh_acl();
@@ -93,6 +133,12 @@ private:
     bool on_solution(uint64_t from, const Solution& solution) override;
     void on_bad_peer(uint64_t from) override;
 
+    void on_submit();
+    void on_verified();
+    bool process_shares(uint64_t from);
+    bool send_share_result(uint64_t from, const Share& share);
+    void log_stats();
+
     void new_job(
         const std::string&,
         const Merkle::Hash& input, const Block::PoW& pow,
@@ -102,6 +148,7 @@ private:
     ) override;
 
     void get_last_found_block(std::string& jobID, Height& jobHeight, Block::PoW& pow) override;
+    bool is_last_found_block_verified() const override;
     void stop_current() override;
     void stop() override;
 
@@ -123,13 +170,36 @@ private:
 		std::string id;
 		Height height;
 		Block::PoW pow;
+		bool verified = false; // checked by the verifier, not passed through with an unknown job
 		BlockFound onBlockFound;
 	} _recentResult;
 
+    struct JobInfo {
+        std::string id;
+        Merkle::Hash input;
+        Block::PoW pow;
+        Height height;
+    };
+    std::deque<JobInfo> _recentJobs; // to verify the solutions before they're handed over
+
     io::SerializedMsg _currentMsg;
     std::vector<uint64_t> _deadConnections;
     unsigned _prefixDigits; // nonceprefix hex digits, 0..6
     uint64_t _prefixSeed;
+
+    // PoW verification is offloaded from the reactor thread. Shares are accumulated till the next reactor cycle,
+    // and verified in batches, one per thread. Connections with too many pending shares are not read meanwhile.
+    std::vector<Share::Ptr> _toVerify;
+    std::vector<uint64_t> _toPause;
+    io::AsyncEvent::Ptr _submitEvent;
+
+    std::mutex _verifiedMutex;
+    std::vector<Share::Ptr> _verified;
+    io::AsyncEvent::Ptr _verifiedEvent;
+
+    ShareStats _shareStats;
+    uint64_t _loggedSubmitted;
+    std::unique_ptr<ExecutorMT_R> _verifier;
 };
 
 }} //namespaces
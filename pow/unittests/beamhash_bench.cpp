@@ -0,0 +1,91 @@
+// Copyright 2020 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "core/block_crypt.h"
+#include "pow/beamHashIII_solver.h"
+#include "3rdparty/crypto/beamHashIII.h"
+#include "utility/test_helpers.h"
+#include <iostream>
+#include <string>
+
+// BeamHash III CPU solver benchmark, all the solutions of each nonce are found and verified.
+// usage: beamhash_bench [nonces] [threads]
+// With threads == 0 the nonce is solved on the main thread only, otherwise the executor threads cooperate on it.
+// The 1st nonce also includes committing the solver tables.
+
+using namespace beam;
+
+int main(int argc, char* argv[])
+{
+    uint32_t nNonces = (argc > 1) ? std::stoul(argv[1]) : 4;
+    uint32_t nThreads = (argc > 2) ? std::stoul(argv[2]) : 0;
+
+    ExecutorMT_R exec;
+    std::unique_ptr<Executor::Scope> pScope;
+    if (nThreads)
+    {
+        exec.set_Threads(nThreads);
+        pScope = std::make_unique<Executor::Scope>(exec);
+    }
+
+    std::cout << "BeamHash III solver, memory: " << (BeamHashIII_Solver::get_MemorySize() >> 20) << " MB, threads: " << nThreads << std::endl;
+
+    BeamHash_III bh;
+    BeamHashIII_Solver solver;
+
+    const uint8_t pInput[] = { 1, 2, 3, 4, 56 };
+    uint32_t nValid = 0, nInvalid = 0;
+    uint64_t nTotal_us = 0;
+
+    for (uint64_t nonce = 0; nonce < nNonces; nonce++)
+    {
+        blake2b_state state;
+        bh.InitialiseState(state);
+        blake2b_update(&state, pInput, sizeof(pInput));
+        blake2b_update(&state, reinterpret_cast<const uint8_t*>(&nonce), sizeof(nonce));
+
+        uint32_t nValidNonce = 0;
+
+        helpers::StopWatch sw;
+        sw.start();
+
+        solver.Solve(state, [&](const std::vector<uint8_t>& sol)
+        {
+            if (bh.IsValidSolution(state, sol))
+                nValidNonce++;
+            else
+                nInvalid++;
+            return false; // continue to the next one
+        },
+        []() { return false; });
+
+        sw.stop();
+        nTotal_us += sw.microseconds();
+        nValid += nValidNonce;
+
+        std::cout << "nonce " << nonce << ": " << nValidNonce << " solutions, " << sw.milliseconds() << " ms" << std::endl;
+    }
+
+    if (nTotal_us)
+        std::cout << "Total: " << nValid << " solutions, " << (nValid * 1000000.0 / nTotal_us) << " sol/s, "
+            << (nNonces * 1000000.0 / nTotal_us) << " nonce/s" << std::endl;
+
+    if (nInvalid)
+    {
+        std::cout << "Invalid solutions: " << nInvalid << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Copyright 2020 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "core/block_crypt.h"
+#include "pow/beamHashIII_solver.h"
+#include "3rdparty/crypto/beamHashIII.h"
+#include <iostream>
+#include <set>
+#include <thread>
+
+// BeamHash III CPU solver vs the reference one (BeamHash_III::OptimisedSolve).
+// Needs ~3.4GB of RAM for the solver, and more for the reference, they don't run simultaneously. Takes minutes, hence not in ctest.
+
+using namespace beam;
+
+namespace
+{
+    typedef std::set<std::vector<uint8_t> > SolutionSet;
+
+    int g_TestsFailed = 0;
+
+    void TestFailed(const char* szExpr, uint32_t nLine)
+    {
+        g_TestsFailed++;
+        std::cout << "Test failed! Line=" << nLine << ", Expression: " << szExpr << std::endl;
+    }
+
+#define verify_test(x) \
+    do { \
+        if (!(x)) \
+            TestFailed(#x, __LINE__); \
+    } while (false)
+
+    void InitState(BeamHash_III& bh, blake2b_state& state, uint64_t nonce)
+    {
+        const uint8_t pInput[] = { 1, 2, 3, 4, 56 };
+
+        bh.InitialiseState(state);
+        blake2b_update(&state, pInput, sizeof(pInput));
+        blake2b_update(&state, reinterpret_cast<const uint8_t*>(&nonce), sizeof(nonce));
+    }
+
+    uint32_t TestNonce(BeamHashIII_Solver& solver, uint64_t nonce)
+    {
+        BeamHash_III bh;
+        blake2b_state state;
+        InitState(bh, state, nonce);
+
+        SolutionSet setSolver;
+        solver.Solve(state, [&](const std::vector<uint8_t>& sol)
+        {
+            verify_test(bh.IsValidSolution(state, sol));
+            verify_test(setSolver.insert(sol).second); // no duplicates
+            return false; // continue to the next one
+        },
+        []() { return false; });
+
+        verify_test(solver.get_LastSolutions() == setSolver.size());
+
+        // free the tables before the reference solver allocates its own
+        solver.Release();
+
+        SolutionSet setRef;
+        bh.OptimisedSolve(state, [&](const std::vector<uint8_t>& sol)
+        {
+            // the reference solver reports the ones with repeated indices as well
+            if (bh.IsValidSolution(state, sol))
+                setRef.insert(sol);
+            return false;
+        },
+        [](SolverCancelCheck) { return false; });
+
+        std::cout << "nonce " << nonce << ": " << setSolver.size() << " solutions, reference: " << setRef.size() << std::endl;
+
+        verify_test(setSolver == setRef);
+        return static_cast<uint32_t>(setRef.size());
+    }
+
+    void TestSolver()
+    {
+        ExecutorMT_R exec;
+        exec.set_Threads(std::max(std::thread::hardware_concurrency(), 1U));
+        Executor::Scope scope(exec);
+
+        BeamHashIII_Solver solver;
+
+        // ~2 solutions per nonce on average, make sure some were compared
+        uint32_t nSolutions = 0;
+        for (uint64_t nonce = 0; (nonce < 4) && !nSolutions; nonce++)
+            nSolutions += TestNonce(solver, nonce);
+
+        verify_test(nSolutions > 0);
+
+        // the solutions don't depend on the block validation either
+        Block::PoW pow;
+        ZeroObject(pow);
+        const uint8_t pInput[] = { 7, 8, 9 };
+        const Height h = Rules::get().pForks[2].m_Height;
+
+        verify_test(pow.Solve(pInput, sizeof(pInput), h));
+        verify_test(pow.IsValid(pInput, sizeof(pInput), h));
+
+        Block::PoW::ReleaseSolver();
+    }
+
+} // namespace
+
+int main()
+{
+    TestSolver();
+    return g_TestsFailed ? -1 : 0;
+}
@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include "pow/stratum.h"
+#include "pow/stratum_server.h"
 #include "core/ecc.h"
 #include "utility/io/json_serializer.h"
+#include "utility/io/timer.h"
 #include "p2p/line_protocol.h"
 #include "utility/helpers.h"
 #include "utility/logger.h"
@@ -106,6 +108,173 @@ void gen_examples() {
     reader.new_data_from_stream((void*)buf.data, buf.size);
 }
 
+// submits a burst of shares on one connection, mixing the known jobs (verified asynchronously)
+// and the unknown ones (passed through), the results must come in the submit order
+class ServerTest : public stratum::ParserCallback {
+public:
+    explicit ServerTest(io::Reactor& reactor) :
+        _reactor(reactor),
+        _proto(
+            [this](void* data, size_t size) { return stratum::parse_json_msg(data, size, *this); },
+            [this](io::SharedBuffer&& fragment) { _out.push_back(fragment); }
+        ),
+        _timer(io::Timer::create(reactor)),
+        _timeout(io::Timer::create(reactor))
+    {
+        _server = std::make_unique<stratum::Server>(IExternalPOW::Options(), reactor, _address, 0);
+
+        Block::PoW pow;
+        ZeroObject(pow);
+        for (const char* id : { "1", "2", "3" }) {
+            Merkle::Hash input;
+            ECC::GenRandom(input);
+            get_pow().new_job(id, input, pow, 100, BIND_THIS_MEMFN(on_block_found), []() { return false; });
+        }
+
+        _timer->start(100, false, [this]() {
+            _reactor.tcp_connect(_address, 1, BIND_THIS_MEMFN(on_connected));
+        });
+        _timeout->start(20000, false, [this]() {
+            BEAM_LOG_ERROR() << "stratum server test timed out, results=" << _results.size();
+            ++_nErrors;
+            _reactor.stop();
+        });
+    }
+
+    int get_errors() const { return _nErrors; }
+
+private:
+    IExternalPOW& get_pow() { return *_server; } // as the node sees it
+
+    void on_connected(uint64_t, io::TcpStream::Ptr&& newStream, io::ErrorCode errorCode) {
+        if (errorCode != 0) {
+            BEAM_LOG_ERROR() << "cannot connect: " << io::error_str(errorCode);
+            ++_nErrors;
+            _reactor.stop();
+            return;
+        }
+        _stream = std::move(newStream);
+        _stream->enable_read([this](io::ErrorCode code, void* data, size_t size) {
+            if (code != 0) {
+                BEAM_LOG_ERROR() << "disconnected: " << io::error_str(code);
+                ++_nErrors;
+                _reactor.stop();
+                return false;
+            }
+            return _proto.new_data_from_stream(data, size);
+        });
+
+        append_json_msg(_proto, stratum::Login("key"));
+
+        // all in one write, more than the server keeps pending, so the connection is paused
+        std::vector<std::string> ids = { "1", "u1", "2", "u2" };
+        for (int i = 0; i < 40; i++) {
+            ids.push_back((i % 10) ? "3" : "u3");
+        }
+        submit(ids);
+    }
+
+    void submit(const std::vector<std::string>& ids) {
+        for (const auto& id : ids) {
+            Block::PoW pow;
+            ZeroObject(pow);
+            ECC::GenRandom(&pow.m_Nonce, Block::PoW::NonceType::nBytes);
+            append_json_msg(_proto, stratum::Solution(id, pow));
+            _expected.push_back(id);
+        }
+        _proto.finalize();
+        _stream->write(_out);
+        _out.clear();
+    }
+
+    IExternalPOW::BlockFoundResult on_block_found() {
+        std::string id;
+        Height h = 0;
+        Block::PoW pow;
+        get_pow().get_last_found_block(id, h, pow);
+
+        bool unknownJob = (id[0] == 'u');
+        if (get_pow().is_last_found_block_verified() == unknownJob) {
+            BEAM_LOG_ERROR() << "job " << id << ": verified flag mismatch";
+            ++_nErrors;
+        }
+        return unknownJob ? IExternalPOW::solution_rejected : IExternalPOW::solution_accepted;
+    }
+
+    bool on_message(const stratum::Job&) override {
+        return true;
+    }
+
+    bool on_message(const stratum::Result& res) override {
+        if (res.id == "login") {
+            return true;
+        }
+
+        size_t i = _results.size();
+        _results.push_back(res.id);
+        if (i >= _expected.size() || _expected[i] != res.id) {
+            BEAM_LOG_ERROR() << "result " << i << " is for " << res.id << ", out of order";
+            ++_nErrors;
+        }
+
+        auto expectedCode = (res.id[0] == 'u') ? stratum::solution_rejected : stratum::solution_accepted;
+        if (res.code != expectedCode) {
+            BEAM_LOG_ERROR() << "result " << i << " has code " << res.code;
+            ++_nErrors;
+        }
+
+        if (_results.size() == _expected.size()) {
+            auto stats = _server->get_share_stats();
+            if (stats.pending != 0 || stats.submitted != _expected.size()) {
+                BEAM_LOG_ERROR() << "unexpected stats, pending=" << stats.pending << ", submitted=" << stats.submitted;
+                ++_nErrors;
+            }
+
+            if (_expected.size() == 44) {
+                if (!stats.paused) {
+                    BEAM_LOG_ERROR() << "the connection wasn't paused";
+                    ++_nErrors;
+                }
+                // reading is resumed, the next shares are processed as well
+                submit({ "2", "u4", "1" });
+            } else {
+                _reactor.stop();
+            }
+        }
+        return true;
+    }
+
+    bool on_stratum_error(stratum::ResultCode code) override {
+        BEAM_LOG_ERROR() << "stratum error " << code;
+        ++_nErrors;
+        return true;
+    }
+
+    io::Reactor& _reactor;
+    io::Address _address = io::Address::localhost().port(20331);
+    std::unique_ptr<stratum::Server> _server;
+    io::SerializedMsg _out;
+    LineProtocol _proto;
+    io::TcpStream::Ptr _stream;
+    io::Timer::Ptr _timer;
+    io::Timer::Ptr _timeout;
+    std::vector<std::string> _expected;
+    std::vector<std::string> _results;
+    int _nErrors = 0;
+};
+
+int server_test() {
+    // any solution to a known job is valid, the results order doesn't depend on the PoW
+    Rules::get().FakePoW = true;
+
+    io::Reactor::Ptr reactor = io::Reactor::create();
+    io::Reactor::Scope scope(*reactor);
+
+    ServerTest test(*reactor);
+    reactor->run();
+    return test.get_errors();
+}
+
 } //namespace
 
 int main() {
@@ -116,6 +285,7 @@ int main() {
     auto logger = Logger::create(logLevel, logLevel);
     auto res = json_creation_test();
     gen_examples();
+    res += server_test();
     return res;
 }
 
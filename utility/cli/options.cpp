@@ -140,6 +140,7 @@ namespace beam
         const char* OWNER_KEY_REMOVE_EP = "remove_owner";
         const char* OWNER_KEY_REMOVE_ALL = "remove_all_owners";
         const char* MINER_JOB_LATENCY = "miner_job_latency";
+        const char* MINER_JOB_FEE_THRESHOLD = "miner_job_fee_threshold";
         const char* MINE_ONLINE = "mine_online";
         const char* BBS_ENABLE = "bbs_enable";
         const char* NEW_ADDRESS = "new_addr";
@@ -256,6 +257,9 @@ namespace beam
         const char* API_ENABLE_IPFS = "enable_ipfs";
         const char* API_IPFS_STORAGE = "ipfs_storage";
         const char* API_TCP_MAX_LINE = "tcp_max_line";
+        const char* API_READ_THREADS = "read_threads";
+        const char* API_EVENTS_JOURNAL = "events_journal";
+        const char* API_TENANTS = "tenants";
 
         // treasury
         const char* TR_OPCODE = "tr_op";
@@ -425,6 +429,7 @@ namespace beam
             (cli::MINER_KEY, po::value<string>(), "Standalone miner key")
             (cli::KEY_MINE, po::value<string>(), "Standalone miner key (deprecated)")
             (cli::MINER_JOB_LATENCY, po::value<uint32_t>(), "Minimal latency in milliseconds for miner job update upon transaction pool change")
+            (cli::MINER_JOB_FEE_THRESHOLD, po::value<Amount>(), "Minimal fees raise (in groth) for miner job update upon transaction pool change")
             (cli::MINE_ONLINE, po::value<bool>(), "Perfer online mining when owner wallet is conntected")
             (cli::PASS, po::value<string>(), "password for keys")
             (cli::MULTI_OWNER_KEYS, po::value<vector<string> >(), "Extra Owner keys")
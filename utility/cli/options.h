@@ -104,6 +104,7 @@ namespace beam
         extern const char* OWNER_KEY_REMOVE_ALL;
         extern const char* MINER_KEY;
         extern const char* MINER_JOB_LATENCY;
+        extern const char* MINER_JOB_FEE_THRESHOLD;
         extern const char* MINE_ONLINE;
         extern const char* BBS_ENABLE;
         extern const char* NEW_ADDRESS;
@@ -219,6 +220,9 @@ namespace beam
         extern const char* API_ACL_PATH;
         extern const char* API_VERSION;
         extern const char* API_TCP_MAX_LINE;
+        extern const char* API_READ_THREADS;
+        extern const char* API_EVENTS_JOURNAL;
+        extern const char* API_TENANTS;
 
         // treasury
         extern const char* TR_OPCODE;
@@ -55,6 +55,46 @@ bool serialize_json_msg(io::FragmentWriter& packer, const nlohmann::json& o) {
     return result;
 }
 
+struct JsonArrayMsgWriter::Impl {
+    nlohmann::detail::serializer<json> serializer;
+
+    explicit Impl(io::FragmentWriter& packer) : serializer(std::make_shared<JsonOutputAdapter>(packer), ' ') {}
+};
+
+JsonArrayMsgWriter::JsonArrayMsgWriter(io::FragmentWriter& packer, const json& header, const std::string& arrayKey) :
+    _impl(std::make_unique<Impl>(packer)),
+    _packer(packer)
+{
+    // header is small, it's dumped w/o the closing brace and the array is opened in its place
+    std::string prefix = header.dump();
+    assert(!prefix.empty() && prefix.back() == '}');
+    prefix.pop_back();
+    if (prefix.size() > 1) {
+        prefix += ',';
+    }
+    prefix += json(arrayKey).dump();
+    prefix += ":[";
+    _packer.write(prefix.data(), prefix.size());
+}
+
+JsonArrayMsgWriter::~JsonArrayMsgWriter() = default;
+
+void JsonArrayMsgWriter::write(const json& item) {
+    if (!_empty) {
+        static const char comma = ',';
+        _packer.write(&comma, 1);
+    }
+    _empty = false;
+    _impl->serializer.dump(item, false, false, 0);
+}
+
+void JsonArrayMsgWriter::finalize() {
+    // for stratum, as in serialize_json_msg
+    static const char suffix[] = { ']', '}', 10 };
+    _packer.write(suffix, sizeof(suffix));
+    _packer.finalize();
+}
+
 } //namespace
 
 
@@ -15,11 +15,33 @@
 #pragma once
 #include "utility/io/fragment_writer.h"
 #include "nlohmann/json_fwd.hpp"
+#include <memory>
+#include <string>
 
 namespace beam {
 
 // appends json msg to out by fragment writer
 bool serialize_json_msg(io::FragmentWriter& packer, const nlohmann::json& o);
 
+// Writes json msg with a (potentially big) array member item by item, without building the whole tree.
+// The result is the same as of serialize_json_msg() for the header with the array added.
+// On exception the partial message is left in the packer, it's up to the caller to discard it
+class JsonArrayMsgWriter {
+public:
+    JsonArrayMsgWriter(io::FragmentWriter& packer, const nlohmann::json& header, const std::string& arrayKey);
+    ~JsonArrayMsgWriter();
+
+    void write(const nlohmann::json& item);
+
+    /// Closes the array and the message, invokes packer's callback
+    void finalize();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> _impl;
+    io::FragmentWriter& _packer;
+    bool _empty = true;
+};
+
 } //namespace
 
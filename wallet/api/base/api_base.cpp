@@ -115,6 +115,18 @@ namespace beam::wallet
         _handler.sendAPIResponse(error);
     }
 
+    void ApiBase::doArrayResponse(const JsonRpcId& id, const IWalletApiHandler::ArrayFiller& fillArray)
+    {
+        const json header =
+        {
+            {JsonRpcHeader, JsonRpcVersion},
+            {"id", id}
+        };
+
+        BEAM_LOG_VERBOSE() << "Api call result for id " << id << " (array)";
+        _handler.sendAPIArrayResponse(header, "result", fillArray);
+    }
+
     boost::optional<IWalletApi::ApiCallInfo> ApiBase::parseCallInfo(const char* data, size_t size)
     {
         JsonRpcId rpcid;
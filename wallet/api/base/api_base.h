@@ -76,6 +76,9 @@ namespace beam::wallet
 
         void sendError(const JsonRpcId& id, ApiError code, const std::string& data = "");
 
+        // responds with "result" array, items are written by fillArray as they're produced
+        void doArrayResponse(const JsonRpcId& id, const IWalletApiHandler::ArrayFiller& fillArray);
+
         boost::optional<ParseResult> parseAPIRequest(const char* data, size_t size) override;
         ApiSyncMode executeAPIRequest(const char *data, size_t size) override;
         std::string fromError(const std::string& request, ApiError code, const std::string& errorText) override;
@@ -15,7 +15,10 @@
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/trim.hpp>
+#include <chrono>
+#include <deque>
 #include <map>
+#include <mutex>
 
 #ifndef LOG_VERBOSE_ENABLED
 #define LOG_VERBOSE_ENABLED 1
@@ -26,6 +29,7 @@
 #include "utility/cli/options.h"
 #include "utility/helpers.h"
 #include "utility/io/timer.h"
+#include "utility/io/asyncevent.h"
 #include "utility/io/tcpserver.h"
 #include "utility/io/sslserver.h"
 #include "utility/io/json_serializer.h"
@@ -33,11 +37,13 @@
 #include "utility/log_rotation.h"
 #include "http/http_connection.h"
 #include "http/http_msg_creator.h"
+#include "http/http_json_serializer.h"
 #include "p2p/line_protocol.h"
 #include "wallet/core/wallet_db.h"
 #include "wallet/core/wallet_network.h"
 #include "wallet/core/simple_transaction.h"
 #include "wallet/core/node_network.h"
+#include "wallet/core/shared_node_client.h"
 #include "keykeeper/local_private_key_keeper.h"
 #include "wallet/transactions/assets/assets_reg_creators.h"
 #include "wallet/transactions/lelantus/lelantus_reg_creators.h"
@@ -71,6 +77,14 @@ namespace
     const unsigned LOG_ROTATION_PERIOD = 3 * 60 * 60 * 1000; // 3 hours
     const size_t PACKER_FRAGMENTS_SIZE = 4096;
     constexpr size_t LINE_FRAGMENT_SIZE = 4096;
+    const unsigned API_STATS_PERIOD = 60 * 1000; // 1 minute
+
+    // Methods that only read the wallet db. When the read threads are enabled these are executed there,
+    // everything else (and all the methods that modify the wallet) is executed in the reactor thread
+    const std::set<std::string> READ_ONLY_METHODS = { "tx_list", "tx_status", "get_utxo", "wallet_status", "addr_list", "get_asset_info" };
+
+    // Bigger requests are not classified, this avoids parsing them twice
+    constexpr size_t CLASSIFY_MAX_REQUEST_SIZE = 4096;
 
     struct TlsOptions
     {
@@ -135,17 +149,276 @@ namespace
         return ApiACL(keys);
     }
 
+    struct RequestHeader
+    {
+        std::string method;
+        std::string key;
+    };
+
+    RequestHeader peekRequest(const char* data, size_t size, size_t maxSize)
+    {
+        RequestHeader header;
+        if (size > maxSize)
+        {
+            return header;
+        }
+
+        const auto msg = json::parse(data, data + size, nullptr, false);
+        if (msg.is_discarded() || !msg.is_object())
+        {
+            return header;
+        }
+
+        auto getString = [&msg](const char* name) -> std::string {
+            const auto it = msg.find(name);
+            return (it != msg.end() && it->is_string()) ? it->get<std::string>() : std::string();
+        };
+
+        header.method = getString("method");
+        header.key = getString("key");
+        return header;
+    }
+
+    // Wallets hosted in addition to the main one, addressed by the API key
+    struct ApiTenant
+    {
+        IWalletDB::Ptr walletDB;
+        Wallet::Ptr wallet;
+    };
+
+    std::vector<std::pair<std::string, std::string>> loadTenants(const std::string& path)
+    {
+        std::ifstream file(path);
+        std::string line;
+        std::vector<std::pair<std::string, std::string>> tenants;
+        int curLine = 0;
+
+        while (std::getline(file, line))
+        {
+            curLine++;
+            boost::algorithm::trim(line);
+            if (line.empty())
+            {
+                continue;
+            }
+
+            // key:wallet_path, the path may contain ':'
+            const auto pos = line.find(':');
+            std::string key = line.substr(0, pos);
+            std::string walletPath = pos == std::string::npos ? std::string() : line.substr(pos + 1);
+            boost::algorithm::trim(key);
+            boost::algorithm::trim(walletPath);
+
+            if (key.empty() || walletPath.empty())
+            {
+                throw std::runtime_error("Tenants file parsing error, line " + std::to_string(curLine));
+            }
+
+            tenants.emplace_back(key, walletPath);
+        }
+
+        return tenants;
+    }
+
+    // API instances of a connection: the main wallet one and the ones of the tenants addressed via the connection
+    class ConnectionApis
+    {
+    public:
+        ConnectionApis(const std::string& apiVersion, IWalletApiHandler& handler, const ApiInitData& walletData)
+            : _apiVersion(apiVersion)
+            , _handler(handler)
+        {
+            _walletApi = IWalletApi::CreateInstance(apiVersion, handler, walletData);
+        }
+
+        IWalletApi& get(const std::string& tenantKey, const ApiInitData* tenant)
+        {
+            if (!tenant)
+            {
+                return *_walletApi;
+            }
+
+            auto& api = _tenantApis[tenantKey];
+            if (!api)
+            {
+                api = IWalletApi::CreateInstance(_apiVersion, _handler, *tenant);
+            }
+
+            return *api;
+        }
+
+    private:
+        std::string _apiVersion;
+        IWalletApiHandler& _handler;
+        IWalletApi::Ptr _walletApi;
+        std::map<std::string, IWalletApi::Ptr> _tenantApis;
+    };
+
     class IWalletApiServer
     {
     public:
         virtual void closeConnection(uint64_t id) = 0;
+
+        // executes the request in place, or passes it to the read threads (offloaded is set, RunningAsync is returned).
+        // In the latter case the response is delivered later via IServerConnection::onReadResponse
+        virtual ApiSyncMode executeRequest(uint64_t id, ConnectionApis& apis, const char* data, size_t size, bool& offloaded) = 0;
     };
 
     class IServerConnection
     {
     public:
         typedef std::shared_ptr<IServerConnection> Ptr;
+        typedef std::weak_ptr<IServerConnection> WeakPtr;
         virtual ~IServerConnection() = default;
+
+        // response serialized by the read thread
+        virtual void onReadResponse(const io::SerializedMsg& response) = 0;
+    };
+
+    // Executes the read-only API requests. Each thread has its own API instance over a separate wallet db connection,
+    // results are passed back to the reactor thread
+    class ApiReadExecutor
+        : public ExecutorMT_R
+    {
+    public:
+        struct Result
+        {
+            IServerConnection::WeakPtr conn;
+            std::string method;
+            io::SerializedMsg response;
+            uint64_t wait_us = 0;
+            uint64_t exec_us = 0;
+        };
+
+        typedef std::function<void (Result&&)> DoneCallback;
+
+        ApiReadExecutor(io::Reactor& reactor, const std::string& apiVersion, const ApiInitData& init, const std::vector<IWalletDB::Ptr>& readDBs, DoneCallback&& onDone)
+            : _onDone(std::move(onDone))
+        {
+            set_Threads(static_cast<uint32_t>(readDBs.size()));
+
+            for (const auto& db : readDBs)
+            {
+                // no wallet, the read-only methods need only the db
+                ApiInitData workerInit;
+                workerInit.acl = init.acl;
+                workerInit.nodeNetwork = init.nodeNetwork;
+                workerInit.walletDB = db;
+
+                auto& worker = *_workers.emplace_back(std::make_unique<Worker>());
+                worker.walletDB = db;
+                worker.api = IWalletApi::CreateInstance(apiVersion, worker, workerInit);
+            }
+
+            _doneEvent = io::AsyncEvent::create(reactor, BIND_THIS_MEMFN(onDoneEvent));
+        }
+
+        ~ApiReadExecutor()
+        {
+            Stop(); // before the workers are destroyed
+        }
+
+        void push(IServerConnection::WeakPtr&& conn, std::string&& method, const char* data, size_t size)
+        {
+            auto pTask = std::make_unique<Task>(*this);
+            pTask->_request.assign(data, size);
+            pTask->_result.conn = std::move(conn);
+            pTask->_result.method = std::move(method);
+            pTask->_queued = std::chrono::steady_clock::now();
+
+            Push(std::move(pTask));
+        }
+
+    private:
+        struct Worker
+            : public IWalletApiHandler
+        {
+            IWalletDB::Ptr walletDB;
+            IWalletApi::Ptr api;
+            HttpMsgCreator packer{ PACKER_FRAGMENTS_SIZE };
+            io::SerializedMsg response;
+
+            // responses are serialized here as well, the reactor thread only sends them
+            void sendAPIResponse(const json& result) override
+            {
+                serialize_json_msg(response, packer, result);
+            }
+
+            void sendAPIArrayResponse(const json& header, const std::string& arrayKey, const ArrayFiller& fillArray) override
+            {
+                serialize_json_array_msg(response, packer, header, arrayKey, fillArray);
+            }
+        };
+
+        struct Task
+            : public TaskAsync
+        {
+            explicit Task(ApiReadExecutor& owner)
+                : _owner(owner)
+            {
+            }
+
+            void Exec(Context& ctx) override
+            {
+                using namespace std::chrono;
+
+                auto& worker = *_owner._workers[ctx.m_iThread];
+                const auto started = steady_clock::now();
+
+                worker.walletDB->dropCaches(); // the db is modified via the main connection
+                worker.response.clear();
+                worker.api->executeAPIRequest(_request.data(), _request.size());
+
+                if (worker.response.empty())
+                {
+                    // read-only methods are sync, they should've responded (errors as well)
+                    BEAM_LOG_ERROR() << "API read method " << _result.method << " has not called SendAPIResponse";
+                    worker.sendAPIResponse(json::parse(worker.api->fromError(_request, ApiError::InternalErrorJsonRpc, "no response"), nullptr, false));
+                }
+
+                _result.response = std::move(worker.response);
+                _result.wait_us = duration_cast<microseconds>(started - _queued).count();
+                _result.exec_us = duration_cast<microseconds>(steady_clock::now() - started).count();
+
+                _owner.onTaskDone(std::move(_result));
+            }
+
+            ApiReadExecutor& _owner;
+            std::string _request;
+            Result _result;
+            std::chrono::steady_clock::time_point _queued;
+        };
+
+        void onTaskDone(Result&& res)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _done.push_back(std::move(res));
+            }
+
+            _doneEvent->post();
+        }
+
+        void onDoneEvent()
+        {
+            std::vector<Result> done;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                done.swap(_done);
+            }
+
+            for (auto& res : done)
+            {
+                _onDone(std::move(res));
+            }
+        }
+
+        DoneCallback _onDone;
+        std::vector<std::unique_ptr<Worker>> _workers;
+        io::AsyncEvent::Ptr _doneEvent;
+
+        std::mutex _mutex;
+        std::vector<Result> _done;
     };
 
     class WalletApiServer
@@ -162,7 +435,10 @@ namespace
                         io::Address listenTo,
                         const ConnectionOptions& connectionOptions,
                         ApiACL acl,
-                        const std::vector<uint32_t>& whitelist)
+                        const std::vector<uint32_t>& whitelist,
+                        const std::vector<IWalletDB::Ptr>& readDBs,
+                        size_t eventsJournalSize,
+                        const std::map<std::string, ApiTenant>& tenants)
 
             : _apiVersion(apiVersion)
             , _reactor(reactor)
@@ -174,7 +450,35 @@ namespace
             , _acl(acl)
             , _whitelist(whitelist)
         {
+            // must be subscribed before connections to number all the changes they see
+            _eventsJournal = std::make_shared<ApiEventsJournal>(_wallet, eventsJournalSize);
+
+            for (const auto& [key, tenant] : tenants)
+            {
+                // tenant is accessible only with its own key
+                auto& init = _tenants[key];
+                init.acl = ApiACL::value_type{{key, true}};
+                init.walletDB = tenant.walletDB;
+                init.wallet = tenant.wallet;
+                init.contracts = IShadersManager::CreateInstance(*tenant.wallet, "", "", 0);
+                init.nodeNetwork = _network;
+                init.eventsJournal = std::make_shared<ApiEventsJournal>(tenant.wallet, eventsJournalSize);
+            }
+
             start();
+
+            if (!readDBs.empty())
+            {
+                ApiInitData init;
+                init.acl = _acl;
+                init.nodeNetwork = _network;
+
+                _readExecutor = std::make_unique<ApiReadExecutor>(_reactor, _apiVersion, init, readDBs, BIND_THIS_MEMFN(onReadDone));
+                BEAM_LOG_INFO() << "Read-only API methods are executed in " << readDBs.size() << " thread(s)";
+            }
+
+            _statsTimer = io::Timer::create(_reactor);
+            _statsTimer->start(API_STATS_PERIOD, true, BIND_THIS_MEMFN(onStatsTimer));
         }
 
         ~WalletApiServer()
@@ -313,7 +617,87 @@ namespace
             _pendingToClose.push_back(id);
         }
 
+        ApiSyncMode executeRequest(uint64_t id, ConnectionApis& apis, const char* data, size_t size, bool& offloaded) override
+        {
+            // tenants are routed by the key, so all the requests have to be parsed in this case
+            auto request = peekRequest(data, size, _tenants.empty() ? CLASSIFY_MAX_REQUEST_SIZE : size);
+            auto& method = request.method;
+
+            const ApiInitData* tenant = nullptr;
+            if (auto it = _tenants.find(request.key); it != _tenants.end())
+            {
+                tenant = &it->second;
+            }
+
+            auto& api = apis.get(request.key, tenant);
+
+            // read threads serve only the main wallet
+            offloaded = false;
+            if (_readExecutor && !tenant && READ_ONLY_METHODS.count(method))
+            {
+                auto it = _connections.find(id);
+                if (it != _connections.end())
+                {
+                    _walletDB->commitPending(); // recent changes must be visible to the read connections
+                    _readExecutor->push(it->second, std::move(method), data, size);
+
+                    offloaded = true;
+                    return ApiSyncMode::RunningAsync;
+                }
+            }
+
+            const auto started = std::chrono::steady_clock::now();
+            const auto res = api.executeAPIRequest(data, size);
+
+            if (res == ApiSyncMode::DoneSync)
+            {
+                addStats(method, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count(), 0);
+            }
+
+            return res;
+        }
+
     private:
+        struct MethodStats
+        {
+            uint64_t calls = 0;
+            uint64_t total_us = 0;
+            uint64_t max_us = 0;
+            uint64_t wait_us = 0; // time spent in the read queue
+        };
+
+        void addStats(const std::string& method, uint64_t exec_us, uint64_t wait_us)
+        {
+            auto& stats = _stats[method.empty() ? "<unclassified>" : method];
+            stats.calls++;
+            stats.total_us += exec_us;
+            stats.max_us = std::max(stats.max_us, exec_us);
+            stats.wait_us += wait_us;
+        }
+
+        void onStatsTimer()
+        {
+            for (const auto& [method, stats] : _stats)
+            {
+                BEAM_LOG_INFO() << "API " << method
+                    << ": calls=" << stats.calls
+                    << ", avg=" << stats.total_us / stats.calls << "us"
+                    << ", max=" << stats.max_us << "us"
+                    << ", avg wait=" << stats.wait_us / stats.calls << "us";
+            }
+
+            _stats.clear();
+        }
+
+        void onReadDone(ApiReadExecutor::Result&& res)
+        {
+            addStats(res.method, res.exec_us, res.wait_us);
+
+            if (auto conn = res.conn.lock())
+            {
+                conn->onReadResponse(res.response);
+            }
+        }
 
         void checkConnections()
         {
@@ -339,6 +723,7 @@ namespace
                 _walletData->acl         = _acl;
                 _walletData->contracts   = IShadersManager::CreateInstance(*_wallet, "", "", 0);
                 _walletData->nodeNetwork = _network;
+                _walletData->eventsJournal = _eventsJournal;
 
                 #ifdef BEAM_ATOMIC_SWAP_SUPPORT
                 _walletData->swaps = _swapsProvider;
@@ -390,11 +775,11 @@ namespace
         {
         public:
             TcpApiConnection(const std::string& apiVersion, IWalletApiServer& server, io::TcpStream::Ptr&& newStream, ApiInitData& walletData, const ConnectionOptions& options)
-                : _server(server)
+                : _apis(apiVersion, *this, walletData)
+                , _server(server)
                 , _stream(std::move(newStream))
                 , _lineProtocol(BIND_THIS_MEMFN(on_raw_message), BIND_THIS_MEMFN(on_write), LINE_FRAGMENT_SIZE, options.maxLineSize)
             {
-                _walletApi = IWalletApi::CreateInstance(apiVersion, *this, walletData);
                 _stream->enable_keepalive(2);
                 _stream->enable_read(BIND_THIS_MEMFN(on_stream_data));
             }
@@ -404,6 +789,27 @@ namespace
                 serialize_json_msg(_lineProtocol, result);
             }
 
+            void sendAPIArrayResponse(const json& header, const std::string& arrayKey, const ArrayFiller& fillArray) override
+            {
+                // serialized aside, so that nothing is sent if filling fails
+                io::SerializedMsg msg;
+                serialize_json_array_msg(msg, _packer, header, arrayKey, fillArray);
+                _stream->write(msg);
+            }
+
+            void onReadResponse(const io::SerializedMsg& response) override
+            {
+                _readPending = false;
+                _stream->write(response);
+
+                while (!_readPending && !_queued.empty())
+                {
+                    auto request = std::move(_queued.front());
+                    _queued.pop_front();
+                    executeRequest(request.data(), request.size());
+                }
+            }
+
             void on_write(io::SharedBuffer&& msg)
             {
                 _stream->write(msg);
@@ -411,10 +817,23 @@ namespace
 
             bool on_raw_message(void* data, size_t size)
             {
-                _walletApi->executeAPIRequest(static_cast<const char*>(data), size);
+                if (_readPending)
+                {
+                    // keep the responses in the order of requests
+                    _queued.emplace_back(static_cast<const char*>(data), size);
+                }
+                else
+                {
+                    executeRequest(static_cast<const char*>(data), size);
+                }
                 return size > 0;
             }
 
+            void executeRequest(const char* data, size_t size)
+            {
+                _server.executeRequest(_stream->peer_address().u64(), _apis, data, size, _readPending);
+            }
+
             bool on_stream_data(io::ErrorCode errorCode, void* data, size_t size)
             {
                 if (errorCode != 0)
@@ -441,10 +860,13 @@ namespace
             }
 
         private:
-            IWalletApi::Ptr _walletApi;
+            ConnectionApis _apis;
             IWalletApiServer& _server;
             io::TcpStream::Ptr _stream;
             LineProtocol _lineProtocol;
+            HttpMsgCreator _packer{ PACKER_FRAGMENTS_SIZE };
+            bool _readPending = false;
+            std::deque<std::string> _queued;
         };
 
         class HttpApiConnection
@@ -453,13 +875,12 @@ namespace
         {
         public:
             HttpApiConnection(const std::string& apiVersion, IWalletApiServer& server, io::TcpStream::Ptr&& newStream, ApiInitData& walletData, const ConnectionOptions&)
-                : _server(server)
+                : _apis(apiVersion, *this, walletData)
+                , _server(server)
                 , _sendResponseCalled(false)
                 , _msgCreator(2000)
                 , _packer(PACKER_FRAGMENTS_SIZE)
             {
-                _walletApi = IWalletApi::CreateInstance(apiVersion, *this, walletData);
-
                 newStream->enable_keepalive(1);
                 auto peerId = newStream->peer_address().u64();
 
@@ -480,6 +901,23 @@ namespace
                 send(_connection, 200, "OK");
             }
 
+            void sendAPIArrayResponse(const json& header, const std::string& arrayKey, const ArrayFiller& fillArray) override
+            {
+                serialize_json_array_msg(_body, _packer, header, arrayKey, fillArray);
+                _sendResponseCalled = true;
+                send(_connection, 200, "OK");
+            }
+
+            void onReadResponse(const io::SerializedMsg& response) override
+            {
+                if (_connection->is_connected())
+                {
+                    _sendResponseCalled = true;
+                    _body = response;
+                    send(_connection, 200, "OK");
+                }
+            }
+
         private:
             bool on_request(uint64_t id, const HttpMsgReader::Message& msg)
             {
@@ -517,7 +955,8 @@ namespace
                 }
 
                 _sendResponseCalled = false;
-                const auto asyncResult = _walletApi->executeAPIRequest(reinterpret_cast<const char*>(data), size);
+                bool offloaded = false;
+                const auto asyncResult = _server.executeRequest(id, _apis, reinterpret_cast<const char*>(data), size, offloaded);
 
                 if (asyncResult == ApiSyncMode::DoneSync)
                 {
@@ -588,6 +1027,7 @@ namespace
                 _server.closeConnection(_connection->id());
             }
 
+            ConnectionApis      _apis;
             HttpConnection::Ptr _connection;
             IWalletApiServer&   _server;
             bool                _sendResponseCalled;
@@ -595,7 +1035,6 @@ namespace
             HttpMsgCreator      _packer;
             io::SerializedMsg   _headers;
             io::SerializedMsg   _body;
-            IWalletApi::Ptr     _walletApi;
         };
 
         std::string        _apiVersion;
@@ -605,16 +1044,22 @@ namespace
         ConnectionOptions  _connectionOptions;
 
         std::unordered_map<uint64_t, IServerConnection::Ptr> _connections;
+        std::unique_ptr<ApiReadExecutor> _readExecutor;
+
+        std::map<std::string, MethodStats> _stats;
+        io::Timer::Ptr _statsTimer;
 
         IWalletDB::Ptr _walletDB;
         Wallet::Ptr _wallet;
         NodeNetwork::Ptr _network;
+        ApiEventsJournal::Ptr _eventsJournal;
 
         #ifdef BEAM_ATOMIC_SWAP_SUPPORT
         std::shared_ptr<ApiCliSwap> _swapsProvider;
         #endif // BEAM_ATOMIC_SWAP_SUPPORT
 
         std::unique_ptr<ApiInitData> _walletData;
+        std::map<std::string, ApiInitData> _tenants;
         std::vector<uint64_t> _pendingToClose;
         ApiACL _acl;
         std::vector<uint32_t> _whitelist;
@@ -652,12 +1097,15 @@ int main(int argc, char* argv[])
 
         bool useAcl;
         std::string aclPath;
+        std::string tenantsPath;
         std::string whitelist;
         std::string apiVersion;
 
         uint32_t logCleanupPeriod;
         bool enableLelantus = false;
         bool enableBodyRequests = false;
+        uint32_t readThreads;
+        uint32_t eventsJournal;
     } options;
     ConnectionOptions connectionOptions;
 
@@ -683,12 +1131,15 @@ int main(int argc, char* argv[])
             (cli::LOG_CLEANUP_DAYS, po::value<uint32_t>()->default_value(5), "old logfiles cleanup period(days)")
             (cli::API_TCP_MAX_LINE, po::value<size_t>(&connectionOptions.maxLineSize)->default_value(65536), "max line size in TCP mode")
             (cli::REQUEST_BODIES,   po::value<bool>(&options.enableBodyRequests)->default_value(false), "request and parse block bodies on the wallet side")
+            (cli::API_READ_THREADS, po::value<uint32_t>(&options.readThreads)->default_value(0), "number of threads to execute read-only methods (tx_list, get_utxo, etc.) with separate wallet db connections. Set to 0 to execute everything in the main thread")
+            (cli::API_EVENTS_JOURNAL, po::value<uint32_t>(&options.eventsJournal)->default_value(10000), "number of recently changed items (txs, utxos, addresses, assets) kept to resume events subscription after reconnect (see ev_subunsub 'resume_from')")
         ;
 
         po::options_description authDesc("User authorization options");
         authDesc.add_options()
                 (cli::API_USE_ACL, po::value<bool>(&options.useAcl)->default_value(false), "use Access Control List (ACL)")
                 (cli::API_ACL_PATH, po::value<std::string>(&options.aclPath)->default_value("wallet_api.acl"), "path to ACL file")
+                (cli::API_TENANTS, po::value<std::string>(&options.tenantsPath)->default_value(""), "path to the file of additional wallets hosted by the server, each line is 'api_key:wallet_path'. The wallets are opened with the same password, share the node connection and are accessible only with their keys")
         ;
 
         po::options_description tlsDesc("TLS protocol options");
@@ -761,6 +1212,8 @@ int main(int argc, char* argv[])
 
         io::Address node_addr;
         IWalletDB::Ptr walletDB;
+        std::vector<IWalletDB::Ptr> readDBs;
+        std::vector<std::pair<std::string, IWalletDB::Ptr>> tenantDBs;
         ApiACL acl;
         std::vector<uint32_t> whitelist;
 
@@ -850,6 +1303,27 @@ int main(int argc, char* argv[])
             walletDB = WalletDB::open(options.walletPath, pass);
             BEAM_LOG_INFO() << "wallet successfully opened...";
 
+            for (uint32_t i = 0; i < options.readThreads; i++)
+            {
+                readDBs.push_back(WalletDB::open(options.walletPath, pass));
+            }
+
+            if (!options.tenantsPath.empty())
+            {
+                for (const auto& [key, tenantPath] : loadTenants(options.tenantsPath))
+                {
+                    if (!WalletDB::isInitialized(tenantPath))
+                    {
+                        BEAM_LOG_ERROR() << "Tenant wallet not found, path is: " << tenantPath;
+                        return -1;
+                    }
+
+                    tenantDBs.emplace_back(key, WalletDB::open(tenantPath, pass));
+                }
+
+                BEAM_LOG_INFO() << tenantDBs.size() << " tenant wallet(s) successfully opened...";
+            }
+
             // this should be exactly CLI flag value to print correct error messages
             // Rules::CA.Enabled would be checked as well but later
             wallet::g_AssetsEnabled = vm[cli::WITH_ASSETS].as<bool>();
@@ -865,7 +1339,23 @@ int main(int argc, char* argv[])
         auto wallet = std::make_shared<Wallet>(walletDB);
         wallet->EnableBodyRequests(options.enableBodyRequests);
 
-        auto nnet = std::make_shared<NodeNetwork>(*wallet);
+        // With tenants all the wallets share one node connection, each wallet posts its requests via own endpoint
+        SharedNodeClient::Ptr sharedClient;
+        NodeNetwork::Ptr nnet;
+        proto::FlyClient::INetwork::Ptr nodeEndpoint;
+
+        if (!tenantDBs.empty())
+        {
+            sharedClient = std::make_shared<SharedNodeClient>();
+            nnet = sharedClient->getNetwork();
+            nodeEndpoint = sharedClient->addClient(*wallet);
+        }
+        else
+        {
+            nnet = std::make_shared<NodeNetwork>(*wallet);
+            nodeEndpoint = nnet;
+        }
+
         nnet->m_Cfg.m_PollPeriod_ms = options.pollPeriod_ms.value;
         
         if (nnet->m_Cfg.m_PollPeriod_ms)
@@ -892,15 +1382,28 @@ int main(int argc, char* argv[])
         nnet->m_Cfg.m_vNodes.push_back(node_addr);
         nnet->Connect();
 
-        auto wnet = std::make_shared<WalletNetworkViaBbs>(*wallet, nnet, walletDB);
+        auto wnet = std::make_shared<WalletNetworkViaBbs>(*wallet, nodeEndpoint, walletDB);
         wallet->AddMessageEndpoint(wnet);
-        wallet->SetNodeEndpoint(nnet);
+        wallet->SetNodeEndpoint(nodeEndpoint);
 
-        WalletApiServer server(options.apiVersion, walletDB, wallet, nnet, *reactor, listenTo, connectionOptions, acl, whitelist);
+        std::map<std::string, ApiTenant> tenants;
+        for (const auto& [key, tenantDB] : tenantDBs)
+        {
+            auto& tenant = tenants[key];
+            tenant.walletDB = tenantDB;
+            tenant.wallet = std::make_shared<Wallet>(tenantDB);
+            tenant.wallet->EnableBodyRequests(options.enableBodyRequests);
+
+            auto endpoint = sharedClient->addClient(*tenant.wallet);
+            tenant.wallet->AddMessageEndpoint(std::make_shared<WalletNetworkViaBbs>(*tenant.wallet, endpoint, tenantDB));
+            tenant.wallet->SetNodeEndpoint(endpoint);
+        }
+
+        WalletApiServer server(options.apiVersion, walletDB, wallet, nnet, *reactor, listenTo, connectionOptions, acl, whitelist, readDBs, options.eventsJournal, tenants);
 
         #ifdef BEAM_ATOMIC_SWAP_SUPPORT
         RegisterSwapTxCreators(wallet, walletDB);
-        server.initSwapFeature(nnet, *wnet);
+        server.initSwapFeature(nodeEndpoint, *wnet);
         #endif
 
         #ifdef BEAM_IPFS_SUPPORT
@@ -924,7 +1427,7 @@ int main(int argc, char* argv[])
 
 #ifdef BEAM_ASSET_SWAP_SUPPORT
             wallet->RegisterTransactionType(TxType::DexSimpleSwap, std::make_shared<DexTransaction::Creator>(walletDB));
-            server.initDexFeature(nnet, *wnet);
+            server.initDexFeature(nodeEndpoint, *wnet);
 #endif  // BEAM_ASSET_SWAP_SUPPORT
         }
 
@@ -933,6 +1436,22 @@ int main(int argc, char* argv[])
             lelantus::RegisterCreators(*wallet, walletDB);
         }
 
+        // Tenants support the basic transactions only, swaps, DEX and IPFS are served for the main wallet
+        for (auto& [key, tenant] : tenants)
+        {
+            if (Rules::get().CA.Enabled && wallet::g_AssetsEnabled)
+            {
+                RegisterAllAssetCreators(*tenant.wallet);
+            }
+
+            if (options.enableLelantus)
+            {
+                lelantus::RegisterCreators(*tenant.wallet, tenant.walletDB);
+            }
+
+            tenant.wallet->ResumeAllTransactions();
+        }
+
         // All TxCreators must be registered by this point
         wallet->ResumeAllTransactions();
         io::Reactor::get_Current().run();
@@ -0,0 +1,204 @@
+// Copyright 2020 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "events_journal.h"
+#include <algorithm>
+
+namespace beam::wallet
+{
+    ApiEventsJournal::ApiEventsJournal(Wallet::Ptr wallet, size_t maxItems)
+        : _wallet(std::move(wallet))
+        , _maxItems(maxItems)
+    {
+        // Sequence is started from the current time so that after restart
+        // sequences from the previous run are not mistaken for the new ones.
+        // 2^20 changes per second of uptime, still fits into JS safe integers
+        _lastSeq = static_cast<uint64_t>(getTimestamp()) << 20;
+        _wallet->Subscribe(this);
+    }
+
+    ApiEventsJournal::~ApiEventsJournal()
+    {
+        _wallet->Unsubscribe(this);
+    }
+
+    void ApiEventsJournal::Subscribe(IWalletObserver* observer)
+    {
+        assert(std::find(_subscribers.begin(), _subscribers.end(), observer) == _subscribers.end());
+        _subscribers.push_back(observer);
+    }
+
+    void ApiEventsJournal::Unsubscribe(IWalletObserver* observer)
+    {
+        auto it = std::find(_subscribers.begin(), _subscribers.end(), observer);
+        assert(it != _subscribers.end());
+        _subscribers.erase(it);
+    }
+
+    template <typename Fn>
+    void ApiEventsJournal::forEachSubscriber(Fn&& fn)
+    {
+        // Observers may subscribe or unsubscribe while handling the event. Iterate over a copy, skip the ones
+        // unsubscribed meanwhile. The new ones get the next events only
+        auto subscribers = _subscribers;
+        for (const auto sub : subscribers)
+        {
+            if (std::find(_subscribers.begin(), _subscribers.end(), sub) != _subscribers.end())
+            {
+                fn(*sub);
+            }
+        }
+    }
+
+    uint64_t ApiEventsJournal::get_Seq() const
+    {
+        return _dispatchSeq ? _dispatchSeq : _lastSeq;
+    }
+
+    bool ApiEventsJournal::CanResume(uint64_t seq) const
+    {
+        if (seq == _lastSeq)
+        {
+            return true;
+        }
+
+        if (seq > _lastSeq || _entries.empty())
+        {
+            return false;
+        }
+
+        return seq + 1 >= _entries.front().seq;
+    }
+
+    void ApiEventsJournal::Replay(uint64_t seq, IWalletObserver& observer)
+    {
+        assert(CanResume(seq));
+
+        auto it = std::upper_bound(_entries.begin(), _entries.end(), seq, [](uint64_t s, const Entry& e) {
+            return s < e.seq;
+        });
+
+        // new entries can be appended while replaying, iterators would be invalidated
+        for (size_t i = it - _entries.begin(); i < _entries.size(); ++i)
+        {
+            dispatch(_entries[i], observer);
+        }
+    }
+
+    size_t ApiEventsJournal::Entry::size() const
+    {
+        // empty entries (i.e. resets) are also counted to keep the journal bounded
+        return std::max<size_t>(1, coins.size() + shieldedCoins.size() + addresses.size() + txs.size());
+    }
+
+    ApiEventsJournal::Entry& ApiEventsJournal::addEntry(Entry::Type type, ChangeAction action)
+    {
+        // do not drop entries which may be being dispatched right now
+        while (!_dispatchSeq && _items > _maxItems && !_entries.empty())
+        {
+            _items -= _entries.front().size();
+            _entries.pop_front();
+        }
+
+        auto& entry = _entries.emplace_back();
+        entry.seq = ++_lastSeq;
+        entry.type = type;
+        entry.action = action;
+        return entry;
+    }
+
+    void ApiEventsJournal::dispatch(const Entry& entry, IWalletObserver& observer)
+    {
+        // observers may cause new changes while handling this one
+        auto prevSeq = _dispatchSeq;
+        _dispatchSeq = entry.seq;
+
+        switch (entry.type)
+        {
+        case Entry::Type::Asset:
+            observer.onAssetChanged(entry.action, entry.assetId);
+            break;
+        case Entry::Type::Coins:
+            observer.onCoinsChanged(entry.action, entry.coins);
+            break;
+        case Entry::Type::ShieldedCoins:
+            observer.onShieldedCoinsChanged(entry.action, entry.shieldedCoins);
+            break;
+        case Entry::Type::Addresses:
+            observer.onAddressChanged(entry.action, entry.addresses);
+            break;
+        case Entry::Type::Transactions:
+            observer.onTransactionChanged(entry.action, entry.txs);
+            break;
+        }
+
+        _dispatchSeq = prevSeq;
+    }
+
+    void ApiEventsJournal::dispatch(const Entry& entry)
+    {
+        _items += entry.size();
+
+        forEachSubscriber([&](IWalletObserver& sub) { dispatch(entry, sub); });
+    }
+
+    void ApiEventsJournal::onSyncProgress(int done, int total)
+    {
+        forEachSubscriber([&](IWalletObserver& sub) { sub.onSyncProgress(done, total); });
+    }
+
+    void ApiEventsJournal::onOwnedNode(const PeerID& id, bool connected)
+    {
+        forEachSubscriber([&](IWalletObserver& sub) { sub.onOwnedNode(id, connected); });
+    }
+
+    void ApiEventsJournal::onSystemStateChanged(const Block::SystemState::ID& stateID)
+    {
+        forEachSubscriber([&](IWalletObserver& sub) { sub.onSystemStateChanged(stateID); });
+    }
+
+    void ApiEventsJournal::onAssetChanged(ChangeAction action, Asset::ID assetId)
+    {
+        auto& entry = addEntry(Entry::Type::Asset, action);
+        entry.assetId = assetId;
+        dispatch(entry);
+    }
+
+    void ApiEventsJournal::onCoinsChanged(ChangeAction action, const std::vector<Coin>& items)
+    {
+        auto& entry = addEntry(Entry::Type::Coins, action);
+        entry.coins = items;
+        dispatch(entry);
+    }
+
+    void ApiEventsJournal::onShieldedCoinsChanged(ChangeAction action, const std::vector<ShieldedCoin>& items)
+    {
+        auto& entry = addEntry(Entry::Type::ShieldedCoins, action);
+        entry.shieldedCoins = items;
+        dispatch(entry);
+    }
+
+    void ApiEventsJournal::onAddressChanged(ChangeAction action, const std::vector<WalletAddress>& items)
+    {
+        auto& entry = addEntry(Entry::Type::Addresses, action);
+        entry.addresses = items;
+        dispatch(entry);
+    }
+
+    void ApiEventsJournal::onTransactionChanged(ChangeAction action, const std::vector<TxDescription>& items)
+    {
+        auto& entry = addEntry(Entry::Type::Transactions, action);
+        entry.txs = items;
+        dispatch(entry);
+    }
+}
@@ -0,0 +1,102 @@
+// Copyright 2020 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include "wallet/core/wallet.h"
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace beam::wallet
+{
+    //
+    // Numbers wallet DB changes with a sequence and keeps the recent ones
+    // so that API clients are able to resume event subscriptions after reconnect.
+    // Shared by all API connections, MUST be used only in the wallet thread.
+    //
+    // The journal is subscribed to the wallet and forwards all the wallet events to its own subscribers,
+    // so subscribers can query the sequence of the change being dispatched via get_Seq().
+    //
+    class ApiEventsJournal : public IWalletObserver
+    {
+    public:
+        typedef std::shared_ptr<ApiEventsJournal> Ptr;
+
+        ApiEventsJournal(Wallet::Ptr wallet, size_t maxItems);
+        virtual ~ApiEventsJournal();
+
+        void Subscribe(IWalletObserver* observer);
+        void Unsubscribe(IWalletObserver* observer);
+
+        // Sequence of the change being dispatched or replayed.
+        // Outside of dispatch returns the sequence of the last change
+        uint64_t get_Seq() const;
+
+        // True if all the changes after the given sequence are still kept
+        bool CanResume(uint64_t seq) const;
+
+        // Dispatches kept changes after the given sequence to the observer, CanResume(seq) must be true
+        void Replay(uint64_t seq, IWalletObserver& observer);
+
+        //
+        // IWalletObserver
+        //
+        void onSyncProgress(int done, int total) override;
+        void onOwnedNode(const PeerID& id, bool connected) override;
+        void onSystemStateChanged(const Block::SystemState::ID& stateID) override;
+        void onAssetChanged(ChangeAction action, Asset::ID assetId) override;
+        void onCoinsChanged(ChangeAction action, const std::vector<Coin>& items) override;
+        void onShieldedCoinsChanged(ChangeAction action, const std::vector<ShieldedCoin>& items) override;
+        void onAddressChanged(ChangeAction action, const std::vector<WalletAddress>& items) override;
+        void onTransactionChanged(ChangeAction action, const std::vector<TxDescription>& items) override;
+
+    private:
+        struct Entry
+        {
+            enum class Type
+            {
+                Asset,
+                Coins,
+                ShieldedCoins,
+                Addresses,
+                Transactions
+            };
+
+            uint64_t seq = 0;
+            Type type = Type::Asset;
+            ChangeAction action = ChangeAction::Updated;
+            Asset::ID assetId = Asset::s_InvalidID;
+            std::vector<Coin> coins;
+            std::vector<ShieldedCoin> shieldedCoins;
+            std::vector<WalletAddress> addresses;
+            std::vector<TxDescription> txs;
+
+            size_t size() const;
+        };
+
+        Entry& addEntry(Entry::Type type, ChangeAction action);
+        template <typename Fn>
+        void forEachSubscriber(Fn&& fn);
+        void dispatch(const Entry& entry, IWalletObserver& observer);
+        void dispatch(const Entry& entry);
+
+        Wallet::Ptr _wallet;
+        std::vector<IWalletObserver*> _subscribers;
+        std::deque<Entry> _entries;
+        size_t _items = 0;
+        size_t _maxItems;
+        uint64_t _lastSeq;
+        uint64_t _dispatchSeq = 0;
+    };
+}
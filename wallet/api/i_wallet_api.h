@@ -14,6 +14,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <boost/optional.hpp>
@@ -24,6 +25,7 @@
 #include "wallet/ipfs/ipfs.h"
 #include "base/api_errors.h"
 #include "i_swaps_provider.h"
+#include "events_journal.h"
 #include "sync_mode.h"
 
 #ifdef BEAM_ASSET_SWAP_SUPPORT
@@ -55,9 +57,26 @@ namespace beam::wallet
     class IWalletApiHandler
     {
     public:
+        typedef std::function<void (const json& item)> ArrayItemWriter;
+        typedef std::function<void (const ArrayItemWriter&)> ArrayFiller;
+
         virtual ~IWalletApiHandler() = default;
         virtual void sendAPIResponse(const json& result) = 0;
 
+        // Response with a big array member (i.e. listings). The header is the response w/o the array, fillArray
+        // writes its items one by one. Handlers that send bytes override this to serialize the items right away
+        // instead of building the whole tree. If fillArray throws nothing should be sent.
+        virtual void sendAPIArrayResponse(const json& header, const std::string& arrayKey, const ArrayFiller& fillArray)
+        {
+            json msg = header;
+            json& arr = msg[arrayKey] = json::array();
+            fillArray([&arr](const json& item)
+            {
+                arr.push_back(item);
+            });
+            sendAPIResponse(msg);
+        }
+
         virtual void onParseError(const json& msg)
         {
             BEAM_LOG_DEBUG() << "on API parse error: " << msg;
@@ -76,6 +95,7 @@ namespace beam::wallet
         IWalletDB::Ptr walletDB;
         Wallet::Ptr wallet;
         NodeNetwork::Ptr nodeNetwork;
+        ApiEventsJournal::Ptr eventsJournal;
         #ifdef BEAM_IPFS_SUPPORT
         IPFSService::Ptr ipfs;
         #endif
@@ -76,7 +76,11 @@ namespace beam::wallet
             throw jsonrpc_exception(ApiError::NotOpenedError, "WalletDB is nullptr");
         }
 
-        assertWalletThread();
+        // an instance without wallet works over its own db connection (read-only API workers), any thread is fine
+        if (_wallet != nullptr)
+        {
+            assertWalletThread();
+        }
         return _wdb;
     }
 
@@ -137,6 +141,12 @@ namespace beam::wallet
 
     Height V6Api::get_TipHeight() const
     {
+        if (_wallet == nullptr)
+        {
+            Block::SystemState::Full s;
+            return getWalletDB()->get_History().get_Tip(s) ? s.m_Height : 0;
+        }
+
        return getWallet()->get_TipHeight();
     }
 
@@ -50,7 +50,9 @@ namespace beam::wallet
         virtual void fillAssetInfo(json& arr, const WalletAsset& info);
         virtual void fillAddresses(json& arr, const std::vector<WalletAddress>& items);
         virtual void fillCoins(json& arr, const std::vector<ApiCoin>& coins);
+        virtual void fillCoin(json& item, const ApiCoin& coin);
         virtual void fillTransactions(json& arr, const std::vector<Status::Response>& txs);
+        virtual void fillTransaction(json& item, const Status::Response& tx);
 
     private:
         void FillAddressData(const AddressData& data, WalletAddress& address);
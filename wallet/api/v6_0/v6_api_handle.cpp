@@ -597,6 +597,55 @@ namespace beam::wallet
 
         auto walletDB = getWalletDB();
 
+        if (data.sort.field == "default" && !data.sort.desc)
+        {
+            // db order, coins are written out as they're visited
+            doArrayResponse(id, [&](const IWalletApiHandler::ArrayItemWriter& write)
+            {
+                const bool caEnabled = getCAEnabled();
+                size_t offset = 0;
+                size_t counter = 0;
+
+                std::vector<ApiCoin> coin;
+                json itemJson;
+
+                auto writeCoin = [&](const auto& c)->bool
+                {
+                    if (c.isAsset() && !caEnabled)
+                    {
+                        return true;
+                    }
+
+                    if (data.filter.assetId && !c.isAsset(*data.filter.assetId))
+                    {
+                        return true;
+                    }
+
+                    // skip is applied only along with count, see doPagination()
+                    if (data.count && offset++ < data.skip)
+                    {
+                        return true;
+                    }
+
+                    coin.clear();
+                    ApiCoin::EmplaceCoin(coin, c);
+
+                    itemJson = json();
+                    fillCoin(itemJson, coin.front());
+                    write(itemJson);
+
+                    return !data.count || ++counter < data.count;
+                };
+
+                walletDB->visitCoins(writeCoin);
+                if (!data.count || counter < data.count)
+                {
+                    walletDB->visitShieldedCoins(writeCoin);
+                }
+            });
+            return;
+        }
+
         GetUtxo::Response response;
         response.confirmations_count = walletDB->getCoinConfirmationsOffset();
 
@@ -721,28 +770,37 @@ namespace beam::wallet
         BEAM_LOG_DEBUG() << "List(filter.status = " << (data.filter.status ? std::to_string((uint32_t)*data.filter.status) : "nul") << ")";
         helpers::StopWatch sw;
         sw.start();
-        TxList::Response res;
 
+        auto walletDB = getWalletDB();
+
+        Block::SystemState::ID stateID = {};
+        walletDB->getSystemStateID(stateID);
+
+        TxListFilter filter;
+        filter.m_AssetID = data.filter.assetId;
+        filter.m_Status = data.filter.status;
+        if (getCAEnabled())
         {
-            auto walletDB = getWalletDB();
+            filter.m_AssetConfirmedHeight = data.filter.height;
+        }
+        filter.m_KernelProofHeight = data.filter.height;
 
-            Block::SystemState::ID stateID = {};
-            walletDB->getSystemStateID(stateID);
-            res.resultList.reserve(data.count);
+        // items are written out as the db cursor goes, neither the whole page nor its json tree is kept in memory
+        doArrayResponse(id, [&](const IWalletApiHandler::ArrayItemWriter& write)
+        {
             uint32_t offset = 0;
             uint32_t counter = 0;
 
-            TxListFilter filter;
-            filter.m_AssetID = data.filter.assetId;
-            filter.m_Status = data.filter.status;
-            if (getCAEnabled())
-            {
-                filter.m_AssetConfirmedHeight = data.filter.height;
-            }
-            filter.m_KernelProofHeight = data.filter.height;
-            walletDB->visitTx([&](const TxDescription& tx)
+            Status::Response item;
+            item.systemHeight = stateID.m_Height;
+            item.withRates = data.withRates;
+
+            json itemJson;
+
+            // select the page using the summary projection, load the rest of the parameters for the returned txs only
+            walletDB->visitTxSummary([&](const TxDescription& txSummary)
             {
-                if (!allowedTx(tx))
+                if (!allowedTx(txSummary))
                 {
                     return true;
                 }
@@ -752,19 +810,25 @@ namespace beam::wallet
                 {
                     return true;
                 }
-                Status::Response& item = res.resultList.emplace_back();
-                item.tx = tx;
-                item.txProofHeight = storage::DeduceTxProofHeight(*walletDB, tx);
-                item.systemHeight = stateID.m_Height;
-                item.withRates = data.withRates;
+
+                auto tx = walletDB->getTx(txSummary.m_txId);
+                if (!tx)
+                {
+                    return true;
+                }
+
+                item.tx = std::move(*tx);
+                item.txProofHeight = storage::DeduceTxProofHeight(*walletDB, item.tx);
+
+                itemJson = json();
+                fillTransaction(itemJson, item);
+                write(itemJson);
 
                 ++counter;
                 return data.count == 0 || counter < data.count;
-            }, filter);
-            assert(data.count == 0 || (uint32_t)res.resultList.size() <= data.count);
-        }
-        
-        doResponse(id, res);
+            }, filter, TxListPage());
+        });
+
         sw.stop();
         BEAM_LOG_DEBUG() << "TxList  elapsed time: " << sw.milliseconds() << " ms\n";
     }
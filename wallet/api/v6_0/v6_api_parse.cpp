@@ -1152,14 +1152,20 @@ namespace beam::wallet
     {
         for (auto& c : coins)
         {
-            #define MACRO(name, type) {#name, c.name},
-            arr.push_back({
-                BEAM_GET_UTXO_RESPONSE_FIELDS(MACRO)
-            });
-            #undef MACRO
+            arr.emplace_back();
+            fillCoin(arr.back(), c);
         }
     }
 
+    void V6Api::fillCoin(json& item, const ApiCoin& c)
+    {
+        #define MACRO(name, type) {#name, c.name},
+        item = {
+            BEAM_GET_UTXO_RESPONSE_FIELDS(MACRO)
+        };
+        #undef MACRO
+    }
+
     void V6Api::getResponse(const JsonRpcId& id, const GetUtxo::Response& res, json& msg)
     {
         msg = json
@@ -1341,16 +1347,20 @@ namespace beam::wallet
         for (const auto& resItem : txs)
         {
             arr.emplace_back();
-            json& item = arr.back();
-            GetStatusResponseJson(
-                resItem.tx,
-                item,
-                resItem.txProofHeight,
-                resItem.systemHeight,
-                resItem.withRates);
+            fillTransaction(arr.back(), resItem);
         }
     }
 
+    void V6Api::fillTransaction(json& item, const Status::Response& tx)
+    {
+        GetStatusResponseJson(
+            tx.tx,
+            item,
+            tx.txProofHeight,
+            tx.systemHeight,
+            tx.withRates);
+    }
+
     void V6Api::getResponse(const JsonRpcId& id, const TxList::Response& res, json& msg)
     {
         msg = json
@@ -1,19 +1,39 @@
 const net = require('net');
 const client = new net.Socket();
 
-client.setEncoding('utf8')
-client.connect(10000, '127.0.0.1', function() {
-	console.log('Connected')
+// the last received sequence, used to resume after reconnect
+let lastSeq = undefined
+
+function subscribe() {
+	let params = {
+		'ev_system_state': true,
+		'ev_txs_changed': true,
+		'ev_utxos_changed': true,
+		'debounce_ms': 500
+	}
+
+	if (lastSeq !== undefined) {
+		params['resume_from'] = lastSeq
+	}
+
 	client.write(JSON.stringify(
 		{
 			jsonrpc: '2.0',
 			id: 'get_utxo',
 			method: 'ev_subunsub',
-			params: {
-				'ev_system_state': true
-			}
+			params: params
 		}) + '\n')
-})
+}
+
+function connect() {
+	client.connect(10000, '127.0.0.1', function() {
+		console.log('Connected')
+		subscribe()
+	})
+}
+
+client.setEncoding('utf8')
+connect()
 
 client.on('connect', function () {
 	console.log ('Connected to the API...')
@@ -24,7 +44,8 @@ client.on('error', function (err) {
 })
 
 client.on('close', function() {
-	console.log('Connection closed')
+	console.log('Connection closed, reconnecting...')
+	setTimeout(connect, 1000)
 })
 
 let acc = ''
@@ -41,6 +62,10 @@ function onData (data) {
 
 		let res = JSON.parse(acc);
 		console.log('Received:', res)
+
+		if (res.result && res.result.seq !== undefined) {
+			lastSeq = res.result.seq
+		}
 		acc = ""
 
 		onData(data.substring(br + 1))
@@ -26,6 +26,7 @@ namespace beam::wallet
         _apiVersion = ss.str();
         _wallet = init.wallet;
         _network = init.nodeNetwork;
+        _journal = init.eventsJournal;
         assert(_network);
         V6_1_API_METHODS(BEAM_API_REG_METHOD)
     }
@@ -34,7 +35,9 @@ namespace beam::wallet
     {
         if (_subscribedToListener)
         {
-            if (_wallet)
+            if (_journal)
+                _journal->Unsubscribe(this);
+            else if (_wallet)
                 _wallet->Unsubscribe(this);
 
             if (_network)
@@ -15,6 +15,8 @@
 
 #include "wallet/api/v6_0/v6_api.h"
 #include "v6_1_api_defs.h"
+#include "utility/io/timer.h"
+#include <map>
 
 namespace beam::wallet
 {
@@ -67,6 +69,63 @@ namespace beam::wallet
         void sendConnectionStatus();
         json fillConnectionState() const;
 
+        //
+        // Events coalescing, see ev_subunsub 'debounce_ms'
+        //
+        void sendEvent(json& msg, bool journaled);
+        void armEventsTimer();
+        void flushEvents();
+        bool isEvAssetAllowed(Asset::ID assetId) const;
+
+        bool makeSystemStateEvent(json& msg, const Block::SystemState::ID& stateID);
+        bool makeSyncProgressEvent(json& msg, int done, int total);
+        bool makeAssetsEvent(json& msg, ChangeAction action, const std::vector<Asset::ID>& ids);
+        bool makeCoinsEvent(json& msg, ChangeAction action, const std::vector<ApiCoin>& coins);
+        bool makeAddrsEvent(json& msg, ChangeAction action, const std::vector<WalletAddress>& addrs);
+        bool makeTxsEvent(json& msg, ChangeAction action, const std::vector<TxDescription>& txs);
+
+        template<typename Key, typename T>
+        struct EvChanges
+        {
+            // Reset replaces everything that has been queued before
+            boost::optional<std::vector<T>> reset;
+            std::map<Key, std::pair<ChangeAction, T>> changes;
+
+            void add(ChangeAction action, const Key& key, const T& item);
+
+            void clear()
+            {
+                reset = boost::none;
+                changes.clear();
+            }
+
+            template<typename KeyFunc>
+            void add(ChangeAction action, const std::vector<T>& items, KeyFunc&& getKey)
+            {
+                if (action == ChangeAction::Reset)
+                {
+                    reset = items;
+                    changes.clear();
+                    return;
+                }
+
+                for (const auto& item: items)
+                {
+                    add(action, getKey(item), item);
+                }
+            }
+        };
+
+        struct EvPending
+        {
+            boost::optional<Block::SystemState::ID> systemState;
+            boost::optional<std::pair<int, int>> syncProgress;
+            EvChanges<Asset::ID, Asset::ID> assets;
+            EvChanges<std::string, ApiCoin> coins;
+            EvChanges<std::string, WalletAddress> addrs;
+            EvChanges<TxID, TxDescription> txs;
+        };
+
         struct SubFlags {
             typedef uint32_t Type;
             static const uint32_t SyncProgress   = 1 << 0;
@@ -80,6 +139,12 @@ namespace beam::wallet
 
         bool _subscribedToListener = false;
         SubFlags::Type _evSubs = 0;
+        uint32_t _evDebounceMs = 0;
+        EvSubUnsub::Filter _evFilter;
+        EvPending _evPending;
+        io::Timer::Ptr _evTimer;
+        bool _evTimerArmed = false;
+        ApiEventsJournal::Ptr _journal;
         std::string _apiVersion;
         unsigned _apiVersionMajor;
         unsigned _apiVersionMinor;
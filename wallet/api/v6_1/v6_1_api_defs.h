@@ -31,9 +31,21 @@ namespace beam::wallet
         boost::optional<bool> txsChanged     = boost::none;
         boost::optional<bool> connectChanged = boost::none;
 
+        // Subscription options, kept until changed by the next ev_subunsub
+        boost::optional<uint32_t> debounceMs = boost::none;
+        boost::optional<uint64_t> resumeFrom = boost::none;
+
+        struct Filter
+        {
+            boost::optional<Asset::ID> assetId = boost::none;
+            boost::optional<bool> income = boost::none;
+        };
+        boost::optional<Filter> filter = boost::none;
+
         struct Response
         {
             bool result;
+            boost::optional<bool> resumed = boost::none;
         };
     };
 
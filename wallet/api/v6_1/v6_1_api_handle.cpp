@@ -20,6 +20,16 @@ namespace beam::wallet
     {
         auto oldSubs = _evSubs;
 
+        if (data.filter.is_initialized())
+        {
+            _evFilter = *data.filter;
+        }
+
+        if (data.debounceMs.is_initialized())
+        {
+            _evDebounceMs = *data.debounceMs;
+        }
+
         if (data.systemState.is_initialized())
         {
             _evSubs = *data.systemState ? _evSubs | SubFlags::SystemState : _evSubs & ~SubFlags::SystemState;
@@ -55,16 +65,68 @@ namespace beam::wallet
             _evSubs = *data.connectChanged ? _evSubs | SubFlags::ConnectChanged : _evSubs & ~SubFlags::ConnectChanged;
         }
 
+        //
+        // Drop queued events of unsubscribed kinds
+        //
+        if ((_evSubs & SubFlags::SystemState) == 0)
+        {
+            _evPending.systemState = boost::none;
+        }
+
+        if ((_evSubs & SubFlags::SyncProgress) == 0)
+        {
+            _evPending.syncProgress = boost::none;
+        }
+
+        if ((_evSubs & SubFlags::AssetChanged) == 0)
+        {
+            _evPending.assets.clear();
+        }
+
+        if ((_evSubs & SubFlags::CoinsChanged) == 0)
+        {
+            _evPending.coins.clear();
+        }
+
+        if ((_evSubs & SubFlags::AddrsChanged) == 0)
+        {
+            _evPending.addrs.clear();
+        }
+
+        if ((_evSubs & SubFlags::TXsChanged) == 0)
+        {
+            _evPending.txs.clear();
+        }
+
         if (_evSubs && !_subscribedToListener)
         {
-            getWallet()->Subscribe(this);
+            if (_journal)
+            {
+                // journal forwards all the wallet events numbered
+                _journal->Subscribe(this);
+            }
+            else
+            {
+                getWallet()->Subscribe(this);
+            }
+
             if (_network) {
                 _network->Subscribe(this);
             }
             _subscribedToListener = true;
         }
 
+        //
+        // If resumed, changes since the given sequence are replayed
+        // instead of the full lists of items
+        //
+        const bool resumed = data.resumeFrom.is_initialized() && _journal && _journal->CanResume(*data.resumeFrom);
+
         EvSubUnsub::Response resp{true};
+        if (data.resumeFrom.is_initialized())
+        {
+            resp.resumed = resumed;
+        }
         doResponse(id, resp);
 
         //
@@ -83,7 +145,7 @@ namespace beam::wallet
             onSyncProgress(0, 0);
         }
 
-        if ((_evSubs & SubFlags::AssetChanged) != 0 && (oldSubs & SubFlags::AssetChanged) == 0)
+        if (!resumed && (_evSubs & SubFlags::AssetChanged) != 0 && (oldSubs & SubFlags::AssetChanged) == 0)
         {
             std::vector<Asset::ID> ids;
             getWalletDB()->visitAssets([&ids](const WalletAsset& info) -> bool {
@@ -93,7 +155,7 @@ namespace beam::wallet
             onAssetsChanged(ChangeAction::Reset, ids);
         }
 
-        if ((_evSubs & SubFlags::CoinsChanged) != 0 && (oldSubs & SubFlags::CoinsChanged) == 0)
+        if (!resumed && (_evSubs & SubFlags::CoinsChanged) != 0 && (oldSubs & SubFlags::CoinsChanged) == 0)
         {
             std::vector<ApiCoin> coins;
 
@@ -107,7 +169,7 @@ namespace beam::wallet
             onCoinsChangedImp(ChangeAction::Reset, coins);
         };
 
-        if ((_evSubs & SubFlags::AddrsChanged) != 0 && (oldSubs & SubFlags::AddrsChanged) == 0)
+        if (!resumed && (_evSubs & SubFlags::AddrsChanged) != 0 && (oldSubs & SubFlags::AddrsChanged) == 0)
         {
             auto addrs = getWalletDB()->getAddresses(true);
             auto addrs2 = getWalletDB()->getAddresses(false);
@@ -116,7 +178,7 @@ namespace beam::wallet
             onAddressChanged(ChangeAction::Reset, addrs);
         }
 
-        if ((_evSubs & SubFlags::TXsChanged) != 0 && (oldSubs & SubFlags::TXsChanged) == 0)
+        if (!resumed && (_evSubs & SubFlags::TXsChanged) != 0 && (oldSubs & SubFlags::TXsChanged) == 0)
         {
             std::vector<TxDescription> txs;
             getWalletDB()->visitTx([&](const TxDescription& tx) -> bool {
@@ -130,6 +192,15 @@ namespace beam::wallet
         {
             sendConnectionStatus();
         }
+
+        if (resumed)
+        {
+            _journal->Replay(*data.resumeFrom, *this);
+        }
+
+        // Initial and replayed events are not delayed,
+        // also sends everything queued if debounce has been switched off
+        flushEvents();
     }
 
     void V61Api::onHandleGetVersion(const JsonRpcId& id, GetVersion&& params)
@@ -38,37 +38,200 @@ namespace beam::wallet
             parent["tip_state_timestamp"] = tip.m_TimeStamp;
             parent["tip_prev_state_hash"] = to_hex(tip.m_Prev.m_pData, tip.m_Prev.nBytes);
         }
+
+        std::string getAddressKey(const WalletAddress& addr)
+        {
+            return std::to_string(addr.m_BbsAddr) + addr.m_Token;
+        }
     }
 
-    void V61Api::onSyncProgress(int done, int total)
+    template<typename Key, typename T>
+    void V61Api::EvChanges<Key, T>::add(ChangeAction action, const Key& key, const T& item)
     {
-        if ((_evSubs & SubFlags::SyncProgress) == 0)
+        auto it = changes.find(key);
+        if (it == changes.end())
         {
+            changes.emplace(key, std::make_pair(action, item));
             return;
         }
 
+        auto prev = it->second.first;
+        if (prev == ChangeAction::Added && action == ChangeAction::Removed)
+        {
+            // subscriber has never seen this item
+            changes.erase(it);
+            return;
+        }
+
+        if (prev == ChangeAction::Added)
+        {
+            action = ChangeAction::Added;
+        }
+        else if (prev == ChangeAction::Removed && action != ChangeAction::Removed)
+        {
+            action = ChangeAction::Updated;
+        }
+
+        it->second = std::make_pair(action, item);
+    }
+
+    void V61Api::sendEvent(json& msg, bool journaled)
+    {
+        if (journaled && _journal)
+        {
+            msg["result"]["seq"] = _journal->get_Seq();
+        }
+
+        _handler.sendAPIResponse(msg);
+    }
+
+    void V61Api::armEventsTimer()
+    {
+        if (_evTimerArmed)
+        {
+            return;
+        }
+
+        if (!_evTimer)
+        {
+            _evTimer = io::Timer::create(io::Reactor::get_Current());
+        }
+
+        _evTimerArmed = true;
+        _evTimer->start(_evDebounceMs, false, [this]() {
+            _evTimerArmed = false;
+            flushEvents();
+        });
+    }
+
+    void V61Api::flushEvents()
+    {
+        if (_evTimerArmed)
+        {
+            _evTimer->cancel();
+            _evTimerArmed = false;
+        }
+
         // THIS METHOD IS NOT GUARDED
         try
         {
-            auto walletDB = getWalletDB();
+            EvPending pending;
+            std::swap(pending, _evPending);
 
-            Block::SystemState::ID stateID = {};
-            walletDB->getSystemStateID(stateID);
+            std::vector<json> msgs;
+            json msg;
 
-            json msg = json
+            if (pending.systemState && makeSystemStateEvent(msg, *pending.systemState))
             {
-                {JsonRpcHeader, JsonRpcVersion},
-                {"id", "ev_sync_progress"},
-                {"result",
+                msgs.push_back(std::move(msg));
+            }
+
+            if (pending.syncProgress && makeSyncProgressEvent(msg, pending.syncProgress->first, pending.syncProgress->second))
+            {
+                msgs.push_back(std::move(msg));
+            }
+
+            const auto unjournaled = msgs.size();
+
+            auto flushChanges = [&](const auto& pendingChanges, auto makeEvent) {
+                using Item = typename std::decay_t<decltype(pendingChanges.changes)>::mapped_type::second_type;
+
+                json msg;
+                if (pendingChanges.reset && (this->*makeEvent)(msg, ChangeAction::Reset, *pendingChanges.reset))
+                {
+                    msgs.push_back(std::move(msg));
+                }
+
+                for (auto action: {ChangeAction::Added, ChangeAction::Updated, ChangeAction::Removed})
+                {
+                    std::vector<Item> items;
+                    for (const auto& change: pendingChanges.changes)
+                    {
+                        if (change.second.first == action)
+                        {
+                            items.push_back(change.second.second);
+                        }
+                    }
+
+                    if ((this->*makeEvent)(msg, action, items))
                     {
-                        {"sync_requests_done", done},
-                        {"sync_requests_total", total}
+                        msgs.push_back(std::move(msg));
                     }
                 }
             };
 
-            fillSystemState(msg["result"], stateID, walletDB);
-            _handler.sendAPIResponse(msg);
+            flushChanges(pending.assets, &V61Api::makeAssetsEvent);
+            flushChanges(pending.coins, &V61Api::makeCoinsEvent);
+            flushChanges(pending.addrs, &V61Api::makeAddrsEvent);
+            flushChanges(pending.txs, &V61Api::makeTxsEvent);
+
+            // Sequence is put only into the last message of the batch,
+            // so a subscriber resumes from it only after the whole batch has been received
+            if (_journal && msgs.size() > unjournaled)
+            {
+                msgs.back()["result"]["seq"] = _journal->get_Seq();
+            }
+
+            for (const auto& m: msgs)
+            {
+                _handler.sendAPIResponse(m);
+            }
+        }
+        catch(std::exception& e)
+        {
+            BEAM_LOG_ERROR() << "V61Api::flushEvents failed: " << e.what();
+        }
+    }
+
+    bool V61Api::isEvAssetAllowed(Asset::ID assetId) const
+    {
+        return !_evFilter.assetId.is_initialized() || *_evFilter.assetId == assetId;
+    }
+
+    bool V61Api::makeSyncProgressEvent(json& msg, int done, int total)
+    {
+        auto walletDB = getWalletDB();
+
+        Block::SystemState::ID stateID = {};
+        walletDB->getSystemStateID(stateID);
+
+        msg = json
+        {
+            {JsonRpcHeader, JsonRpcVersion},
+            {"id", "ev_sync_progress"},
+            {"result",
+                {
+                    {"sync_requests_done", done},
+                    {"sync_requests_total", total}
+                }
+            }
+        };
+
+        fillSystemState(msg["result"], stateID, walletDB);
+        return true;
+    }
+
+    void V61Api::onSyncProgress(int done, int total)
+    {
+        if ((_evSubs & SubFlags::SyncProgress) == 0)
+        {
+            return;
+        }
+
+        if (_evDebounceMs)
+        {
+            _evPending.syncProgress = std::make_pair(done, total);
+            return armEventsTimer();
+        }
+
+        // THIS METHOD IS NOT GUARDED
+        try
+        {
+            json msg;
+            if (makeSyncProgressEvent(msg, done, total))
+            {
+                sendEvent(msg, false);
+            }
         }
         catch(std::exception& e)
         {
@@ -81,6 +244,19 @@ namespace beam::wallet
         sendConnectionStatus();
     }
 
+    bool V61Api::makeSystemStateEvent(json& msg, const Block::SystemState::ID& stateID)
+    {
+        msg = json
+        {
+            {JsonRpcHeader, JsonRpcVersion},
+            {"id", "ev_system_state"},
+            {"result", {}}
+        };
+
+        fillSystemState(msg["result"], stateID, getWalletDB());
+        return true;
+    }
+
     void V61Api::onSystemStateChanged(const Block::SystemState::ID& stateID)
     {
         if ((_evSubs & SubFlags::SystemState) == 0)
@@ -88,18 +264,21 @@ namespace beam::wallet
             return;
         }
 
+        if (_evDebounceMs)
+        {
+            // only the latest state matters
+            _evPending.systemState = stateID;
+            return armEventsTimer();
+        }
+
         // THIS METHOD IS NOT GUARDED
         try
         {
-            json msg = json
+            json msg;
+            if (makeSystemStateEvent(msg, stateID))
             {
-                {JsonRpcHeader, JsonRpcVersion},
-                {"id", "ev_system_state"},
-                {"result", {}}
-            };
-
-            fillSystemState(msg["result"], stateID, getWalletDB());
-            _handler.sendAPIResponse(msg);
+                sendEvent(msg, false);
+            }
         }
         catch(std::exception& e)
         {
@@ -132,55 +311,72 @@ namespace beam::wallet
         }
     }
 
-    void V61Api::onAssetsChanged(ChangeAction action, const std::vector<Asset::ID>& ids)
+    bool V61Api::makeAssetsEvent(json& msg, ChangeAction action, const std::vector<Asset::ID>& ids)
     {
-        try
+        msg = json
         {
-            json msg = json
-            {
-                {JsonRpcHeader, JsonRpcVersion},
-                {"id", "ev_assets_changed"},
-                {"result",
-                    {
-                        {"change", action},
-                        {"change_str", std::to_string(action)},
-                        {"assets", json::array()}
-                    }
+            {JsonRpcHeader, JsonRpcVersion},
+            {"id", "ev_assets_changed"},
+            {"result",
+                {
+                    {"change", action},
+                    {"change_str", std::to_string(action)},
+                    {"assets", json::array()}
                 }
-            };
+            }
+        };
 
-            auto& arr = msg["result"]["assets"];
-            if (action == ChangeAction::Removed)
+        auto& arr = msg["result"]["assets"];
+        if (action == ChangeAction::Removed)
+        {
+            for (auto aid: ids)
             {
-                for (auto aid: ids)
-                {
-                    arr.push_back({
-                        {"asset_id", aid}
-                    });
-                }
+                arr.push_back({
+                    {"asset_id", aid}
+                });
             }
-            else
+        }
+        else
+        {
+            for (auto aid: ids)
             {
-                for (auto aid: ids)
+                if (const auto oasset = getWalletDB()->findAsset(aid))
                 {
-                    if (const auto oasset = getWalletDB()->findAsset(aid))
-                    {
-                        auto obj = json::object();
-                        fillAssetInfo(obj, *oasset);
-                        arr.push_back(obj);
-                    }
-                    else
-                    {
-                        BEAM_LOG_WARNING() << "onAssetsChanged: failed to find asset " << aid << ", action" << std::to_string(action);
-                    }
+                    auto obj = json::object();
+                    fillAssetInfo(obj, *oasset);
+                    arr.push_back(obj);
+                }
+                else
+                {
+                    BEAM_LOG_WARNING() << "onAssetsChanged: failed to find asset " << aid << ", action" << std::to_string(action);
                 }
             }
+        }
+
+        // allow reset even if empty
+        // do not notify for other actions if empty
+        return action == ChangeAction::Reset || !arr.empty();
+    }
 
-            // allow reset even if empty
-            // do not notify for other actions if empty
-            if (action == ChangeAction::Reset || !arr.empty())
+    void V61Api::onAssetsChanged(ChangeAction action, const std::vector<Asset::ID>& ids)
+    {
+        try
+        {
+            std::vector<Asset::ID> filtered;
+            std::copy_if(ids.begin(), ids.end(), std::back_inserter(filtered), [this](Asset::ID aid) {
+                return isEvAssetAllowed(aid);
+            });
+
+            if (_evDebounceMs)
             {
-                _handler.sendAPIResponse(msg);
+                _evPending.assets.add(action, filtered, [](Asset::ID aid) { return aid; });
+                return armEventsTimer();
+            }
+
+            json msg;
+            if (makeAssetsEvent(msg, action, filtered))
+            {
+                sendEvent(msg, true);
             }
         }
         catch(std::exception& e)
@@ -208,10 +404,9 @@ namespace beam::wallet
         }
     }
 
-    template<>
-    void V61Api::onCoinsChangedImp(ChangeAction action, const std::vector<ApiCoin>& coins)
+    bool V61Api::makeCoinsEvent(json& msg, ChangeAction action, const std::vector<ApiCoin>& coins)
     {
-        json msg = json
+        msg = json
         {
             {JsonRpcHeader, JsonRpcVersion},
             {"id", "ev_utxos_changed"},
@@ -229,7 +424,34 @@ namespace beam::wallet
         if (action == ChangeAction::Reset || !coins.empty())
         {
             fillCoins(msg["result"]["utxos"], coins);
-            _handler.sendAPIResponse(msg);
+            return true;
+        }
+
+        return false;
+    }
+
+    template<>
+    void V61Api::onCoinsChangedImp(ChangeAction action, const std::vector<ApiCoin>& coins)
+    {
+        std::vector<ApiCoin> filtered;
+        if (_evFilter.assetId)
+        {
+            std::copy_if(coins.begin(), coins.end(), std::back_inserter(filtered), [this](const ApiCoin& c) {
+                return isEvAssetAllowed(c.asset_id);
+            });
+        }
+
+        const auto& allowed = _evFilter.assetId ? filtered : coins;
+        if (_evDebounceMs)
+        {
+            _evPending.coins.add(action, allowed, [](const ApiCoin& c) { return c.id; });
+            return armEventsTimer();
+        }
+
+        json msg;
+        if (makeCoinsEvent(msg, action, allowed))
+        {
+            sendEvent(msg, true);
         }
     }
 
@@ -275,6 +497,32 @@ namespace beam::wallet
         onCoinsChangedImp<ShieldedCoin>(action, changed);
     }
 
+    bool V61Api::makeAddrsEvent(json& msg, ChangeAction action, const std::vector<WalletAddress>& addrs)
+    {
+        msg = json
+        {
+            {JsonRpcHeader, JsonRpcVersion},
+            {"id", "ev_addrs_changed"},
+            {"result",
+                {
+                    {"change", action},
+                    {"change_str", std::to_string(action)},
+                    {"addrs", json::array()}
+                }
+            }
+        };
+
+        // allow reset even if empty
+        // do not notify for other actions if empty
+        if (action == ChangeAction::Reset || !addrs.empty())
+        {
+            fillAddresses(msg["result"]["addrs"], addrs);
+            return true;
+        }
+
+        return false;
+    }
+
     void V61Api::onAddressChanged(ChangeAction action, const std::vector<WalletAddress>& items)
     {
         if ((_evSubs & SubFlags::AddrsChanged) == 0)
@@ -284,51 +532,81 @@ namespace beam::wallet
 
         try
         {
-            json msg = json
+            std::vector<WalletAddress> filtered;
+            const auto& appid = getAppId();
+
+            if (!appid.empty())
             {
-                {JsonRpcHeader, JsonRpcVersion},
-                {"id", "ev_addrs_changed"},
-                {"result",
+                std::copy_if(
+                    items.begin(),
+                    items.end(),
+                    std::back_inserter(filtered),
+                    [appid](const auto& addr) -> bool
                     {
-                        {"change", action},
-                        {"change_str", std::to_string(action)},
-                        {"addrs", json::array()}
+                        return addr.m_category == appid;
                     }
-                }
-            };
+                );
+            }
 
-            auto notify = [&](const std::vector<WalletAddress>& list) {
-                // allow reset even if empty
-                // do not notify for other actions if empty
-                if (action == ChangeAction::Reset || !list.empty())
-                {
-                    fillAddresses(msg["result"]["addrs"], list);
-                    _handler.sendAPIResponse(msg);
-                }
-            };
+            const auto& allowed = appid.empty() ? items : filtered;
+            if (_evDebounceMs)
+            {
+                _evPending.addrs.add(action, allowed, getAddressKey);
+                return armEventsTimer();
+            }
 
-            const auto& appid = getAppId();
-            if (appid.empty())
+            json msg;
+            if (makeAddrsEvent(msg, action, allowed))
             {
-                return notify(items);
+                sendEvent(msg, true);
             }
+        }
+        catch(std::exception& e)
+        {
+            BEAM_LOG_ERROR() << "V61Api::onAddressChanged failed: " << e.what();
+        }
+    }
 
-            std::vector<WalletAddress> filtered;
-            std::copy_if(
-                items.begin(),
-                items.end(),
-                std::back_inserter(filtered),
-                [appid](const auto& addr) -> bool
+    bool V61Api::makeTxsEvent(json& msg, ChangeAction action, const std::vector<TxDescription>& txs)
+    {
+        msg = json
+        {
+            {JsonRpcHeader, JsonRpcVersion},
+            {"id", "ev_txs_changed"},
+            {"result",
                 {
-                    return addr.m_category == appid;
+                    {"change", action},
+                    {"change_str", std::to_string(action)},
+                    {"txs", json::array()}
                 }
-            );
-            notify(filtered);
+            }
+        };
+
+        // allow reset even if empty
+        // do not notify for other actions if empty
+        if (action != ChangeAction::Reset && txs.empty())
+        {
+            return false;
         }
-        catch(std::exception& e)
+
+        auto walletDB = getWalletDB();
+        Block::SystemState::ID stateID = {};
+        walletDB->getSystemStateID(stateID);
+
+        std::vector<Status::Response> items;
+        items.reserve(txs.size());
+
+        for(const auto& tx: txs)
         {
-            BEAM_LOG_ERROR() << "V61Api::onAddressChanged failed: " << e.what();
+            Status::Response &item = items.emplace_back();
+            item.tx = tx;
+            item.txProofHeight = storage::DeduceTxProofHeight(*walletDB, tx);
+            item.systemHeight = stateID.m_Height;
+            item.withRates = true;
         }
+
+        fillTransactions(msg["result"]["txs"], items);
+        return true;
     }
 
     void V61Api::onTransactionChanged(ChangeAction action, const std::vector<TxDescription>& changed)
@@ -340,44 +618,32 @@ namespace beam::wallet
 
         try
         {
-            json msg = json
+            std::vector<TxDescription> txs;
+            for(const auto& tx: changed)
             {
-                {JsonRpcHeader, JsonRpcVersion},
-                {"id", "ev_txs_changed"},
-                {"result",
-                    {
-                        {"change", action},
-                        {"change_str", std::to_string(action)},
-                        {"txs", json::array()}
-                    }
+                if (!allowedTx(tx) || !isEvAssetAllowed(tx.m_assetId))
+                {
+                    continue;
                 }
-            };
-
-            auto walletDB = getWalletDB();
-            Block::SystemState::ID stateID = {};
-            walletDB->getSystemStateID(stateID);
 
-            std::vector<Status::Response> items;
-            for(const auto& tx: changed)
-            {
-                if (!allowedTx(tx))
+                if (_evFilter.income && *_evFilter.income == tx.m_sender)
                 {
                     continue;
                 }
 
-                Status::Response &item = items.emplace_back();
-                item.tx = tx;
-                item.txProofHeight = storage::DeduceTxProofHeight(*walletDB, tx);
-                item.systemHeight = stateID.m_Height;
-                item.withRates = true;
+                txs.push_back(tx);
+            }
+
+            if (_evDebounceMs)
+            {
+                _evPending.txs.add(action, txs, [](const TxDescription& tx) { return tx.m_txId; });
+                return armEventsTimer();
             }
 
-            // allow reset even if empty
-            // do not notify for other actions if empty
-            if (action == ChangeAction::Reset || !items.empty())
+            json msg;
+            if (makeTxsEvent(msg, action, txs))
             {
-                fillTransactions(msg["result"]["txs"], items);
-                _handler.sendAPIResponse(msg);
+                sendEvent(msg, true);
             }
         }
         catch(std::exception& e)
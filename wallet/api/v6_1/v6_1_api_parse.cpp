@@ -27,9 +27,19 @@ namespace beam::wallet
         allowed.insert("ev_txs_changed");
         allowed.insert("ev_connection_changed");
 
+        std::set<std::string> options;
+        options.insert("debounce_ms");
+        options.insert("resume_from");
+        options.insert("filter");
+
         bool found = false;
         for (auto it : params.items())
         {
+            if (options.find(it.key()) != options.end())
+            {
+                continue;
+            }
+
             if(allowed.find(it.key()) == allowed.end())
             {
                 std::string error = "The event '" + it.key() + "' is unknown.";
@@ -66,6 +76,38 @@ namespace beam::wallet
         message.utxosChanged   = getOptionalParam<bool>(params, "ev_utxos_changed");
         message.txsChanged     = getOptionalParam<bool>(params, "ev_txs_changed");
         message.connectChanged = getOptionalParam<bool>(params, "ev_connection_changed");
+        message.resumeFrom     = getOptionalParam<uint64_t>(params, "resume_from");
+
+        if (auto debounce = getOptionalParam<uint32_t>(params, "debounce_ms"))
+        {
+            const uint32_t kMaxDebounceMs = 10000;
+            if (*debounce > kMaxDebounceMs)
+            {
+                throw jsonrpc_exception(ApiError::InvalidParamsJsonRpc, "debounce_ms must not exceed " + std::to_string(kMaxDebounceMs));
+            }
+            message.debounceMs = debounce;
+        }
+
+        if (auto filter = getOptionalParam<const json&>(params, "filter"))
+        {
+            if (!filter->is_object())
+            {
+                throw jsonrpc_exception(ApiError::InvalidParamsJsonRpc, "Parameter 'filter' must be an object.");
+            }
+
+            for (auto it : filter->items())
+            {
+                if (it.key() != "asset_id" && it.key() != "income")
+                {
+                    throw jsonrpc_exception(ApiError::InvalidParamsJsonRpc, "The filter '" + it.key() + "' is unknown.");
+                }
+            }
+
+            EvSubUnsub::Filter evFilter;
+            evFilter.assetId = getOptionalParam<uint32_t>(*filter, "asset_id");
+            evFilter.income  = getOptionalParam<bool>(*filter, "income");
+            message.filter = evFilter;
+        }
 
         return std::make_pair(message, MethodInfo());
     }
@@ -78,6 +120,15 @@ namespace beam::wallet
             {"id", id},
             {"result", res.result}
         };
+
+        // plain 'true' is kept for the clients that do not resume
+        if (res.resumed.is_initialized())
+        {
+            msg["result"] = json
+            {
+                {"resumed", *res.resumed}
+            };
+        }
     }
 
     std::pair<GetVersion, IWalletApi::MethodInfo> V61Api::onParseGetVersion(const JsonRpcId& id, const nlohmann::json& params)
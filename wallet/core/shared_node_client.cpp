@@ -0,0 +1,433 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "shared_node_client.h"
+#include "utility/logger.h"
+
+namespace beam::wallet
+{
+    struct SharedNodeClient::Endpoint
+        : public proto::FlyClient::INetwork
+        , public proto::FlyClient::Request::IHandler
+    {
+        Endpoint(SharedNodeClient::Ptr owner, proto::FlyClient& client)
+            : m_owner(std::move(owner))
+            , m_client(client)
+        {
+            ZeroObject(m_confirmed);
+        }
+
+        ~Endpoint() override
+        {
+            if (m_pHdrRequest)
+            {
+                m_pHdrRequest->m_pTrg = nullptr;
+            }
+
+            m_owner->removeEndpoint(*this);
+        }
+
+        // the shared network is connected by its owner
+        void Connect() override {}
+        void Disconnect() override {}
+
+        void PostRequestInternal(proto::FlyClient::Request& r) override
+        {
+            m_owner->m_network->PostRequestInternal(r);
+        }
+
+        void BbsSubscribe(BbsChannel channel, Timestamp ts, proto::FlyClient::IBbsReceiver* receiver) override
+        {
+            auto it = m_bbs.find(channel);
+            if (receiver)
+            {
+                if (it != m_bbs.end())
+                {
+                    it->second = receiver;
+                    return;
+                }
+
+                m_bbs.emplace(channel, receiver);
+                m_owner->bbsSubscribe(*this, channel, ts, true);
+            }
+            else if (it != m_bbs.end())
+            {
+                m_bbs.erase(it);
+                m_owner->bbsSubscribe(*this, channel, ts, false);
+            }
+        }
+
+        void DependentSubscribe(bool subscribe) override
+        {
+            if (m_dependent != subscribe)
+            {
+                m_dependent = subscribe;
+                m_owner->dependentSubscribe(subscribe);
+            }
+        }
+
+        const Merkle::Hash* get_DependentState(uint32_t& count) override
+        {
+            return m_owner->m_network->get_DependentState(count);
+        }
+
+        // the node header requested to check the client state
+        void OnComplete(proto::FlyClient::Request&) override
+        {
+            m_owner->onHeader(*this);
+        }
+
+        SharedNodeClient::Ptr m_owner;
+        proto::FlyClient& m_client;
+        std::map<BbsChannel, proto::FlyClient::IBbsReceiver*> m_bbs;
+        bool m_dependent = false;
+
+        // common ancestor search
+        proto::FlyClient::RequestEnumHdrs::Ptr m_pHdrRequest;
+        Block::SystemState::ID m_confirmed; // the client state found in the node chain
+        bool m_rolledBack = false; // the client states have been dropped, it's notified once the search is done
+    };
+
+    SharedNodeClient::SharedNodeClient()
+        : m_network(std::make_shared<NodeNetwork>(*this))
+    {
+    }
+
+    SharedNodeClient::~SharedNodeClient()
+    {
+        // endpoints keep the owner alive
+        assert(m_endpoints.empty());
+    }
+
+    NodeNetwork::Ptr SharedNodeClient::getNetwork() const
+    {
+        return m_network;
+    }
+
+    proto::FlyClient::INetwork::Ptr SharedNodeClient::addClient(proto::FlyClient& client)
+    {
+        auto endpoint = std::make_shared<Endpoint>(shared_from_this(), client);
+        m_endpoints.push_back(endpoint.get());
+
+        // the client is synced on the next tip, it can't post requests until it gets the endpoint
+        return endpoint;
+    }
+
+    void SharedNodeClient::removeEndpoint(Endpoint& endpoint)
+    {
+        for (const auto& [channel, receiver] : endpoint.m_bbs)
+        {
+            bbsSubscribe(endpoint, channel, 0, false);
+        }
+        endpoint.m_bbs.clear();
+
+        if (endpoint.m_dependent)
+        {
+            dependentSubscribe(false);
+        }
+
+        auto it = std::find(m_endpoints.begin(), m_endpoints.end(), &endpoint);
+        assert(it != m_endpoints.end());
+        m_endpoints.erase(it);
+    }
+
+    void SharedNodeClient::syncClient(Endpoint& endpoint)
+    {
+        if (endpoint.m_pHdrRequest)
+        {
+            // the client is synced once the node responds
+            return;
+        }
+
+        Block::SystemState::Full tip;
+        m_history.get_Tip(tip);
+        if (!tip.m_Height)
+        {
+            return;
+        }
+
+        auto& client = endpoint.m_client;
+        auto& history = client.get_History();
+
+        Block::SystemState::Full state;
+        history.get_Tip(state);
+
+        //
+        // Drop the client states which are not in the common chain.
+        // States which are not in the common history are checked against the node, the same way NetworkStd
+        // searches for the common state, but one header at a time
+        //
+        if (state.m_Height > tip.m_Height)
+        {
+            history.DeleteFrom(tip.m_Height + 1);
+            history.get_Tip(state);
+            endpoint.m_rolledBack = true;
+        }
+
+        while (state.m_Height)
+        {
+            Block::SystemState::Full common;
+            if (!m_history.get_At(common, state.m_Height))
+            {
+                Block::SystemState::ID id;
+                state.get_ID(id);
+                if (id == endpoint.m_confirmed)
+                {
+                    break;
+                }
+
+                requestHeader(endpoint, state.m_Height);
+                return;
+            }
+
+            Merkle::Hash hv0, hv1;
+            state.get_Hash(hv0);
+            common.get_Hash(hv1);
+
+            if (hv0 == hv1)
+            {
+                break;
+            }
+
+            history.DeleteFrom(state.m_Height);
+            history.get_Tip(state);
+            endpoint.m_rolledBack = true;
+        }
+
+        if (endpoint.m_rolledBack)
+        {
+            endpoint.m_rolledBack = false;
+            client.OnRolledBack();
+        }
+
+        if (state.m_Height >= tip.m_Height)
+        {
+            return;
+        }
+
+        //
+        // Add the missing states. If there is a gap between the client and the common history only the tip is added,
+        // the client state below the gap is already confirmed by the node. The wallet doesn't need the intermediate headers
+        //
+        std::vector<Block::SystemState::Full> states;
+        auto it = m_history.m_Map.upper_bound(state.m_Height);
+        if (state.m_Height && it != m_history.m_Map.end() && it->first == state.m_Height + 1)
+        {
+            for (; it != m_history.m_Map.end(); ++it)
+            {
+                states.push_back(it->second);
+            }
+        }
+        else
+        {
+            states.push_back(tip);
+        }
+
+        history.AddStates(states.data(), states.size());
+        client.OnNewTip();
+    }
+
+    void SharedNodeClient::requestHeader(Endpoint& endpoint, Height h)
+    {
+        assert(!endpoint.m_pHdrRequest);
+
+        endpoint.m_pHdrRequest = new proto::FlyClient::RequestEnumHdrs;
+        endpoint.m_pHdrRequest->m_Msg.m_Height = h;
+        m_network->PostRequest(*endpoint.m_pHdrRequest, endpoint);
+    }
+
+    void SharedNodeClient::onHeader(Endpoint& endpoint)
+    {
+        auto pRequest = std::move(endpoint.m_pHdrRequest);
+        auto h = pRequest->m_Msg.m_Height.m_Max;
+
+        if (pRequest->m_vStates.size() != 1)
+        {
+            BEAM_LOG_WARNING() << "Shared node client: no header at " << h << ", the client is synced on the next tip";
+            return;
+        }
+
+        auto& history = endpoint.m_client.get_History();
+
+        Block::SystemState::Full state;
+        if (history.get_At(state, h))
+        {
+            Merkle::Hash hv0, hv1;
+            state.get_Hash(hv0);
+            pRequest->m_vStates.front().get_Hash(hv1);
+
+            if (hv0 == hv1)
+            {
+                state.get_ID(endpoint.m_confirmed);
+            }
+            else
+            {
+                history.DeleteFrom(h);
+                endpoint.m_rolledBack = true;
+            }
+        }
+
+        syncClient(endpoint);
+    }
+
+    void SharedNodeClient::OnNewTip()
+    {
+        m_history.ShrinkToWindow(Rules::get().MaxRollback);
+
+        // clients don't add/remove endpoints while handling the tip
+        for (auto endpoint : m_endpoints)
+        {
+            syncClient(*endpoint);
+        }
+    }
+
+    void SharedNodeClient::OnTipUnchanged()
+    {
+        for (auto endpoint : m_endpoints)
+        {
+            endpoint->m_client.OnTipUnchanged();
+        }
+    }
+
+    void SharedNodeClient::OnRolledBack()
+    {
+        Block::SystemState::Full tip;
+        m_history.get_Tip(tip);
+        BEAM_LOG_INFO() << "Shared node client rolled back to " << tip.m_Height;
+
+        for (auto endpoint : m_endpoints)
+        {
+            syncClient(*endpoint);
+        }
+    }
+
+    Block::SystemState::IHistory& SharedNodeClient::get_History()
+    {
+        return m_history;
+    }
+
+    void SharedNodeClient::OnNewPeer(const PeerID& id, io::Address address)
+    {
+        for (auto endpoint : m_endpoints)
+        {
+            endpoint->m_client.OnNewPeer(id, address);
+        }
+    }
+
+    void SharedNodeClient::OnDependentStateChanged()
+    {
+        for (auto endpoint : m_endpoints)
+        {
+            if (endpoint->m_dependent)
+            {
+                endpoint->m_client.OnDependentStateChanged();
+            }
+        }
+    }
+
+    void SharedNodeClient::OnMsg(proto::BbsMsg&& msg)
+    {
+        auto itTs = m_bbsTimestamps.find(msg.m_Channel);
+        if (itTs != m_bbsTimestamps.end())
+        {
+            std::setmax(itTs->second, msg.m_TimePosted);
+        }
+
+        // receivers may unsubscribe while handling the message
+        std::vector<proto::FlyClient::IBbsReceiver*> receivers;
+
+        auto range = m_bbsSubscribers.equal_range(msg.m_Channel);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            auto itReceiver = it->second->m_bbs.find(msg.m_Channel);
+            if (itReceiver != it->second->m_bbs.end())
+            {
+                receivers.push_back(itReceiver->second);
+            }
+        }
+
+        // each wallet tries to decrypt the message, only the addressee succeeds
+        for (size_t i = 0; i < receivers.size(); ++i)
+        {
+            if (i + 1 == receivers.size())
+            {
+                receivers[i]->OnMsg(std::move(msg));
+            }
+            else
+            {
+                proto::BbsMsg copy = msg;
+                receivers[i]->OnMsg(std::move(copy));
+            }
+        }
+    }
+
+    void SharedNodeClient::bbsSubscribe(Endpoint& endpoint, BbsChannel channel, Timestamp ts, bool subscribe)
+    {
+        if (subscribe)
+        {
+            auto it = m_bbsTimestamps.find(channel);
+            if (it == m_bbsTimestamps.end())
+            {
+                m_bbsTimestamps.emplace(channel, ts);
+                m_network->BbsSubscribe(channel, ts, this);
+            }
+            else if (ts < it->second)
+            {
+                // The subscriber may have missed some messages, the channel is resubscribed from the older time.
+                // The messages the others have already got are dispatched again, the same happens after reconnect
+                it->second = ts;
+                m_network->BbsSubscribe(channel, 0, nullptr);
+                m_network->BbsSubscribe(channel, ts, this);
+            }
+
+            m_bbsSubscribers.emplace(channel, &endpoint);
+            return;
+        }
+
+        auto range = m_bbsSubscribers.equal_range(channel);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == &endpoint)
+            {
+                m_bbsSubscribers.erase(it);
+                break;
+            }
+        }
+
+        if (m_bbsSubscribers.find(channel) == m_bbsSubscribers.end())
+        {
+            m_bbsTimestamps.erase(channel);
+            m_network->BbsSubscribe(channel, 0, nullptr);
+        }
+    }
+
+    void SharedNodeClient::dependentSubscribe(bool subscribe)
+    {
+        if (subscribe)
+        {
+            if (!m_dependentSubscribers++)
+            {
+                m_network->DependentSubscribe(true);
+            }
+        }
+        else
+        {
+            assert(m_dependentSubscribers);
+            if (!--m_dependentSubscribers)
+            {
+                m_network->DependentSubscribe(false);
+            }
+        }
+    }
+} // namespace beam::wallet
@@ -0,0 +1,78 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+#include "core/fly_client.h"
+#include "wallet/core/node_network.h"
+
+namespace beam::wallet
+{
+    //
+    // Lets several wallets (fly clients) in one process share a single node connection.
+    // It is the only client of the node network: headers are downloaded once into the common in-memory history
+    // and then propagated into the histories of the wallets, BBS messages are dispatched to all the subscribers
+    // of the channel. Each wallet posts its requests via its own endpoint returned by addClient().
+    // Wallet states which are not in the common history (i.e. the wallet has been offline for a while) are checked
+    // against the node header by header until the common ancestor is found.
+    // The shared node is never treated as an owned one.
+    //
+    class SharedNodeClient final
+        : public proto::FlyClient
+        , private proto::FlyClient::IBbsReceiver
+        , public std::enable_shared_from_this<SharedNodeClient>
+    {
+    public:
+        using Ptr = std::shared_ptr<SharedNodeClient>;
+
+        SharedNodeClient();
+        ~SharedNodeClient() override;
+
+        NodeNetwork::Ptr getNetwork() const;
+
+        // The endpoint should be released before the client is destroyed (Wallet does this in its destructor)
+        proto::FlyClient::INetwork::Ptr addClient(proto::FlyClient& client);
+
+    private:
+        struct Endpoint;
+
+        // proto::FlyClient
+        void OnNewTip() override;
+        void OnTipUnchanged() override;
+        void OnRolledBack() override;
+        Block::SystemState::IHistory& get_History() override;
+        void OnNewPeer(const PeerID& id, io::Address address) override;
+        void OnDependentStateChanged() override;
+
+        // proto::FlyClient::IBbsReceiver
+        void OnMsg(proto::BbsMsg&& msg) override;
+
+        void syncClient(Endpoint& endpoint);
+        void requestHeader(Endpoint& endpoint, Height h);
+        void onHeader(Endpoint& endpoint);
+        void bbsSubscribe(Endpoint& endpoint, BbsChannel channel, Timestamp ts, bool subscribe);
+        void dependentSubscribe(bool subscribe);
+        void removeEndpoint(Endpoint& endpoint);
+
+        NodeNetwork::Ptr m_network;
+        Block::SystemState::HistoryMap m_history;
+        std::vector<Endpoint*> m_endpoints;
+        std::multimap<BbsChannel, Endpoint*> m_bbsSubscribers;
+        std::map<BbsChannel, Timestamp> m_bbsTimestamps; // the node sends the channel messages starting from this time
+        uint32_t m_dependentSubscribers = 0;
+    };
+} // namespace beam::wallet
@@ -598,11 +598,15 @@ namespace beam::wallet
     WALLET_REQUEST_Single(Events)
     WALLET_REQUEST_Single(StateSummary)
     WALLET_REQUEST_Single(ShieldedOutputsAt)
-    WALLET_REQUEST_Single(BodyPack)
     WALLET_REQUEST_Single(Body)
     WALLET_REQUEST_Single(AssetsListAt)
 
 
+    bool Wallet::MyRequestBodyPack::operator < (const MyRequestBodyPack& x) const
+    {
+        return m_StartHeight < x.m_StartHeight;
+    }
+
     bool Wallet::MyRequestUtxo::operator < (const MyRequestUtxo& x) const
     {
         return m_Msg.m_Utxo < x.m_Msg.m_Utxo;
@@ -1651,29 +1655,159 @@ namespace beam::wallet
 
     void Wallet::OnRequestComplete(MyRequestBodyPack& r)
     {
-        RecognizerHandler h(*this, m_WalletDB->get_OwnerKdf());
-        NodeProcessor::Recognizer recognizer(h, m_Extra);
-        try 
+        const auto& vBodies = r.m_Res.m_Bodies;
+        if (vBodies.empty())
         {
-            Height startHeight = r.m_StartHeight;
-            if (!r.m_Res.m_Bodies.empty())
+            // the node can't serve this range (perhaps the top is no longer active). Restart on the next tip
+            AbortBodiesRequests();
+            return;
+        }
+
+        size_t nCount = vBodies.size();
+        if (r.m_StartHeight + nCount <= r.m_Msg.m_Top.m_Height)
+            m_BodyPackSpan = nCount; // the node stopped before the top, this is its pack limit
+
+        Height hEnd = r.m_StartHeight + nCount;
+        if (hEnd < r.m_EndHeight)
+        {
+            // truncated, request the remaining part
+            Block::SystemState::Full tip;
+            m_WalletDB->get_History().get_Tip(tip);
+
+            if (!RequestBodyRange(hEnd, r.m_EndHeight, tip))
             {
-                RequestBodies(r.m_Msg.m_Height0, startHeight + r.m_Res.m_Bodies.size());
+                AbortBodiesRequests();
+                return;
             }
-            for (const auto& b : r.m_Res.m_Bodies)
+        }
+        else
+            nCount = static_cast<size_t>(r.m_EndHeight - r.m_StartHeight); // the rest is covered by other requests
+
+        RequestBodyPacks(); // keep the window full while this one is being decoded
+
+        OnBodiesReceived(r.m_StartHeight, vBodies, nCount);
+    }
+
+    void Wallet::OnBodiesReceived(Height h0, const std::vector<proto::BodyBuffers>& vBodies, size_t nCount)
+    {
+        assert(nCount <= vBodies.size());
+
+        BodyPackReady x;
+        size_t nOutputs = 0;
+        uint32_t t0_ms = GetTime_ms();
+
+        try
+        {
+            x.m_vBlocks.resize(nCount);
+            for (size_t i = 0; i < nCount; i++)
             {
-                ProcessBody(b, startHeight, recognizer);
+                DeserializeBody(vBodies[i], h0 + i, x.m_vBlocks[i]);
+                nOutputs += x.m_vBlocks[i].m_vOutputs.size();
+            }
+        }
+        catch (const std::exception&)
+        {
+            AbortBodiesRequests();
+            return;
+        }
+
+        // owner key recovery is context-free, done for all the blocks in parallel. Events are applied later, in height order
+        RecognizerHandler h(*this, m_WalletDB->get_OwnerKdf());
+        x.m_vPrepared.resize(nCount);
+        PrepareBlocks(x.m_vBlocks, h0, h.m_Account, x.m_vPrepared);
+
+        uint32_t dt_ms = GetTime_ms() - t0_ms;
+        BEAM_LOG_DEBUG() << "Recognized " << nCount << " blocks from " << h0 << ", outputs=" << nOutputs
+            << " in " << dt_ms << " ms (" << (nCount * 1000 / std::max<uint32_t>(dt_ms, 1)) << " blocks/s), packs in flight=" << m_PendingBodyPack.size();
+
+        m_BodyPacksReady[h0] = std::move(x);
+        ApplyBodyPacks();
+    }
+
+    void Wallet::ApplyBodyPacks()
+    {
+        RecognizerHandler h(*this, m_WalletDB->get_OwnerKdf());
+        NodeProcessor::Recognizer recognizer(h, m_Extra);
 
-                ++startHeight;
+        size_t nDone = 0;
+        try
+        {
+            while (!m_BodyPacksReady.empty())
+            {
+                auto it = m_BodyPacksReady.begin();
+                if (it->first != m_BodiesAppliedHi)
+                    break; // waiting for the preceding range
+
+                BodyPackReady& x = it->second;
+                for (size_t i = 0; i < x.m_vBlocks.size(); i++)
+                {
+                    recognizer.m_pPrepared = &x.m_vPrepared[i];
+                    ProcessBlock(x.m_vBlocks[i], m_BodiesAppliedHi, recognizer);
+                    m_BodiesAppliedHi++;
+                }
+
+                nDone += x.m_vBlocks.size();
+                m_BodyPacksReady.erase(it);
             }
-            assert(GetEventsHeightNext() == startHeight);
+        }
+        catch (const std::exception&)
+        {
+            AbortBodiesRequests();
+            return;
+        }
 
+        if (nDone)
+        {
+            assert(GetEventsHeightNext() == m_BodiesAppliedHi);
             m_WalletDB->set_ShieldedOuts(m_Extra.m_ShieldedOutputs);
+            NotifySyncProgress();
         }
-        catch (const std::exception&)
+    }
+
+    void Wallet::PrepareBlocks(const std::vector<Block::Body>& vBlocks, Height h0, const NodeProcessor::Account& acc, std::vector<NodeProcessor::Recognizer::Prepared>& vPrepared)
+    {
+        assert(vBlocks.size() == vPrepared.size());
+
+        struct Task
+            :public Executor::TaskSync
+        {
+            const std::vector<Block::Body>& m_vBlocks;
+            std::vector<NodeProcessor::Recognizer::Prepared>& m_vPrepared;
+            Height m_h0;
+            const NodeProcessor::Account& m_Acc;
+
+            Task(const std::vector<Block::Body>& vBlocks, std::vector<NodeProcessor::Recognizer::Prepared>& vPrepared, Height h0, const NodeProcessor::Account& acc)
+                :m_vBlocks(vBlocks)
+                ,m_vPrepared(vPrepared)
+                ,m_h0(h0)
+                ,m_Acc(acc)
+            {
+            }
+
+            void Exec(Executor::Context& ctx) override
+            {
+                uint32_t i0, nCount;
+                ctx.get_Portion(i0, nCount, static_cast<uint32_t>(m_vBlocks.size()));
+
+                for (uint32_t i = i0; i < i0 + nCount; i++)
+                    m_vPrepared[i].Prepare(m_vBlocks[i], m_h0 + i, m_Acc);
+            }
+
+        } task(vBlocks, vPrepared, h0, acc);
+
+#ifndef __EMSCRIPTEN__
+        if (vBlocks.size() > 1)
         {
+            if (!m_pRecognizeExecutor)
+                m_pRecognizeExecutor = std::make_unique<ExecutorMT_R>();
+
+            m_pRecognizeExecutor->ExecAll(task);
             return;
         }
+#endif // __EMSCRIPTEN__
+
+        for (size_t i = 0; i < vBlocks.size(); i++)
+            vPrepared[i].Prepare(vBlocks[i], h0 + i, acc);
     }
 
     void Wallet::OnRequestComplete(MyRequestBody& r)
@@ -1702,23 +1836,21 @@ namespace beam::wallet
                 RequestBodies(0, Rules::get().HeightGenesis);
                 return;
             }
-
-            ProcessBody(r.m_Res.m_Body, r.m_Height, recognizer);
-
-            if (r.m_Height < r.m_Msg.m_Top.m_Height)
-            {
-                RequestBodies(r.m_Height, r.m_Height+1);
-            }
         }
         catch (const std::exception&)
         {
             return;
         }
+
+        std::vector<proto::BodyBuffers> vBodies(1);
+        vBodies.front() = std::move(r.m_Res.m_Body);
+        OnBodiesReceived(r.m_Height, vBodies, 1);
+
+        RequestBodyPacks();
     }
 
-    void Wallet::ProcessBody(const proto::BodyBuffers& b, Height h, NodeProcessor::Recognizer& recognizer)
+    void Wallet::DeserializeBody(const proto::BodyBuffers& b, Height h, Block::Body& block)
     {
-        Block::Body block;
         Deserializer der;
         der.reset(b.m_Perishable);
 
@@ -1738,6 +1870,25 @@ namespace beam::wallet
 
         der.reset(b.m_Eternal);
         der& Cast::Down<TxVectors::Eternal>(block);
+
+        // remove asset kernels, we don't support them
+        auto& kernels = block.m_vKernels;
+        kernels.erase(std::remove_if(kernels.begin(), kernels.end(), [](const auto& k)
+        {
+            switch (k->get_Subtype())
+            {
+            case TxKernel::Subtype::AssetCreate:
+            case TxKernel::Subtype::AssetDestroy:
+            case TxKernel::Subtype::AssetEmit:
+                return true;
+            default:
+                return false;
+            }
+        }), kernels.end());
+    }
+
+    void Wallet::ProcessBlock(Block::Body& block, Height h, NodeProcessor::Recognizer& recognizer)
+    {
         PreprocessBlock(block);
 
         recognizer.m_Pos.m_Height = h;
@@ -1759,21 +1910,6 @@ namespace beam::wallet
                 input->m_Internal.m_Maturity = cit->second;
             }
         }
-
-        // remove asset kernels, we don't support them
-        auto& kernels = block.m_vKernels;
-        kernels.erase(std::remove_if(kernels.begin(), kernels.end(), [](const auto& k)
-        {
-            switch (k->get_Subtype())
-            {
-            case TxKernel::Subtype::AssetCreate:
-            case TxKernel::Subtype::AssetDestroy:
-            case TxKernel::Subtype::AssetEmit:
-                return true;
-            default:
-                return false;
-            }
-        }), kernels.end());
     }
 
     void Wallet::RequestBodies()
@@ -1836,16 +1972,43 @@ namespace beam::wallet
         if (!IsMobileNodeEnabled())
             return;
 
-        if (!m_PendingBodyPack.empty() || !m_PendingBody.empty())
-            return;
+        if (m_PendingBodyPack.empty() && m_PendingBody.empty() && m_BodyPacksReady.empty())
+        {
+            // the pipeline is idle, (re)start it
+            m_BodiesHeight0 = currentHeight;
+            m_BodiesRequestedHi = startHeight;
+            m_BodiesAppliedHi = startHeight;
+        }
 
-        Block::SystemState::Full newTip;
-        m_WalletDB->get_History().get_Tip(newTip);
+        RequestBodyPacks();
+    }
 
-        if (startHeight > newTip.m_Height)
+    void Wallet::RequestBodyPacks()
+    {
+        if (!IsMobileNodeEnabled())
             return;
 
-        Height hCountExtra = newTip.m_Height - startHeight;
+        Block::SystemState::Full tip;
+        m_WalletDB->get_History().get_Tip(tip);
+
+        while ((m_PendingBodyPack.size() < s_BodyPacksInFlight) && (m_BodiesRequestedHi <= tip.m_Height))
+        {
+            Height hEnd = m_BodiesRequestedHi + m_BodyPackSpan;
+            if (hEnd >= tip.m_Height)
+                hEnd = tip.m_Height + 1; // don't leave the tip block alone
+
+            if (!RequestBodyRange(m_BodiesRequestedHi, hEnd, tip))
+                break;
+
+            m_BodiesRequestedHi = hEnd;
+        }
+    }
+
+    bool Wallet::RequestBodyRange(Height hStart, Height hEnd, const Block::SystemState::Full& tip)
+    {
+        assert((hStart < hEnd) && (hEnd <= tip.m_Height + 1));
+
+        Height hCountExtra = tip.m_Height - hStart;
         if (hCountExtra)
         {
             MyRequestBodyPack::Ptr pReq(new MyRequestBodyPack);
@@ -1854,41 +2017,42 @@ namespace beam::wallet
             msg.m_FlagP = proto::BodyBuffers::Recovery1;
             msg.m_FlagE = proto::BodyBuffers::Full;
 
-            newTip.get_ID(pReq->m_Msg.m_Top);
+            tip.get_ID(pReq->m_Msg.m_Top);
 
             Height r = Rules::get().MaxRollback;
-            Height count = std::min(newTip.m_Height - currentHeight, r * 2);
-            pReq->m_StartHeight = startHeight;
+            Height count = std::min(tip.m_Height - m_BodiesHeight0, r * 2);
+            pReq->m_StartHeight = hStart;
+            pReq->m_EndHeight = hEnd;
             msg.m_CountExtra = hCountExtra;
-            msg.m_Height0 = currentHeight;
-            msg.m_HorizonLo1 = newTip.m_Height - count;
-            msg.m_HorizonHi1 = newTip.m_Height;
+            msg.m_Height0 = m_BodiesHeight0;
+            msg.m_HorizonLo1 = tip.m_Height - count;
+            msg.m_HorizonHi1 = tip.m_Height;
 
-            PostReqUnique(*pReq);
+            return PostReqUnique(*pReq);
         }
-        else
-        {
-            MyRequestBody::Ptr pReq(new MyRequestBody);
 
-            pReq->m_Msg.m_FlagP = proto::BodyBuffers::Recovery1;
-            pReq->m_Msg.m_FlagE = proto::BodyBuffers::Full;
+        MyRequestBody::Ptr pReq(new MyRequestBody);
 
-            newTip.get_ID(pReq->m_Msg.m_Top);
-            pReq->m_Height = pReq->m_Msg.m_Top.m_Height;
-            pReq->m_Msg.m_CountExtra = hCountExtra;
+        pReq->m_Msg.m_FlagP = proto::BodyBuffers::Recovery1;
+        pReq->m_Msg.m_FlagE = proto::BodyBuffers::Full;
 
-            PostReqUnique(*pReq);
-        }
+        tip.get_ID(pReq->m_Msg.m_Top);
+        pReq->m_Height = pReq->m_Msg.m_Top.m_Height;
+        pReq->m_Msg.m_CountExtra = hCountExtra;
+
+        return PostReqUnique(*pReq);
     }
 
 
     void Wallet::AbortBodiesRequests()
     {
-        if (!m_PendingBodyPack.empty())
+        while (!m_PendingBodyPack.empty())
             DeleteReq(*m_PendingBodyPack.begin());
 
         if (!m_PendingBody.empty())
             DeleteReq(*m_PendingBody.begin());
+
+        m_BodyPacksReady.clear();
     }
 
     void Wallet::RequestEvents()
@@ -1901,6 +2065,8 @@ namespace beam::wallet
         Block::SystemState::Full sTip;
         m_WalletDB->get_History().get_Tip(sTip);
 
+        ApplyEventsPush(); // if pushed by the node - no need to request
+
         Height h = GetEventsHeightNext();
         assert(h <= sTip.m_Height + 1);
         if (h > sTip.m_Height)
@@ -1922,9 +2088,52 @@ namespace beam::wallet
     {
         if (!m_PendingEvents.empty())
             DeleteReq(*m_PendingEvents.begin());
+
+        m_EventsPush.m_HeightMax = 0;
     }
 
-    void Wallet::OnRequestComplete(MyRequestEvents& r)
+    void Wallet::OnEventsPush(Height hMin, Height hMax, const ByteBuffer& buf)
+    {
+        // Accept only if it continues our events stream, and no explicit request is in progress. Otherwise just ignore it, the events will be requested
+        if (!m_PendingEvents.empty() || (GetEventsHeightNext() != hMin))
+            return;
+
+        m_EventsPush.m_HeightMin = hMin;
+        m_EventsPush.m_HeightMax = hMax;
+        m_EventsPush.m_Events = buf;
+
+        Block::SystemState::Full sTip;
+        m_WalletDB->get_History().get_Tip(sTip);
+
+        if (hMax <= sTip.m_Height)
+            ApplyEventsPush(); // otherwise wait for the tip
+    }
+
+    bool Wallet::ApplyEventsPush()
+    {
+        if (!m_EventsPush.m_HeightMax)
+            return false;
+
+        Block::SystemState::Full sTip;
+        m_WalletDB->get_History().get_Tip(sTip);
+
+        if (m_EventsPush.m_HeightMax > sTip.m_Height)
+            return false;
+
+        bool bValid = (m_EventsPush.m_HeightMin == GetEventsHeightNext());
+        if (bValid)
+        {
+            Height hLast = 0;
+            ProcessEvents(m_EventsPush.m_Events, hLast);
+            SetEventsHeight(m_EventsPush.m_HeightMax);
+        }
+
+        m_EventsPush.m_HeightMax = 0;
+        m_EventsPush.m_Events.clear();
+        return bValid;
+    }
+
+    uint32_t Wallet::ProcessEvents(const ByteBuffer& buf, Height& hLast)
     {
         struct MyParser
             :public proto::Event::IGroupParser
@@ -1949,7 +2158,15 @@ namespace beam::wallet
 
         } p(*this);
 
-        uint32_t nCount = p.Proceed(r.m_Res.m_Events);
+        uint32_t nCount = p.Proceed(buf);
+        hLast = p.m_Height;
+        return nCount;
+    }
+
+    void Wallet::OnRequestComplete(MyRequestEvents& r)
+    {
+        Height hLast = 0;
+        uint32_t nCount = ProcessEvents(r.m_Res.m_Events, hLast);
 
         if (nCount < proto::Event::s_Max)
         {
@@ -1962,7 +2179,7 @@ namespace beam::wallet
         }
         else
         {
-            SetEventsHeight(p.m_Height);
+            SetEventsHeight(hLast);
             RequestEvents(); // maybe more events pending
         }
     }
@@ -2098,6 +2315,7 @@ namespace beam::wallet
 
         m_WalletDB->setSystemStateID(id);
         m_WalletDB->get_History().DeleteFrom(sTip.m_Height + 1);
+        AbortBodiesRequests(); // the downloaded bodies may belong to the abandoned branch, restarted on the new tip
         m_WalletDB->rollbackConfirmedUtxo(sTip.m_Height);
         m_WalletDB->rollbackConfirmedShieldedUtxo(sTip.m_Height);
         m_WalletDB->rollbackAssets(sTip.m_Height);
@@ -249,6 +249,7 @@ namespace beam::wallet
         Block::SystemState::IHistory& get_History() override;
         void OnOwnedNode(const PeerID&, bool bUp) override;
         void OnEventsSerif(const ECC::Hash::Value&, Height) override;
+        void OnEventsPush(Height hMin, Height hMax, const ByteBuffer&) override;
         void OnNewPeer(const PeerID& id, io::Address address) override;
         void OnDependentStateChanged() override;
 
@@ -276,14 +277,22 @@ namespace beam::wallet
         void UpdateOnSynced(BaseTransaction::Ptr tx);
         void UpdateOnNextTip(BaseTransaction::Ptr tx);
         void SaveKnownState();
-        void ProcessBody(const proto::BodyBuffers& b, Height h, NodeProcessor::Recognizer& recoginzer);
+        void DeserializeBody(const proto::BodyBuffers& b, Height h, Block::Body& block);
+        void ProcessBlock(Block::Body& block, Height h, NodeProcessor::Recognizer& recognizer);
+        void PrepareBlocks(const std::vector<Block::Body>& vBlocks, Height h0, const NodeProcessor::Account&, std::vector<NodeProcessor::Recognizer::Prepared>&);
         void PreprocessBlock(TxVectors::Full& block);
         void RequestBodies();
         void RequestTreasury();
         void RequestBodies(Height currentHeight, Height startHeight);
+        void RequestBodyPacks();
+        bool RequestBodyRange(Height hStart, Height hEnd, const Block::SystemState::Full& tip);
+        void OnBodiesReceived(Height h0, const std::vector<proto::BodyBuffers>& vBodies, size_t nCount);
+        void ApplyBodyPacks();
         void AbortBodiesRequests();
         void RequestEvents();
         void AbortEvents();
+        uint32_t ProcessEvents(const ByteBuffer&, Height& hLast);
+        bool ApplyEventsPush();
         void ProcessEventUtxo(const proto::Event::Utxo& utxoEvt, Height h);
         void ProcessEventUtxo(const CoinID&, Height h, Height hMaturity, bool bAdd, const Output::User& user);
         void ProcessEventAsset(const proto::Event::AssetCtl& assetCtl, Height h);
@@ -382,6 +391,7 @@ namespace beam::wallet
             struct BodyPack
             {
                 Height m_StartHeight = MaxHeight;
+                Height m_EndHeight = MaxHeight; // requested range end (exclusive), the node may return less
             };
             struct Body
             {
@@ -545,6 +555,13 @@ namespace beam::wallet
         size_t m_BlocksDone = 0;
         uint32_t m_OwnedNodesOnline;
 
+        struct EventsPush
+        {
+            Height m_HeightMin = 0;
+            Height m_HeightMax = 0; // 0 if none
+            ByteBuffer m_Events;
+        } m_EventsPush; // pushed by the owned node, waiting for the tip to reach them
+
         std::vector<IWalletObserver*> m_subscribers;
         ISimpleSwapHandler* m_ssHandler = nullptr;
 
@@ -558,6 +575,22 @@ namespace beam::wallet
         bool m_IsTreasuryHandled = false;
         std::map<ECC::Point, Height> m_Commitments;
         bool m_IsCommitmentsCached = false;
+        std::unique_ptr<ExecutorMT_R> m_pRecognizeExecutor; // created on demand, for the owner key recovery of the body packs
+
+        // bodies download pipeline: several packs of disjoint height ranges are requested simultaneously,
+        // each is decoded upon arrival, and the results are applied strictly in height order
+        struct BodyPackReady
+        {
+            std::vector<Block::Body> m_vBlocks;
+            std::vector<NodeProcessor::Recognizer::Prepared> m_vPrepared;
+        };
+        std::map<Height, BodyPackReady> m_BodyPacksReady; // decoded, waiting for the preceding ones
+        Height m_BodiesHeight0 = 0;
+        Height m_BodiesRequestedHi = 0; // next height to request
+        Height m_BodiesAppliedHi = 0; // next height to apply
+        Height m_BodyPackSpan = s_BodyPackSpanDefault; // num of blocks per pack, adjusted to what the node actually returns
+        static const Height s_BodyPackSpanDefault = 500;
+        static const size_t s_BodyPacksInFlight = 4;
 
         // the queue of actions to be performed after wallet synchronization
         using ActionQueue = std::queue<OnSyncAction>;
@@ -284,6 +284,28 @@ namespace fs = std::filesystem;
     each(CreateTime, Timestamp) \
     BEAM_TX_LIST_FILTER_MAP(each)
 
+// Raw (serialized) values of the TxDescription fields, kept in tx_summary as Raw<id> columns, so that the tx listing
+// doesn't need to reassemble each tx from txparams. Must cover BEAM_TX_DESCRIPTION_INITIAL_PARAMS
+#define ENUM_TX_SUMMARY_PROJECTION_FIELDS(each) \
+    each(TransactionType) \
+    each(Amount) \
+    each(Fee) \
+    each(AssetID) \
+    each(AssetMetadata) \
+    each(MinHeight) \
+    each(PeerAddr) \
+    each(MyAddr) \
+    each(Message) \
+    each(CreateTime) \
+    each(ModifyTime) \
+    each(IsSender) \
+    each(IsSelfTx) \
+    each(Status) \
+    each(KernelID) \
+    each(FailureReason) \
+    each(AppID) \
+    each(AppName)
+
 #define ENUM_IM_FIELDS(each, sep, obj) \
     each(id,          id,             INTEGER PRIMARY KEY AUTOINCREMENT, obj) sep \
     each(timestamp,   timestamp,      INTEGER NOT NULL, obj) sep \
@@ -363,6 +385,80 @@ namespace beam::wallet
             {
             }
 
+            static const uint32_t s_ExactMaxInputs = 16;
+            static const uint32_t s_ExactMaxTries = 0x10000;
+
+            std::vector<Amount> m_vSum; // m_vSum[i] - sum of the first i coins, saturated
+
+            // Branch-and-bound search for the subset that matches the amount exactly, so that no change output is needed.
+            // Bigger coins are tried first, hence the solution (if found) tends to have fewer inputs.
+            bool SelectExact(Amount amount, Result& res)
+            {
+                m_vSum.resize(m_Coins.size() + 1);
+                m_vSum[0] = 0;
+                for (size_t i = 0; i < m_Coins.size(); i++)
+                {
+                    Amount v = m_vSum[i] + m_Coins[i].m_ID.m_Value;
+                    m_vSum[i + 1] = (v < m_vSum[i]) ? Amount(-1) : v;
+                }
+
+                uint32_t nTries = s_ExactMaxTries;
+                res.second.clear();
+
+                if (!SearchExact(m_Coins.size(), amount, res.second, nTries))
+                {
+                    res.second.clear();
+                    return false;
+                }
+
+                res.first = amount;
+                return true;
+            }
+
+            bool SearchExact(size_t iEnd, Amount nLeft, Indexes& vSel, uint32_t& nTries) const
+            {
+                if (!nLeft)
+                    return true;
+
+                if (vSel.size() >= s_ExactMaxInputs)
+                    return false;
+
+                // skip the coins bigger than needed
+                size_t i = std::upper_bound(m_Coins.begin(), m_Coins.begin() + iEnd, nLeft,
+                    [](Amount v, const Coin& c) { return v < c.m_ID.m_Value; }) - m_Coins.begin();
+
+                size_t nInputs = s_ExactMaxInputs - vSel.size();
+
+                while (CanReach(i, nInputs, nLeft))
+                {
+                    if (!nTries)
+                        return false;
+                    nTries--;
+
+                    Amount v = m_Coins[--i].m_ID.m_Value;
+                    if (!v)
+                        break;
+
+                    vSel.push_back(i);
+                    if (SearchExact(i, nLeft - v, vSel, nTries))
+                        return true;
+                    vSel.pop_back();
+
+                    // coins of the same value would yield the same branches
+                    while (i && (m_Coins[i - 1].m_ID.m_Value == v))
+                        i--;
+                }
+
+                return false;
+            }
+
+            bool CanReach(size_t iEnd, size_t nInputs, Amount nLeft) const
+            {
+                // max sum of nInputs coins below iEnd
+                size_t i0 = (iEnd > nInputs) ? (iEnd - nInputs) : 0;
+                return (m_vSum[iEnd] - m_vSum[i0]) >= nLeft;
+            }
+
             static const uint32_t s_Factor = 16;
             static const uint64_t s_NoOverflowSrc = uint64_t(-1) / s_Factor;
 
@@ -1025,7 +1121,8 @@ namespace beam::wallet
         const uint8_t kDefaultMaxPrivacyLockTimeLimitHours = 72;
         const int BusyTimeoutMs = 5000;
 
-        const int DbVersion   = 38;
+        const int DbVersion   = 39;
+        const int DbVersion38 = 38;
         const int DbVersion37 = 37;
         const int DbVersion36 = 36;
         const int DbVersion35 = 35;
@@ -1377,6 +1474,17 @@ namespace beam::wallet
             throwIfError(ret, db);
         }
 
+        void CreateTxSummaryProjection(sqlite3* db)
+        {
+            assert(db != nullptr);
+            // The table is WITHOUT ROWID, hence CreateTimeIndex implicitly ends with TxID, and serves the (CreateTime, TxID) listing order as well
+#define MACRO(id) "ALTER TABLE " TX_SUMMARY_NAME " ADD COLUMN Raw" #id " BLOB;"
+            const char* req = ENUM_TX_SUMMARY_PROJECTION_FIELDS(MACRO);
+#undef MACRO
+            const auto ret = sqlite3_exec(db, req, nullptr, nullptr, nullptr);
+            throwIfError(ret, db);
+        }
+
         void MigrateAssetsFrom20(sqlite3* db)
         {
             assert(db != nullptr);
@@ -1931,6 +2039,7 @@ namespace beam::wallet
         CreateExchangeRatesHistoryTable(db);
         CreateEventsTable(db);
         CreateTxSummaryTable(db);
+        CreateTxSummaryProjection(db);
         CreateVerificationTable(db);
         CreateDexOffersTable(db);
         CreateIMTables(db);
@@ -2508,6 +2617,12 @@ namespace beam::wallet
 
                     CreateTxParamsIndex(walletDB->_db);
                     CreateAppDataTable(walletDB->_db);
+                    // no break
+
+                case DbVersion38:
+                    BEAM_LOG_INFO() << "Converting DB from format 38...";
+                    CreateTxSummaryProjection(walletDB->_db);
+                    walletDB->FillTxSummaryProjection();
 
                     storage::setVar(*walletDB, Version, DbVersion);
                     // no break
@@ -3226,33 +3341,33 @@ namespace beam::wallet
         Block::SystemState::ID stateID = {};
         getSystemStateID(stateID);
 
+        if (!m_CoinIndex.m_Valid)
+            BuildCoinIndex();
+
+        auto itAsset = m_CoinIndex.m_Assets.find(assetId);
+        if (m_CoinIndex.m_Assets.end() != itAsset)
         {
-            const char* query = "SELECT " STORAGE_FIELDS " FROM " STORAGE_NAME " WHERE maturity>=0 AND maturity<=?1 AND spentHeight<0 ORDER BY amount ASC";
+            for (const auto& v : itAsset->second)
+            {
+                const Coin& c = v.second;
+                if (c.get_Maturity() > stateID.m_Height)
+                    continue; // maturing, the min confirmations offset is already set
 
-            sqlite::Statement stm(this, query);
-            stm.bind(1, stateID.m_Height);
+                if (storage::IsOngoingTx(*this, c.m_spentTxId))
+                    continue; // outgoing
 
-            while (stm.step())
-            {
-                auto& coin = coins.emplace_back();
-                int colIdx = 0;
-                ENUM_ALL_STORAGE_FIELDS(STM_GET_LIST, NOSEP, coin);
+                auto& coin = coins.emplace_back(c);
+                coin.m_status = Coin::Status::Available;
 
-                storage::DeduceStatus(*this, coin, stateID.m_Height);
-                if (Coin::Status::Available != coin.m_status)
-                    coins.pop_back();
-                else if (coin.m_ID.m_AssetID != assetId)
-                    coins.pop_back();
-                else
-                {
-                    if (coin.m_ID.m_Value >= amount)
-                        break;
-                }
+                if (coin.m_ID.m_Value >= amount)
+                    break;
             }
         }
 
         CoinSelector csel(coins);
-        CoinSelector::Result res = csel.Select(amount);
+        CoinSelector::Result res;
+        if (!csel.SelectExact(amount, res))
+            res = csel.Select(amount);
 
         if (res.first >= amount)
         {
@@ -3373,6 +3488,8 @@ namespace beam::wallet
         int colIdx = 0;
         ENUM_ALL_STORAGE_FIELDS(STM_BIND_LIST, NOSEP, coin);
         stm.step();
+
+        IndexCoin(coin);
     }
 
     void WalletDB::insertNewCoin(Coin& coin)
@@ -3396,7 +3513,11 @@ namespace beam::wallet
         ENUM_STORAGE_ID(STM_BIND_LIST, NOSEP, coin);
         stm.step();
 
-        return sqlite3_changes(_db) > 0;
+        if (sqlite3_changes(_db) <= 0)
+            return false;
+
+        IndexCoin(coin);
+        return true;
     }
 
     bool WalletDB::saveCoinRaw(const Coin& coin)
@@ -3561,15 +3682,91 @@ namespace beam::wallet
         STORAGE_BIND_ID(wrp)
 
         stm.step();
+
+        m_CoinIndex.OnRemoved(cid);
     }
 
     void WalletDB::clearCoins()
     {
         sqlite::Statement stm(this, "DELETE FROM " STORAGE_NAME ";");
         stm.step();
+        m_CoinIndex.Reset(true);
         notifyCoinsChanged(ChangeAction::Reset, {});
     }
 
+    bool WalletDB::CoinIndex::Cmp::operator()(const Coin::ID& a, const Coin::ID& b) const
+    {
+        if (a.m_Value != b.m_Value)
+            return a.m_Value < b.m_Value;
+
+        // the asset is the same within the set
+        return static_cast<const Key::ID&>(a).cmp(b) < 0;
+    }
+
+    bool WalletDB::CoinIndex::IsCandidate(const Coin& c)
+    {
+        // the rest (maturity vs height, outgoing txs) depends on the current state, and is checked on selection
+        return
+            (MaxHeight == c.m_spentHeight) &&
+            (MaxHeight != c.m_confirmHeight) &&
+            (MaxHeight != c.m_maturity);
+    }
+
+    void WalletDB::IndexCoin(const Coin& c)
+    {
+        if (!m_CoinIndex.m_Valid)
+            return;
+
+        if (!CoinIndex::IsCandidate(c))
+        {
+            m_CoinIndex.OnRemoved(c.m_ID);
+            return;
+        }
+
+        Coin& dst = m_CoinIndex.m_Assets[c.m_ID.m_AssetID][c.m_ID];
+        dst = c;
+
+        // set once the tx is created, way before the coin is confirmed
+        uint32_t minConfirmations = 0;
+        if (c.m_createTxId && storage::getTxParameter(*this, c.m_createTxId.get(), TxParameterID::MinConfirmations, minConfirmations))
+            dst.setOffset(minConfirmations);
+    }
+
+    void WalletDB::CoinIndex::OnRemoved(const Coin::ID& cid)
+    {
+        if (!m_Valid)
+            return;
+
+        auto it = m_Assets.find(cid.m_AssetID);
+        if (m_Assets.end() == it)
+            return;
+
+        it->second.erase(cid);
+        if (it->second.empty())
+            m_Assets.erase(it);
+    }
+
+    void WalletDB::CoinIndex::Reset(bool bValid)
+    {
+        m_Assets.clear();
+        m_Valid = bValid;
+    }
+
+    void WalletDB::BuildCoinIndex()
+    {
+        m_CoinIndex.Reset(true);
+
+        sqlite::Statement stm(this, "SELECT " STORAGE_FIELDS " FROM " STORAGE_NAME " WHERE maturity>=0 AND spentHeight<0");
+        while (stm.step())
+        {
+            Coin coin;
+            int colIdx = 0;
+            ENUM_ALL_STORAGE_FIELDS(STM_GET_LIST, NOSEP, coin);
+
+            IndexCoin(coin);
+        }
+    }
+
     void WalletDB::setCoinConfirmationsOffset(uint32_t offset)
     {
         setVarRaw(COIN_CONFIRMATIONS_COUNT, &offset, sizeof(uint32_t));
@@ -3794,8 +3991,12 @@ namespace beam::wallet
                 stm.bind(2, minHeight);
                 stm.step();
             }
+
+            auto coins = getCoinsByRowIDs(changedRows);
+            for (const auto& c : coins)
+                IndexCoin(c);
  
-            notifyCoinsChanged(ChangeAction::Updated, getCoinsByRowIDs(changedRows));
+            notifyCoinsChanged(ChangeAction::Updated, coins);
         }
     }
 
@@ -3974,12 +4175,8 @@ namespace beam::wallet
         notifyShieldedCoinsChanged(ChangeAction::Updated, v);
     }
 
-    void WalletDB::visitTx(std::function<bool(const TxDescription&)> func, const TxListFilter& filter) const
+    std::string WalletDB::get_TxListWhere(const TxListFilter& filter)
     {
-        helpers::StopWatch sw;
-        sw.start();
-
-        std::string query = "SELECT TxID FROM " TX_SUMMARY_NAME;
         std::vector<std::string> parts;
         std::string whereParams;
 
@@ -3991,6 +4188,21 @@ namespace beam::wallet
             parts.push_back(std::move(q)); \
         } 
         BEAM_TX_LIST_NORMAL_PARAM_MAP(MACRO)
+
+        if (!filter.m_TransactionTypes.empty())
+        {
+            std::string q("TransactionType IN (");
+            for (size_t i = 0; i < filter.m_TransactionTypes.size(); ++i)
+            {
+                if (i)
+                {
+                    q.append(",");
+                }
+                q.append(std::to_string((int)filter.m_TransactionTypes[i]));
+            }
+            q.append(")");
+            parts.push_back(std::move(q));
+        }
         
         if (!parts.empty())
         {
@@ -4014,13 +4226,24 @@ namespace beam::wallet
                        .append(")");
         }
 
+        return whereParams;
+    }
+
+    void WalletDB::visitTx(std::function<bool(const TxDescription&)> func, const TxListFilter& filter) const
+    {
+        helpers::StopWatch sw;
+        sw.start();
+
+        std::string query = "SELECT TxID FROM " TX_SUMMARY_NAME;
+        std::string whereParams = get_TxListWhere(filter);
+
         if (!whereParams.empty())
         {
             query.append(" WHERE ");
             query.append(whereParams);
         }
         
-        query.append(" ORDER BY CreateTime DESC");
+        query.append(" ORDER BY CreateTime DESC, TxID DESC");
 
         sqlite::Statement stm(this, query.c_str());
         sqlite::Statement stm2(this, "SELECT * FROM " TX_PARAMS_NAME " WHERE txID=?1;");
@@ -4043,6 +4266,80 @@ namespace beam::wallet
         BEAM_LOG_DEBUG() << "visitTx elapsed time: " << sw.milliseconds() << " ms";
     }
 
+    void WalletDB::visitTxSummary(std::function<bool(const TxDescription&)> func, const TxListFilter& filter, const TxListPage& page) const
+    {
+        helpers::StopWatch sw;
+        sw.start();
+
+#define MACRO(id) ",Raw" #id
+        std::string query = "SELECT TxID" ENUM_TX_SUMMARY_PROJECTION_FIELDS(MACRO) " FROM " TX_SUMMARY_NAME;
+#undef MACRO
+
+        // same as m_mandatoryTxParams
+        query.append(" WHERE TransactionType IS NOT NULL AND CreateTime IS NOT NULL");
+
+        std::string whereParams = get_TxListWhere(filter);
+        if (!whereParams.empty())
+        {
+            query.append(" AND ");
+            query.append(whereParams);
+        }
+
+        if (page.m_After)
+        {
+            query.append(" AND (CreateTime<?1 OR (CreateTime=?1 AND TxID<?2))");
+        }
+
+        query.append(" ORDER BY CreateTime DESC, TxID DESC LIMIT ?3 OFFSET ?4");
+
+        sqlite::Statement stm(this, query.c_str());
+        if (page.m_After)
+        {
+            stm.bind(1, page.m_After->m_CreateTime);
+            stm.bind(2, page.m_After->m_TxID);
+        }
+        if (page.m_Count)
+        {
+            stm.bind(3, page.m_Count);
+        }
+        else
+        {
+            stm.bind(3, -1); // no limit
+        }
+        stm.bind(4, page.m_Skip);
+
+        ByteBuffer buf;
+        while (stm.step())
+        {
+            TxID txID;
+            stm.get(0, txID);
+
+            TxDescription txDescription(txID);
+            int colIdx = 1;
+
+#define MACRO(id) \
+            if (!stm.IsNull(colIdx)) \
+            { \
+                stm.get(colIdx, buf); \
+                txDescription.SetParameter(TxParameterID::id, std::move(buf)); \
+            } \
+            colIdx++;
+
+            ENUM_TX_SUMMARY_PROJECTION_FIELDS(MACRO)
+#undef MACRO
+
+            txDescription.fillFromTxParameters(txDescription);
+
+            if (!func(txDescription))
+            {
+                break;
+            }
+        }
+
+        sw.stop();
+        BEAM_LOG_DEBUG() << "visitTxSummary elapsed time: " << sw.milliseconds() << " ms";
+    }
+
     vector<TxDescription> WalletDB::getTxHistory(wallet::TxType txType, uint64_t start, int count) const
     {
         // TODO this is temporary solution
@@ -4235,7 +4532,12 @@ namespace beam::wallet
                 stm.bind(1, txId);
                 stm.step();
             }
-            notifyCoinsChanged(ChangeAction::Updated, getCoinsByRowIDs(updatedRows));
+
+            auto coins = getCoinsByRowIDs(updatedRows);
+            for (const auto& c : coins)
+                IndexCoin(c);
+
+            notifyCoinsChanged(ChangeAction::Updated, coins);
         }
     }
 
@@ -4262,6 +4564,9 @@ namespace beam::wallet
             stm.bind(2, MaxHeight);
             stm.step();
 
+            for (const auto& c : deletedItems)
+                m_CoinIndex.OnRemoved(c.m_ID);
+
             notifyCoinsChanged(ChangeAction::Removed, deletedItems);
         }
     }
@@ -5579,6 +5884,23 @@ namespace beam::wallet
     }
 
 
+    void WalletDB::FillTxSummaryProjection()
+    {
+        // txparams primary key is (txID,subTxID,paramID), so that each subquery is a single lookup
+        char szQuery[0x200];
+
+#define THE_MACRO(id) \
+        snprintf(szQuery, _countof(szQuery), "UPDATE " TX_SUMMARY_NAME " SET Raw" #id "=(SELECT value FROM " TX_PARAMS_NAME " WHERE txID=" TX_SUMMARY_NAME ".TxID AND subTxID=%d AND paramID=%d)", \
+            (int) kDefaultSubTxID, (int) TxParameterID::id); \
+        { \
+            int ret = sqlite3_exec(_db, szQuery, nullptr, nullptr, nullptr); \
+            throwIfError(ret, _db); \
+        }
+
+        ENUM_TX_SUMMARY_PROJECTION_FIELDS(THE_MACRO)
+#undef THE_MACRO
+    }
+
     void WalletDB::OnTxSummaryParam(const TxID& txID, SubTxID subTxID, TxParameterID paramID, const ByteBuffer* pBlob)
     {
         if (kDefaultSubTxID != subTxID)
@@ -5594,6 +5916,50 @@ namespace beam::wallet
             break;
 #undef THE_MACRO
         }
+
+        switch (paramID)
+        {
+#define THE_MACRO(id) case TxParameterID::id: OnTxSummaryRaw(txID, "Raw" #id, pBlob); break;
+        ENUM_TX_SUMMARY_PROJECTION_FIELDS(THE_MACRO)
+
+        default:
+            // suppress warning
+            break;
+#undef THE_MACRO
+        }
+    }
+
+    void WalletDB::OnTxSummaryRaw(const TxID& txID, const char* szName, const ByteBuffer* pBlob)
+    {
+        char szQuery[0x100];
+        snprintf(szQuery, _countof(szQuery), "UPDATE " TX_SUMMARY_NAME " SET %s=?1 WHERE TxID=?2", szName);
+
+        {
+            sqlite::Statement stm(this, szQuery);
+            stm.bind(2, txID);
+
+            if (pBlob)
+            {
+                stm.bind(1, Blob(*pBlob));
+            }
+            else
+            {
+                stm.bind(1, nullptr);
+            }
+
+            stm.step();
+        }
+
+        if (!sqlite3_changes(_db) && pBlob)
+        {
+            snprintf(szQuery, _countof(szQuery), "INSERT INTO " TX_SUMMARY_NAME " (TxID,%s) VALUES(?1,?2)", szName);
+
+            sqlite::Statement stm(this, szQuery);
+            stm.bind(1, txID);
+            stm.bind(2, Blob(*pBlob));
+
+            stm.step();
+        }
     }
 
     template<typename T>
@@ -5772,6 +6138,18 @@ namespace beam::wallet
         onFlushTimer();
     }
 
+    void WalletDB::commitPending()
+    {
+        flushDB();
+    }
+
+    void WalletDB::dropCaches()
+    {
+        m_TxParametersCache.clear();
+        m_CoinIndex.Reset(false);
+        m_History.CheckCacheTip(); // a single row lookup, unlike the reload of the whole cache
+    }
+
     void WalletDB::rollbackDB()
     {
         if (m_IsFlushPending)
@@ -5785,6 +6163,9 @@ namespace beam::wallet
             m_DbTransaction->rollback();
             m_DbTransaction.reset();
         }
+
+        m_CoinIndex.Reset(false);
+        m_History.m_Cache.Reset(false);
     }
 
     void WalletDB::onModified()
@@ -5895,7 +6276,7 @@ namespace beam::wallet
         Block::SystemState::Full s;
         if (m_History.get_Tip(s))
         {
-            const Height hMaxBacklog = Rules::get().MaxRollback * 2; // can actually be more
+            const Height hMaxBacklog = History::get_MaxBacklog();
 
             if (s.m_Height > hMaxBacklog)
             {
@@ -5904,6 +6285,7 @@ namespace beam::wallet
                 stm.bind(1, s.m_Height - hMaxBacklog);
                 stm.step();
 
+                m_History.m_Cache.OnDeletedTill(s.m_Height - hMaxBacklog);
             }
         }
     }
@@ -6019,8 +6401,153 @@ namespace beam::wallet
         }
     }
 
+    Height WalletDB::History::get_MaxBacklog()
+    {
+        return Rules::get().MaxRollback * 2; // can actually be more
+    }
+
+    const Block::SystemState::Full* WalletDB::History::Cache::Find(Height h) const
+    {
+        if (m_States.empty() || (h < m_States.front().m_Height))
+            return nullptr;
+
+        Height dh = h - m_States.front().m_Height;
+        if (dh >= m_States.size())
+            return nullptr;
+
+        return &m_States[dh];
+    }
+
+    void WalletDB::History::Cache::OnAdded(const Block::SystemState::Full& s)
+    {
+        if (!m_Valid)
+            return;
+
+        // valid empty cache means there are no states at all
+        if (!m_States.empty())
+        {
+            Height hTip = m_States.back().m_Height;
+            if (s.m_Height <= hTip)
+            {
+                // below the cached range the db is the only storage
+                if (s.m_Height >= m_States.front().m_Height)
+                    m_States[s.m_Height - m_States.front().m_Height] = s;
+                return;
+            }
+
+            if (s.m_Height > hTip + 1)
+                m_States.clear(); // gap, cached states must be consecutive
+        }
+
+        m_States.push_back(s);
+
+        while (m_States.size() > get_MaxBacklog())
+            m_States.pop_front();
+    }
+
+    void WalletDB::History::Cache::OnDeletedFrom(Height h)
+    {
+        while (!m_States.empty() && (m_States.back().m_Height >= h))
+            m_States.pop_back();
+
+        if (m_States.empty())
+            m_Valid = false; // there may be older states in the db
+    }
+
+    void WalletDB::History::Cache::OnDeletedTill(Height h)
+    {
+        while (!m_States.empty() && (m_States.front().m_Height <= h))
+            m_States.pop_front();
+
+        if (m_States.empty())
+            m_Valid = false;
+    }
+
+    void WalletDB::History::Cache::Reset(bool bValid)
+    {
+        m_States.clear();
+        m_Valid = bValid;
+    }
+
+    void WalletDB::History::EnsureCache()
+    {
+        if (m_Cache.m_Valid)
+            return;
+
+        m_Cache.Reset(true);
+
+        const char* req = "SELECT " TblStates_Hdr " FROM " TblStates " ORDER BY " TblStates_Height " DESC LIMIT ?;";
+        sqlite::Statement stm(&get_ParentObj(), req);
+        stm.bind(1, get_MaxBacklog());
+
+        while (stm.step())
+        {
+            Block::SystemState::Full s;
+            stm.get(0, s);
+
+            auto& v = m_Cache.m_States;
+            if (!v.empty() && (s.m_Height + 1 != v.front().m_Height))
+                break;
+
+            v.push_front(s);
+        }
+    }
+
+    void WalletDB::History::CheckCacheTip()
+    {
+        if (!m_Cache.m_Valid)
+            return;
+
+        const char* req = "SELECT " TblStates_Hdr " FROM " TblStates " ORDER BY " TblStates_Height " DESC LIMIT 1;";
+        sqlite::Statement stm(&get_ParentObj(), req);
+
+        if (stm.step())
+        {
+            if (!m_Cache.m_States.empty())
+            {
+                Block::SystemState::Full s;
+                stm.get(0, s);
+
+                Merkle::Hash hv0, hv1;
+                s.get_Hash(hv0);
+                m_Cache.m_States.back().get_Hash(hv1);
+
+                if (hv0 == hv1)
+                    return;
+            }
+        }
+        else
+        {
+            if (m_Cache.m_States.empty())
+                return;
+        }
+
+        m_Cache.Reset(false);
+    }
+
     bool WalletDB::History::Enum(IWalker& w, const Height* pBelow)
     {
+        EnsureCache();
+
+        const auto& v = m_Cache.m_States;
+        if (!v.empty())
+        {
+            size_t n = v.size();
+            if (pBelow)
+            {
+                Height h0 = v.front().m_Height;
+                n = (*pBelow > h0) ? static_cast<size_t>(std::min<Height>(n, *pBelow - h0)) : 0;
+            }
+
+            while (n--)
+                if (!w.OnState(v[n]))
+                    return false;
+
+            // the rest is below the cached range
+            if (!pBelow || (*pBelow > v.front().m_Height))
+                pBelow = &v.front().m_Height;
+        }
+
         const char* req = pBelow ?
             "SELECT " TblStates_Hdr " FROM " TblStates " WHERE " TblStates_Height "<? ORDER BY " TblStates_Height " DESC;" :
             "SELECT " TblStates_Hdr " FROM " TblStates " ORDER BY " TblStates_Height " DESC;";
@@ -6044,6 +6571,18 @@ namespace beam::wallet
 
     bool WalletDB::History::get_At(Block::SystemState::Full& s, Height h)
     {
+        EnsureCache();
+
+        const auto* pS = m_Cache.Find(h);
+        if (pS)
+        {
+            s = *pS;
+            return true;
+        }
+
+        if (!m_Cache.m_States.empty() && (h > m_Cache.m_States.back().m_Height))
+            return false; // above the tip
+
         const char* req = "SELECT " TblStates_Hdr " FROM " TblStates " WHERE " TblStates_Height "=?";
 
         sqlite::Statement stm(&get_ParentObj(), req);
@@ -6069,6 +6608,8 @@ namespace beam::wallet
             stm.bind(1, pS[i].m_Height);
             stm.bind(2, pS[i]);
             stm.step();
+
+            m_Cache.OnAdded(pS[i]);
         }
     }
 
@@ -6078,6 +6619,8 @@ namespace beam::wallet
         sqlite::Statement stm(&get_ParentObj(), req);
         stm.bind(1, h);
         stm.step();
+
+        m_Cache.OnDeletedFrom(h);
     }
 
     bool WalletDB::get_AppData(const Blob& name, const Blob& key, ByteBuffer& res)
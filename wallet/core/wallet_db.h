@@ -25,6 +25,7 @@
 #  pragma clang diagnostic pop
 #endif
 
+#include <deque>
 #include <tuple>
 #include "core/common.h"
 #include "core/ecc_native.h"
@@ -255,6 +256,22 @@ namespace beam::wallet
 #define MACRO(id, type) boost::optional<type> m_##id;
         BEAM_TX_LIST_FILTER_MAP(MACRO)
 #undef MACRO
+        std::vector<TxType> m_TransactionTypes; // if not empty - the tx type must be one of those
+    };
+
+    // Window of the tx listing, which is ordered by (CreateTime, TxID), newest first.
+    // Prefer the keyset cursor over m_Skip for deep pages: it seeks directly instead of walking over the skipped rows.
+    struct TxListPage
+    {
+        struct Cursor
+        {
+            Timestamp m_CreateTime;
+            TxID m_TxID;
+        };
+
+        boost::optional<Cursor> m_After; // start strictly after this tx (the last one of the previous page)
+        uint32_t m_Skip = 0;
+        uint32_t m_Count = 0; // 0 - unlimited
     };
 
     struct IWalletDB;
@@ -541,6 +558,9 @@ namespace beam::wallet
         // /////////////////////////////////////////////
         // Transaction management
         virtual void visitTx(std::function<bool(const TxDescription&)> func, const TxListFilter& filter) const = 0;
+        // Same order as visitTx, but the descriptions are built from the tx_summary projection only (fields of TxDescription),
+        // without reassembling all the tx parameters. Use getTx() for the txs that need the rest.
+        virtual void visitTxSummary(std::function<bool(const TxDescription&)> func, const TxListFilter& filter, const TxListPage& page) const = 0;
         virtual std::vector<TxDescription> getTxHistory(wallet::TxType txType = wallet::TxType::Simple, uint64_t start = 0, int count = std::numeric_limits<int>::max()) const = 0;
         virtual int getTxCount(wallet::TxType txType) const = 0;
         virtual boost::optional<TxDescription> getTx(const TxID& txId) const = 0;
@@ -653,6 +673,11 @@ namespace beam::wallet
         virtual void set_AppData(const Blob& name, const Blob&, const Blob*) {}
         virtual void ClearAppData(const Blob& name) {}
 
+        // commits the batched writes right away, so that they're visible via other connections to the same db
+        virtual void commitPending() {}
+        // drops in-memory caches, should be called before reading via a connection while the db is modified via another one
+        virtual void dropCaches() {}
+
        private:
            bool get_CommitmentSafe(ECC::Point& comm, const CoinID&, IPrivateKeyKeeper2*);
     };
@@ -735,6 +760,7 @@ namespace beam::wallet
         void rollbackConfirmedShieldedUtxo(Height minHeight) override;
 
         void visitTx(std::function<bool(const TxDescription&)> func, const TxListFilter& filter) const override;
+        void visitTxSummary(std::function<bool(const TxDescription&)> func, const TxListFilter& filter, const TxListPage& page) const override;
         std::vector<TxDescription> getTxHistory(wallet::TxType txType, uint64_t start, int count) const override;
         int getTxCount(wallet::TxType txType) const override;
         boost::optional<TxDescription> getTx(const TxID& txId) const override;
@@ -831,6 +857,9 @@ namespace beam::wallet
         void set_AppData(const Blob& name, const Blob&, const Blob*) override;
         void ClearAppData(const Blob& name) override;
 
+        void commitPending() override;
+        void dropCaches() override;
+
     private:
         static std::shared_ptr<WalletDB> initBase(const std::string& path, const SecString& password, bool separateDBForPrivateData);
 
@@ -891,9 +920,12 @@ namespace beam::wallet
         void OnTxSummaryParam(const TxID& txID, SubTxID subTxID, TxParameterID, const ByteBuffer*);
         template<typename T>
         void OnTxSummaryParam(const TxID& txID, const char* szName, const ByteBuffer*);
+        void OnTxSummaryRaw(const TxID& txID, const char* szName, const ByteBuffer*);
         void FillTxSummaryTable();
         template<typename T>
         void FillTxSummaryTableParam(const char* szField, TxParameterID paramID);
+        void FillTxSummaryProjection();
+        static std::string get_TxListWhere(const TxListFilter&);
 
         static bool IsSuitableDefaultAddr(const WalletAddress&);
 
@@ -923,11 +955,52 @@ namespace beam::wallet
             void AddStates(const Block::SystemState::Full*, size_t nCount) override;
             void DeleteFrom(Height) override;
 
+            // In-memory copy of the recent states: consecutive heights, the last one is the tip, indexed by height.
+            // Tip and recent headers lookups are served without db roundtrips. Loaded lazily, invalidated on db rollback.
+            struct Cache
+            {
+                std::deque<Block::SystemState::Full> m_States;
+                bool m_Valid = false;
+
+                const Block::SystemState::Full* Find(Height) const;
+                void OnAdded(const Block::SystemState::Full&);
+                void OnDeletedFrom(Height);
+                void OnDeletedTill(Height);
+                void Reset(bool bValid);
+            } m_Cache;
+
+            static Height get_MaxBacklog();
+            void EnsureCache();
+
+            // The db may be modified via another connection, the cache is reloaded only if the tip has been changed
+            void CheckCacheTip();
+
             IMPLEMENT_GET_PARENT_OBJ(WalletDB, m_History)
         } m_History;
         
         mutable ParameterCache m_TxParametersCache;
 
+        // In-memory index of the spendable candidates (confirmed and unspent coins), per asset, in ascending amount order.
+        // Built lazily on the 1st coin selection, then kept in sync with the coin writes. Invalidated on db rollback.
+        // The coins are kept with their min confirmations offset, so that the selection needs no db lookups except for the locked ones.
+        struct CoinIndex
+        {
+            struct Cmp {
+                bool operator()(const Coin::ID&, const Coin::ID&) const;
+            };
+
+            typedef std::map<Coin::ID, Coin, Cmp> Set;
+            std::map<Asset::ID, Set> m_Assets;
+            bool m_Valid = false;
+
+            static bool IsCandidate(const Coin&);
+            void OnRemoved(const Coin::ID&);
+            void Reset(bool bValid);
+        } m_CoinIndex;
+
+        void BuildCoinIndex();
+        void IndexCoin(const Coin&); // inserts, updates or removes, depending on the coin state
+
         struct LocalKeyKeeper;
         LocalKeyKeeper* m_pLocalKeyKeeper = nullptr;
         uint32_t m_coinConfirmationsOffset = 0;
@@ -1023,6 +1096,7 @@ namespace beam::wallet
 
         void DeduceStatus(const IWalletDB&, Coin&, Height hTop);
         void DeduceStatus(const IWalletDB&, ShieldedCoin&, Height hTop);
+        bool IsOngoingTx(const IWalletDB&, const boost::optional<TxID>&);
 
         bool isTreasuryHandled(const IWalletDB&);
         void setTreasuryHandled(IWalletDB&, bool value);
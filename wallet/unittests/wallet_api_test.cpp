@@ -18,6 +18,7 @@
 #include "wallet/api/i_wallet_api.h"
 #include "wallet/api/v6_0/v6_api.h"
 #include "utility/logger.h"
+#include "utility/io/json_serializer.h"
 #include "nlohmann/json.hpp"
 #include "wallet/api/i_swaps_provider.h"
 
@@ -1674,6 +1675,60 @@ void testCalcChange()
     }));
 }
 
+void testArrayResponse()
+{
+    // streamed array responses must be the same as the ones built as a whole tree
+    struct Handler : IWalletApiHandler
+    {
+        json m_Msg;
+        void sendAPIResponse(const json& msg) override
+        {
+            m_Msg = msg;
+        }
+    };
+
+    const json header = { {"jsonrpc", "2.0"}, {"id", 123} };
+
+    for (uint32_t nItems : { 0u, 1u, 1000u })
+    {
+        auto fillArray = [nItems](const IWalletApiHandler::ArrayItemWriter& write)
+        {
+            for (uint32_t i = 0; i < nItems; i++)
+            {
+                write({ {"idx", i}, {"txt", "item \"" + std::to_string(i) + "\""}, {"arr", {i, i + 1}} });
+            }
+        };
+
+        Handler h;
+        h.sendAPIArrayResponse(header, "result", fillArray);
+        WALLET_CHECK(h.m_Msg["result"].size() == nItems);
+
+        std::string text;
+        io::FragmentWriter fw(64, 0, [&text](io::SharedBuffer&& fragment)
+        {
+            text.append(reinterpret_cast<const char*>(fragment.data), fragment.size);
+        });
+
+        JsonArrayMsgWriter writer(fw, header, "result");
+        fillArray([&writer](const json& item)
+        {
+            writer.write(item);
+        });
+        writer.finalize();
+
+        WALLET_CHECK(!text.empty() && text.back() == '\n');
+        WALLET_CHECK(json::parse(text) == h.m_Msg);
+
+        std::string text2;
+        io::FragmentWriter fw2(64, 0, [&text2](io::SharedBuffer&& fragment)
+        {
+            text2.append(reinterpret_cast<const char*>(fragment.data), fragment.size);
+        });
+        serialize_json_msg(fw2, h.m_Msg);
+        WALLET_CHECK(text == text2);
+    }
+}
+
 int main()
 {
     wallet::g_AssetsEnabled = true;
@@ -2388,6 +2443,7 @@ int main()
 
     testAppsApi();
     testCalcChange();
+    testArrayResponse();
 
     return WALLET_CHECK_RESULT;
 }
@@ -363,6 +363,202 @@ void TestStoreTxRecord()
     WALLET_CHECK(t.size() == 0);
 }
 
+void TestTxListing()
+{
+    cout << "\nWallet database tx listing test\n";
+    auto walletDB = createSqliteWalletDB();
+
+    // same CreateTime for pairs of txs, to check the (CreateTime, TxID) order
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+        TxDescription tx(TxID{ { i } });
+        tx.m_txType = (i % 4) ? TxType::Simple : TxType::PushTransaction;
+        tx.m_amount = 100 + i;
+        tx.m_fee = i;
+        tx.m_createTime = 1000 + i / 2;
+        tx.m_status = TxStatus::Completed;
+        tx.m_message = { 'm', i };
+        tx.m_sender = (i & 1);
+        walletDB->saveTx(tx);
+    }
+
+    auto checkSame = [&](const TxDescription& tx)
+    {
+        auto full = walletDB->getTx(tx.m_txId);
+        WALLET_CHECK(full.is_initialized());
+        WALLET_CHECK(full->m_txType == tx.m_txType);
+        WALLET_CHECK(full->m_amount == tx.m_amount);
+        WALLET_CHECK(full->m_fee == tx.m_fee);
+        WALLET_CHECK(full->m_createTime == tx.m_createTime);
+        WALLET_CHECK(full->m_status == tx.m_status);
+        WALLET_CHECK(full->m_message == tx.m_message);
+        WALLET_CHECK(full->m_sender == tx.m_sender);
+    };
+
+    std::vector<TxID> vAll;
+    walletDB->visitTx([&](const TxDescription& tx)
+    {
+        vAll.push_back(tx.m_txId);
+        return true;
+    }, TxListFilter());
+    WALLET_CHECK(vAll.size() == 20);
+    WALLET_CHECK(vAll.front()[0] == 19);
+    WALLET_CHECK(vAll.back()[0] == 0);
+
+    // walk by keyset pages, must match the full listing
+    {
+        std::vector<TxID> vPaged;
+        TxListPage page;
+        page.m_Count = 3;
+
+        while (true)
+        {
+            uint32_t n = 0;
+            walletDB->visitTxSummary([&](const TxDescription& tx)
+            {
+                checkSame(tx);
+                vPaged.push_back(tx.m_txId);
+                page.m_After = TxListPage::Cursor{ tx.m_createTime, tx.m_txId };
+                ++n;
+                return true;
+            }, TxListFilter(), page);
+
+            WALLET_CHECK(n <= page.m_Count);
+            if (n < page.m_Count)
+                break;
+        }
+
+        WALLET_CHECK(vPaged == vAll);
+    }
+
+    {
+        TxListFilter filter;
+        filter.m_TransactionTypes.push_back(TxType::PushTransaction);
+
+        TxListPage page;
+        page.m_Skip = 1;
+
+        std::vector<uint8_t> v;
+        walletDB->visitTxSummary([&](const TxDescription& tx)
+        {
+            WALLET_CHECK(tx.m_txType == TxType::PushTransaction);
+            v.push_back(tx.m_txId[0]);
+            return true;
+        }, filter, page);
+        WALLET_CHECK((v == std::vector<uint8_t>{ 12, 8, 4, 0 }));
+    }
+
+    // the projection follows parameter updates and deletions
+    TxID id = { { 5 } };
+    storage::setTxParameter(*walletDB, id, TxParameterID::Status, TxStatus::Failed, false);
+    storage::setTxParameter(*walletDB, id, TxParameterID::Amount, Amount(7), false);
+    walletDB->delTxParameter(id, kDefaultSubTxID, TxParameterID::Message);
+    {
+        TxListFilter filter;
+        filter.m_Status = TxStatus::Failed;
+
+        uint32_t n = 0;
+        walletDB->visitTxSummary([&](const TxDescription& tx)
+        {
+            WALLET_CHECK(tx.m_txId == id);
+            WALLET_CHECK(tx.m_amount == 7);
+            WALLET_CHECK(tx.m_message.empty());
+            checkSame(tx);
+            ++n;
+            return true;
+        }, filter, TxListPage());
+        WALLET_CHECK(n == 1);
+    }
+
+    walletDB->deleteTx(id);
+    {
+        uint32_t n = 0;
+        walletDB->visitTxSummary([&](const TxDescription& tx)
+        {
+            WALLET_CHECK(tx.m_txId != id);
+            ++n;
+            return true;
+        }, TxListFilter(), TxListPage());
+        WALLET_CHECK(n == 19);
+    }
+}
+
+// Set nTxs to 1'000'000 to reproduce the large exchange wallet
+void TestTxListingPerf(uint32_t nTxs)
+{
+    cout << "\nWallet database tx listing performance test, txs: " << nTxs << "\n";
+    auto walletDB = createSqliteWalletDB();
+
+    {
+        TxDescription tx;
+        tx.m_status = TxStatus::Completed;
+        tx.m_message = { 'm' };
+        tx.m_peerAddr.m_Pk = 23U;
+        tx.m_myAddr.m_Pk = 42U;
+
+        for (uint32_t i = 0; i < nTxs; ++i)
+        {
+            tx.m_txId = TxID{};
+            memcpy(tx.m_txId.data(), &i, sizeof(i));
+            tx.m_amount = i;
+            tx.m_createTime = 1000000 + i;
+            tx.m_minHeight = i;
+            walletDB->saveTx(tx);
+            storage::setTxParameter(*walletDB, tx.m_txId, TxParameterID::KernelID, Merkle::Hash(i), false);
+        }
+    }
+
+    const uint32_t nPage = 50;
+    const uint32_t nSkip = nTxs / 2;
+
+    helpers::StopWatch sw;
+    sw.start();
+    uint32_t nOffset = 0, n = 0;
+    std::vector<TxID> vPageOld;
+    walletDB->visitTx([&](const TxDescription& tx)
+    {
+        if (++nOffset <= nSkip)
+            return true;
+        vPageOld.push_back(tx.m_txId);
+        return ++n < nPage;
+    }, TxListFilter());
+    sw.stop();
+    cout << "visitTx, page at " << nSkip << ": " << sw.milliseconds() << " ms\n";
+
+    TxListPage page;
+    page.m_Skip = nSkip;
+    page.m_Count = nPage;
+
+    sw.start();
+    std::vector<TxDescription> vPage;
+    walletDB->visitTxSummary([&](const TxDescription& tx)
+    {
+        vPage.push_back(tx);
+        return true;
+    }, TxListFilter(), page);
+    sw.stop();
+    cout << "visitTxSummary, page at " << nSkip << ": " << sw.milliseconds() << " ms\n";
+    WALLET_CHECK(vPage.size() == nPage);
+    WALLET_CHECK(vPageOld.size() == nPage);
+    for (uint32_t i = 0; i < std::min<size_t>(vPage.size(), vPageOld.size()); i++)
+        WALLET_CHECK(vPage[i].m_txId == vPageOld[i]);
+
+    page.m_Skip = 0;
+    page.m_After = TxListPage::Cursor{ vPage.back().m_createTime, vPage.back().m_txId };
+
+    sw.start();
+    n = 0;
+    walletDB->visitTxSummary([&](const TxDescription& tx)
+    {
+        WALLET_CHECK(tx.m_createTime < vPage.back().m_createTime);
+        ++n;
+        return true;
+    }, TxListFilter(), page);
+    sw.stop();
+    cout << "visitTxSummary, next page by cursor: " << sw.milliseconds() << " ms\n";
+    WALLET_CHECK(n == nPage);
+}
+
 void TestUTXORollback()
 {
     cout << "\nWallet database rollback test\n";
@@ -1323,6 +1519,143 @@ void TestSelect7()
     SelectCoins(db, 6'456'001'778'569 + 1000, false);
 }
 
+void TestSelectIndex()
+{
+    cout << "\nWallet database coin selection index test\n";
+    auto db = createSqliteWalletDB();
+
+    auto selectSum = [&](Amount amount, Asset::ID aid)
+    {
+        vector<Coin> coins;
+        vector<ShieldedCoin> shieldedCoins;
+        db->selectCoins2(0, amount, aid, coins, shieldedCoins, 0, false);
+        return accumulate(coins.begin(), coins.end(), Amount(0), [](Amount x, const Coin& c) { return x + c.m_ID.m_Value; });
+    };
+
+    vector<Coin> coins = {
+        CreateAvailCoin(3),
+        CreateAvailCoin(5),
+        CreateAvailCoin(8),
+        CreateAvailCoin(13),
+        CreateAvailCoin(100, 200) }; // maturing
+    db->storeCoins(coins);
+
+    {
+        Coin c = CreateAvailCoin(1000);
+        c.m_ID.m_AssetID = 7;
+        db->storeCoin(c);
+    }
+
+    // exact match, no change
+    vector<Coin> vSel;
+    vector<ShieldedCoin> shieldedCoins;
+    db->selectCoins2(0, 16, Zero, vSel, shieldedCoins, 0, false);
+    WALLET_CHECK(vSel.size() == 2);
+    WALLET_CHECK(vSel[0].m_ID.m_Value == 13);
+    WALLET_CHECK(vSel[1].m_ID.m_Value == 3);
+
+    WALLET_CHECK(selectSum(29, Zero) == 29);
+    WALLET_CHECK(selectSum(30, Zero) == 0);
+    WALLET_CHECK(selectSum(500, 7) == 1000);
+    WALLET_CHECK(selectSum(1001, 7) == 0);
+
+    // the index must follow the coin updates
+    Coin c13 = coins[3];
+    c13.m_spentHeight = 120;
+    db->saveCoin(c13);
+    WALLET_CHECK(selectSum(29, Zero) == 0);
+    WALLET_CHECK(selectSum(16, Zero) == 16);
+
+    db->rollbackConfirmedUtxo(100);
+    WALLET_CHECK(selectSum(29, Zero) == 29);
+
+    db->removeCoins({ coins[0].m_ID });
+    WALLET_CHECK(selectSum(26, Zero) == 26);
+    WALLET_CHECK(selectSum(27, Zero) == 0);
+
+    Coin c100 = coins[4];
+    c100.m_maturity = 50;
+    db->saveCoin(c100);
+    WALLET_CHECK(selectSum(126, Zero) == 126);
+
+    db->clearCoins();
+    WALLET_CHECK(selectSum(1, Zero) == 0);
+    WALLET_CHECK(selectSum(1, 7) == 0);
+}
+
+// Set nCoins to 1'000'000 to reproduce the mining pool wallet
+void TestSelectIndexPerf(uint32_t nCoins)
+{
+    cout << "\nWallet database coin selection performance test, coins: " << nCoins << "\n";
+    auto db = createSqliteWalletDB();
+
+    // coins are created by several txs, some with min confirmations. Some coins are locked by an ongoing tx
+    const uint32_t nTxs = 100;
+    auto getTxID = [](uint32_t i)
+    {
+        TxID txID = {};
+        memcpy(txID.data(), &i, sizeof(i));
+        return txID;
+    };
+
+    for (uint32_t i = 0; i < nTxs; i++)
+        storage::setTxParameter(*db, getTxID(i), TxParameterID::MinConfirmations, i % 20, false);
+
+    const TxID txLock = getTxID(nTxs);
+    storage::setTxParameter(*db, txLock, TxParameterID::Status, TxStatus::InProgress, false);
+
+    Amount valTotal = 0;
+    {
+        vector<Coin> coins;
+        coins.reserve(nCoins);
+
+        for (uint32_t i = 0; i < nCoins; i++)
+        {
+            Coin& c = coins.emplace_back(CreateAvailCoin(1000 + i, 100 + i % 30));
+            c.m_ID.m_Idx = i;
+            c.m_createTxId = getTxID(i % nTxs);
+
+            if (c.m_maturity + (i % nTxs) % 20 > 134)
+                continue; // maturing
+
+            if (!(i % 1000))
+                c.m_spentTxId = txLock;
+            else
+                valTotal += c.m_ID.m_Value;
+        }
+
+        db->storeCoins(coins);
+    }
+
+    auto select = [&](Amount amount, const char* szTitle)
+    {
+        helpers::StopWatch sw;
+        sw.start();
+
+        vector<Coin> vSel;
+        vector<ShieldedCoin> vSelShielded;
+        db->selectCoins2(0, amount, Zero, vSel, vSelShielded, 0, false);
+
+        sw.stop();
+        cout << szTitle << ", inputs: " << vSel.size() << ", " << sw.microseconds() << " us\n";
+
+        Amount val = 0;
+        for (const auto& c : vSel)
+        {
+            WALLET_CHECK(!c.m_spentTxId);
+            WALLET_CHECK(c.get_Maturity() <= 134);
+            val += c.m_ID.m_Value;
+        }
+        return val;
+    };
+
+    WALLET_CHECK(select(5000, "1st selection (index build)") >= 5000);
+    WALLET_CHECK(select(5000, "small amount") >= 5000);
+    WALLET_CHECK(select(valTotal / 2, "half of the balance") >= valTotal / 2);
+    WALLET_CHECK(select(valTotal, "whole balance") == valTotal);
+    WALLET_CHECK(select(valTotal + 1, "above the balance") == 0);
+}
+
 void TestWalletMessages()
 {
     cout << "\nWallet database wallet messages test\n";
@@ -1704,6 +2037,131 @@ void TestShieldedStatus2()
 
 }
 
+void TestHistory()
+{
+    cout << "\nWallet database history test\n";
+    auto db = createSqliteWalletDB();
+
+    // all the operations are mirrored in the simple in-memory history, results must match
+    Block::SystemState::HistoryMap hm;
+    auto& hist = db->get_History();
+
+    struct Walker :public Block::SystemState::IHistory::IWalker
+    {
+        std::vector<Height> m_vHeights;
+        bool OnState(const Block::SystemState::Full& s) override
+        {
+            m_vHeights.push_back(s.m_Height);
+            return true;
+        }
+    };
+
+    auto verify = [&]()
+    {
+        // same via another connection, the states are loaded from the db
+        db->commitPending();
+        auto db2 = WalletDB::open("wallet.db", string("pass123"));
+
+        for (auto pHist : { &hist, &db2->get_History() })
+        {
+            auto& hst = *pHist;
+
+            Walker w1, w2;
+            hst.Enum(w1, nullptr);
+            hm.Enum(w2, nullptr);
+            WALLET_CHECK(w1.m_vHeights == w2.m_vHeights);
+
+            for (Height h = 0; h < 60; h += 7)
+            {
+                Walker w3, w4;
+                hst.Enum(w3, &h);
+                hm.Enum(w4, &h);
+                WALLET_CHECK(w3.m_vHeights == w4.m_vHeights);
+
+                Block::SystemState::Full s1, s2;
+                bool b1 = hst.get_At(s1, h);
+                WALLET_CHECK(b1 == hm.get_At(s2, h));
+                WALLET_CHECK(!b1 || (s1.m_Height == h && s1.m_ChainWork == s2.m_ChainWork));
+            }
+
+            Block::SystemState::Full s1, s2;
+            WALLET_CHECK(hst.get_Tip(s1) == hm.get_Tip(s2));
+            WALLET_CHECK(s1.m_Height == s2.m_Height);
+        }
+    };
+
+    std::vector<Block::SystemState::Full> v;
+    auto add = [&](Height h0, Height h1, uint32_t nWork)
+    {
+        v.clear();
+        for (Height h = h0; h < h1; h++)
+        {
+            auto& s = v.emplace_back();
+            ZeroObject(s);
+            s.m_Height = h;
+            s.m_ChainWork = h * nWork;
+        }
+
+        hist.AddStates(&v.front(), v.size());
+        hm.AddStates(&v.front(), v.size());
+    };
+
+    verify();
+
+    add(3, 5, 1); // sparse, as after the chainwork proof
+    add(9, 10, 1);
+    add(20, 40, 1);
+    verify();
+
+    add(40, 45, 1);
+    add(30, 35, 2); // replace
+    verify();
+
+    hist.DeleteFrom(38);
+    hm.DeleteFrom(38);
+    verify();
+
+    hist.DeleteFrom(15);
+    hm.DeleteFrom(15);
+    verify();
+
+    add(12, 13, 3); // above the gap
+    add(13, 50, 3);
+    verify();
+
+    hist.DeleteFrom(1);
+    hm.DeleteFrom(1);
+    verify();
+
+    // the tip changed via another connection is seen after dropCaches
+    add(1, 20, 1);
+    verify();
+    {
+        auto db2 = WalletDB::open("wallet.db", string("pass123"));
+        auto& hist2 = db2->get_History();
+
+        hist2.DeleteFrom(15);
+        hm.DeleteFrom(15);
+        v.clear();
+        for (Height h = 15; h < 25; h++)
+        {
+            auto& s = v.emplace_back();
+            ZeroObject(s);
+            s.m_Height = h;
+            s.m_ChainWork = h * 4;
+        }
+        hist2.AddStates(&v.front(), v.size());
+        hm.AddStates(&v.front(), v.size());
+        db2->commitPending();
+    }
+
+    Block::SystemState::Full s;
+    WALLET_CHECK(hist.get_Tip(s) && s.m_Height == 19); // cached
+
+    db->dropCaches();
+    verify();
+}
+
 int main() 
 {
     int logLevel = BEAM_LOG_LEVEL_DEBUG;
@@ -1720,6 +2178,8 @@ int main()
     TestWalletDataBase();
     TestStoreCoins();
     TestStoreTxRecord();
+    TestTxListing();
+    TestTxListingPerf(10000);
     TestTxRollback();
     TestUTXORollback();
     TestSelect();
@@ -1729,6 +2189,8 @@ int main()
     TestSelect5();
     TestSelect6();
     TestSelect7();
+    TestSelectIndex();
+    TestSelectIndexPerf(20000);
     TestAddresses();
     TestExportImportTx();
     TestTxParameters();
@@ -1738,6 +2200,7 @@ int main()
     TestVouchers();
     TestShieldedStatus();
     TestShieldedStatus2();
+    TestHistory();
 
     return WALLET_CHECK_RESULT;
 }
@@ -63,6 +63,10 @@ WALLET_TEST_INIT
 
 #include "wallet_test_environment.cpp"
 #include "wallet/api/v6_0/v6_api.h"
+#include "wallet/api/v6_1/v6_1_api.h"
+#include "wallet/api/events_journal.h"
+#include "wallet/core/node_network.h"
+#include "wallet/core/shared_node_client.h"
 
 namespace
 {
@@ -286,6 +290,537 @@ namespace
         }
     }
 
+    struct EventsApiTest
+        : public IWalletApiHandler
+        , public beam::wallet::V61Api
+    {
+        explicit EventsApiTest(const ApiInitData& data)
+            : V61Api(*this, 6, 1, data)
+        {
+        }
+
+        using V61Api::onCoinsChanged;
+
+        std::vector<json> m_Messages;
+        void sendAPIResponse(const json& msg) override
+        {
+            m_Messages.push_back(msg);
+        }
+
+        void Subscribe(boost::optional<uint32_t> debounceMs, boost::optional<uint64_t> resumeFrom = boost::none)
+        {
+            EvSubUnsub data;
+            data.utxosChanged = true;
+            data.debounceMs = debounceMs;
+            data.resumeFrom = resumeFrom;
+            onHandleEvSubUnsub(1, std::move(data));
+        }
+
+        // ids of the changed utxos of the given message
+        std::vector<std::string> GetUtxoIDs(const json& msg) const
+        {
+            std::vector<std::string> res;
+            for (const auto& utxo: msg["result"]["utxos"])
+            {
+                res.push_back(utxo["id"]);
+            }
+            return res;
+        }
+
+        void CheckChange(size_t idx, ChangeAction action, const std::vector<Coin>& coins) const
+        {
+            WALLET_CHECK(idx < m_Messages.size());
+            if (idx >= m_Messages.size())
+                return;
+
+            const auto& msg = m_Messages[idx];
+            WALLET_CHECK(msg["id"] == "ev_utxos_changed");
+            WALLET_CHECK(msg["result"]["change"] == action);
+
+            std::vector<std::string> ids;
+            for (const auto& c: coins)
+            {
+                ids.push_back(c.toStringID());
+            }
+            WALLET_CHECK(GetUtxoIDs(msg) == ids);
+        }
+    };
+
+    struct JournalObserverTest : public IWalletObserver
+    {
+        explicit JournalObserverTest(const ApiEventsJournal& journal)
+            : m_Journal(journal)
+        {
+        }
+
+        void onCoinsChanged(ChangeAction action, const std::vector<Coin>& items) override
+        {
+            for (const auto& c: items)
+            {
+                m_Changes.emplace_back(m_Journal.get_Seq(), c.m_ID.m_Idx);
+            }
+        }
+
+        const ApiEventsJournal& m_Journal;
+        std::vector<std::pair<uint64_t, uint64_t>> m_Changes;
+    };
+
+    Coin CreateEventCoin(uint64_t idx)
+    {
+        Coin c(100 + idx);
+        c.m_ID.m_Idx = idx;
+        return c;
+    }
+
+    void RunReactorFor(io::Reactor& reactor, unsigned ms)
+    {
+        auto timer = io::Timer::create(reactor);
+        timer->start(ms, false, [&reactor]() { reactor.stop(); });
+        reactor.run();
+    }
+
+    void TestEventsJournal()
+    {
+        cout << "\nTesting API events journal...\n";
+
+        io::Reactor::Ptr mainReactor{ io::Reactor::create() };
+        io::Reactor::Scope scope(*mainReactor);
+
+        TestWalletRig rig(createSenderWalletDB(), {}, TestWalletRig::Type::Offline);
+
+        constexpr size_t MaxItems = 4;
+        auto journal = std::make_shared<ApiEventsJournal>(rig.m_Wallet, MaxItems);
+        auto network = std::make_shared<NodeNetwork>(*rig.m_Wallet);
+
+        ApiInitData data;
+        data.walletDB = rig.m_WalletDB;
+        data.wallet = rig.m_Wallet;
+        data.nodeNetwork = network;
+        data.eventsJournal = journal;
+
+        EventsApiTest api(data);
+        api.Subscribe(boost::none);
+        api.m_Messages.clear();
+
+        const auto startSeq = journal->get_Seq();
+        WALLET_CHECK(journal->CanResume(startSeq));
+        WALLET_CHECK(!journal->CanResume(startSeq + 1));
+
+        // every change is numbered and delivered with its sequence
+        constexpr uint64_t Count = 10;
+        std::vector<uint64_t> seqs;
+        for (uint64_t i = 0; i < Count; ++i)
+        {
+            journal->onCoinsChanged(ChangeAction::Added, {CreateEventCoin(i)});
+            seqs.push_back(journal->get_Seq());
+
+            WALLET_CHECK(seqs.back() == startSeq + i + 1);
+            WALLET_CHECK(api.m_Messages.size() == i + 1);
+            WALLET_CHECK(api.m_Messages.back()["result"]["seq"] == seqs.back());
+            api.CheckChange(api.m_Messages.size() - 1, ChangeAction::Added, {CreateEventCoin(i)});
+        }
+
+        // ring overflow, the oldest changes are evicted
+        WALLET_CHECK(!journal->CanResume(startSeq));
+        WALLET_CHECK(!journal->CanResume(seqs[0]));
+        WALLET_CHECK(!journal->CanResume(seqs[Count - MaxItems - 3]));
+        WALLET_CHECK(journal->CanResume(seqs[Count - MaxItems - 1]));
+        WALLET_CHECK(journal->CanResume(seqs[Count - 1]));
+        WALLET_CHECK(!journal->CanResume(seqs[Count - 1] + 1));
+
+        // replay delivers only the changes after the given sequence, in order
+        {
+            JournalObserverTest observer(*journal);
+            journal->Replay(seqs[Count - 3], observer);
+            WALLET_CHECK(observer.m_Changes.size() == 2);
+            WALLET_CHECK(observer.m_Changes[0] == std::make_pair(seqs[Count - 2], Count - 2));
+            WALLET_CHECK(observer.m_Changes[1] == std::make_pair(seqs[Count - 1], Count - 1));
+            WALLET_CHECK(journal->get_Seq() == seqs[Count - 1]);
+        }
+        {
+            JournalObserverTest observer(*journal);
+            journal->Replay(seqs[Count - 1], observer);
+            WALLET_CHECK(observer.m_Changes.empty());
+        }
+
+        // resume from an evicted sequence falls back to the full list
+        {
+            EventsApiTest api2(data);
+            api2.Subscribe(boost::none, seqs[0]);
+            WALLET_CHECK(api2.m_Messages.size() == 2);
+            WALLET_CHECK(api2.m_Messages[0]["result"]["resumed"] == false);
+            WALLET_CHECK(api2.m_Messages[1]["result"]["change"] == ChangeAction::Reset);
+        }
+
+        // resume from a kept sequence replays the missed changes only
+        {
+            EventsApiTest api2(data);
+            api2.Subscribe(boost::none, seqs[Count - 3]);
+            WALLET_CHECK(api2.m_Messages.size() == 3);
+            WALLET_CHECK(api2.m_Messages[0]["result"]["resumed"] == true);
+            api2.CheckChange(1, ChangeAction::Added, {CreateEventCoin(Count - 2)});
+            api2.CheckChange(2, ChangeAction::Added, {CreateEventCoin(Count - 1)});
+            WALLET_CHECK(api2.m_Messages[1]["result"]["seq"] == seqs[Count - 2]);
+            WALLET_CHECK(api2.m_Messages[2]["result"]["seq"] == seqs[Count - 1]);
+        }
+
+        // observers unsubscribe and subscribe while the change is dispatched
+        {
+            struct SelfUnsubscriber : public JournalObserverTest
+            {
+                explicit SelfUnsubscriber(ApiEventsJournal& journal)
+                    : JournalObserverTest(journal)
+                    , m_JournalRW(journal)
+                {
+                }
+
+                void onCoinsChanged(ChangeAction action, const std::vector<Coin>& items) override
+                {
+                    JournalObserverTest::onCoinsChanged(action, items);
+                    m_JournalRW.Unsubscribe(this);
+
+                    if (m_pToSubscribe)
+                    {
+                        m_JournalRW.Subscribe(m_pToSubscribe);
+                        m_pToSubscribe = nullptr;
+                    }
+                }
+
+                ApiEventsJournal& m_JournalRW;
+                IWalletObserver* m_pToSubscribe = nullptr;
+            };
+
+            SelfUnsubscriber observer1(*journal);
+            JournalObserverTest observer2(*journal);
+            JournalObserverTest observer3(*journal);
+            observer1.m_pToSubscribe = &observer3;
+
+            journal->Subscribe(&observer1);
+            journal->Subscribe(&observer2);
+
+            journal->onCoinsChanged(ChangeAction::Added, {CreateEventCoin(Count)});
+            WALLET_CHECK(observer1.m_Changes.size() == 1);
+            WALLET_CHECK(observer2.m_Changes.size() == 1); // not skipped after the removal of observer1
+            WALLET_CHECK(observer3.m_Changes.empty()); // subscribed during the dispatch, gets the next changes only
+
+            journal->onCoinsChanged(ChangeAction::Added, {CreateEventCoin(Count + 1)});
+            WALLET_CHECK(observer1.m_Changes.size() == 1);
+            WALLET_CHECK(observer2.m_Changes.size() == 2);
+            WALLET_CHECK(observer3.m_Changes.size() == 1);
+            WALLET_CHECK(observer3.m_Changes[0] == std::make_pair(journal->get_Seq(), Count + 1));
+
+            journal->Unsubscribe(&observer2);
+            journal->Unsubscribe(&observer3);
+        }
+    }
+
+    void TestEventsCoalescing()
+    {
+        cout << "\nTesting API events coalescing...\n";
+
+        io::Reactor::Ptr mainReactor{ io::Reactor::create() };
+        io::Reactor::Scope scope(*mainReactor);
+
+        TestWalletRig rig(createSenderWalletDB(), {}, TestWalletRig::Type::Offline);
+        auto network = std::make_shared<NodeNetwork>(*rig.m_Wallet);
+
+        ApiInitData data;
+        data.walletDB = rig.m_WalletDB;
+        data.wallet = rig.m_Wallet;
+        data.nodeNetwork = network;
+
+        EventsApiTest api(data);
+        api.Subscribe(10);
+        api.m_Messages.clear();
+
+        const auto c1 = CreateEventCoin(1);
+        const auto c2 = CreateEventCoin(2);
+        const auto c3 = CreateEventCoin(3);
+        const auto c4 = CreateEventCoin(4);
+
+        // added and removed, subscriber has never seen it
+        api.onCoinsChanged(ChangeAction::Added, {c1});
+        api.onCoinsChanged(ChangeAction::Removed, {c1});
+
+        // added and updated is still new for the subscriber
+        api.onCoinsChanged(ChangeAction::Added, {c2});
+        api.onCoinsChanged(ChangeAction::Updated, {c2});
+
+        // removed and added back is an update
+        api.onCoinsChanged(ChangeAction::Removed, {c3});
+        api.onCoinsChanged(ChangeAction::Added, {c3});
+
+        // the last action wins otherwise
+        api.onCoinsChanged(ChangeAction::Updated, {c4});
+        api.onCoinsChanged(ChangeAction::Removed, {c4});
+
+        // nothing is sent until debounce expires
+        WALLET_CHECK(api.m_Messages.empty());
+        RunReactorFor(*mainReactor, 100);
+
+        WALLET_CHECK(api.m_Messages.size() == 3);
+        api.CheckChange(0, ChangeAction::Added, {c2});
+        api.CheckChange(1, ChangeAction::Updated, {c3});
+        api.CheckChange(2, ChangeAction::Removed, {c4});
+        api.m_Messages.clear();
+
+        // the timer is armed again by the next change
+        api.onCoinsChanged(ChangeAction::Updated, {c2});
+        WALLET_CHECK(api.m_Messages.empty());
+        RunReactorFor(*mainReactor, 100);
+        WALLET_CHECK(api.m_Messages.size() == 1);
+        api.CheckChange(0, ChangeAction::Updated, {c2});
+        api.m_Messages.clear();
+
+        // reset replaces everything queued before it
+        api.onCoinsChanged(ChangeAction::Updated, {c1});
+        api.onCoinsChanged(ChangeAction::Reset, {c2, c3});
+        api.onCoinsChanged(ChangeAction::Added, {c4});
+        RunReactorFor(*mainReactor, 100);
+        WALLET_CHECK(api.m_Messages.size() == 2);
+        api.CheckChange(0, ChangeAction::Reset, {c2, c3});
+        api.CheckChange(1, ChangeAction::Added, {c4});
+        api.m_Messages.clear();
+
+        // switching debounce off sends the queued changes right away
+        api.onCoinsChanged(ChangeAction::Updated, {c3});
+        api.Subscribe(0);
+        WALLET_CHECK(api.m_Messages.size() == 2);
+        WALLET_CHECK(api.m_Messages[0]["result"] == true);
+        api.CheckChange(1, ChangeAction::Updated, {c3});
+        api.m_Messages.clear();
+
+        api.onCoinsChanged(ChangeAction::Updated, {c4});
+        WALLET_CHECK(api.m_Messages.size() == 1);
+        api.CheckChange(0, ChangeAction::Updated, {c4});
+    }
+
+    struct SharedNodeTenant
+        : public proto::FlyClient
+        , public proto::FlyClient::Request::IHandler
+        , public proto::FlyClient::IBbsReceiver
+    {
+        Block::SystemState::HistoryMap m_History;
+        proto::FlyClient::INetwork::Ptr m_Endpoint;
+        uint32_t m_NewTips = 0;
+        uint32_t m_RollBacks = 0;
+        std::vector<Block::SystemState::Full> m_Headers;
+        std::vector<proto::BbsMsg> m_Msgs;
+
+        Block::SystemState::IHistory& get_History() override { return m_History; }
+        void OnNewTip() override { ++m_NewTips; }
+        void OnRolledBack() override { ++m_RollBacks; }
+
+        void OnComplete(proto::FlyClient::Request& r) override
+        {
+            if (r.get_Type() == proto::FlyClient::Request::Type::EnumHdrs)
+            {
+                const auto& v = r.As<proto::FlyClient::RequestEnumHdrs>().m_vStates;
+                m_Headers.insert(m_Headers.end(), v.begin(), v.end());
+            }
+        }
+
+        void OnMsg(proto::BbsMsg&& msg) override
+        {
+            m_Msgs.push_back(std::move(msg));
+        }
+
+        bool HasState(const Block::SystemState::Full& s)
+        {
+            Block::SystemState::Full s2;
+            if (!m_History.get_At(s2, s.m_Height))
+                return false;
+
+            Merkle::Hash hv0, hv1;
+            s.get_Hash(hv0);
+            s2.get_Hash(hv1);
+            return hv0 == hv1;
+        }
+
+        bool IsTip(const Block::SystemState::Full& s)
+        {
+            Block::SystemState::Full tip;
+            m_History.get_Tip(tip);
+            return tip.m_Height == s.m_Height && HasState(s);
+        }
+    };
+
+    bool RunReactorUntil(io::Reactor& reactor, std::function<bool()>&& pred, unsigned timeout_ms = 10000)
+    {
+        unsigned elapsed = 0;
+        auto timer = io::Timer::create(reactor);
+        timer->start(10, true, [&]() {
+            elapsed += 10;
+            if (pred() || elapsed >= timeout_ms)
+                reactor.stop();
+        });
+        reactor.run();
+        return pred();
+    }
+
+    void TestSharedNodeClient()
+    {
+        cout << "\nTesting shared node client...\n";
+
+        io::Reactor::Ptr mainReactor{ io::Reactor::create() };
+        io::Reactor::Scope scope(*mainReactor);
+
+        TestNode node;
+        const auto nodeAddress = io::Address::localhost().port(32125);
+        auto getState = [&node](Height h) {
+            return node.m_Blockchain.m_mcm.m_vStates[h - Rules::HeightGenesis].m_Hdr;
+        };
+
+        auto shared = std::make_shared<SharedNodeClient>();
+        auto nnet = shared->getNetwork();
+        proto::FlyClient& sharedClient = *shared;
+
+        // in sync with the node
+        SharedNodeTenant t1;
+        {
+            auto s = getState(100);
+            t1.m_History.AddStates(&s, 1);
+        }
+
+        // a new wallet
+        SharedNodeTenant t2;
+
+        t1.m_Endpoint = shared->addClient(t1);
+        t2.m_Endpoint = shared->addClient(t2);
+
+        nnet->m_Cfg.m_vNodes.push_back(nodeAddress);
+        nnet->Connect();
+
+        WALLET_CHECK(RunReactorUntil(*mainReactor, [&]() {
+            return t1.IsTip(getState(node.GetHeight())) && t2.IsTip(getState(node.GetHeight()));
+        }));
+
+        WALLET_CHECK(t1.HasState(getState(100)));
+        WALLET_CHECK(!t1.m_RollBacks);
+        WALLET_CHECK(!t2.m_RollBacks);
+
+        //
+        // A wallet has been offline during a reorg, its state at 100 is not in the node chain anymore.
+        // Wallet states below the common history are checked against the node
+        //
+        static_cast<Block::SystemState::HistoryMap&>(sharedClient.get_History()).ShrinkToWindow(5);
+
+        SharedNodeTenant t3;
+        auto forged = getState(100);
+        forged.m_TimeStamp++;
+        {
+            Block::SystemState::Full v[] = { getState(90), forged };
+            t3.m_History.AddStates(v, _countof(v));
+        }
+        t3.m_Endpoint = shared->addClient(t3);
+
+        node.AddBlock();
+        const auto nodeTip = getState(node.GetHeight());
+
+        WALLET_CHECK(RunReactorUntil(*mainReactor, [&]() {
+            return t1.IsTip(nodeTip) && t2.IsTip(nodeTip) && t3.IsTip(nodeTip);
+        }));
+
+        WALLET_CHECK(t3.HasState(getState(90)));
+        WALLET_CHECK(!t3.HasState(forged));
+        WALLET_CHECK(t3.m_RollBacks == 1);
+        WALLET_CHECK(!t1.m_RollBacks && !t2.m_RollBacks);
+
+        //
+        // Requests are routed back to the wallet which has posted them
+        //
+        {
+            proto::FlyClient::RequestEnumHdrs::Ptr r1(new proto::FlyClient::RequestEnumHdrs);
+            r1->m_Msg.m_Height = 50;
+            t1.m_Endpoint->PostRequest(*r1, t1);
+
+            proto::FlyClient::RequestEnumHdrs::Ptr r2(new proto::FlyClient::RequestEnumHdrs);
+            r2->m_Msg.m_Height = 60;
+            t3.m_Endpoint->PostRequest(*r2, t3);
+
+            WALLET_CHECK(RunReactorUntil(*mainReactor, [&]() {
+                return !t1.m_Headers.empty() && !t3.m_Headers.empty();
+            }));
+
+            WALLET_CHECK(t1.m_Headers.size() == 1 && t1.m_Headers.front().m_Height == 50);
+            WALLET_CHECK(t3.m_Headers.size() == 1 && t3.m_Headers.front().m_Height == 60);
+            WALLET_CHECK(t2.m_Headers.empty());
+        }
+
+        //
+        // BBS channel is subscribed once, from the oldest time requested by the wallets.
+        // Messages are dispatched to all the wallets subscribed to the channel
+        //
+        {
+            const BbsChannel channel = 17;
+            auto getSubscriptions = [&](BbsChannel ch) {
+                std::vector<std::pair<bool, Timestamp>> res;
+                for (const auto& msg: node.m_BbsSubscriptions)
+                {
+                    if (msg.m_Channel == ch)
+                        res.emplace_back(msg.m_On, msg.m_TimeFrom);
+                }
+                return res;
+            };
+
+            t1.m_Endpoint->BbsSubscribe(channel, 1000, &t1);
+            t3.m_Endpoint->BbsSubscribe(channel, 500, &t3);
+            t2.m_Endpoint->BbsSubscribe(channel, 2000, &t2);
+            t2.m_Endpoint->BbsSubscribe(channel, 0, nullptr);
+            t2.m_Endpoint->BbsSubscribe(channel + 1, 0, &t2);
+
+            WALLET_CHECK(RunReactorUntil(*mainReactor, [&]() {
+                return !getSubscriptions(channel + 1).empty();
+            }));
+
+            std::vector<std::pair<bool, Timestamp>> expected = {{true, 1000}, {false, 0}, {true, 500}};
+            WALLET_CHECK(getSubscriptions(channel) == expected);
+
+            SharedNodeTenant sender;
+            auto senderNet = std::make_shared<proto::FlyClient::NetworkStd>(sender);
+            senderNet->m_Cfg.m_vNodes.push_back(nodeAddress);
+            senderNet->Connect();
+
+            proto::FlyClient::RequestBbsMsg::Ptr pMsg(new proto::FlyClient::RequestBbsMsg);
+            pMsg->m_Msg.m_Channel = channel;
+            pMsg->m_Msg.m_TimePosted = getTimestamp();
+            pMsg->m_Msg.m_Message = {1, 2, 3};
+            senderNet->PostRequest(*pMsg, sender);
+
+            WALLET_CHECK(RunReactorUntil(*mainReactor, [&]() {
+                return !t1.m_Msgs.empty() && !t3.m_Msgs.empty();
+            }));
+
+            WALLET_CHECK(t1.m_Msgs.size() == 1 && t1.m_Msgs.front().m_Message == pMsg->m_Msg.m_Message);
+            WALLET_CHECK(t3.m_Msgs.size() == 1 && t3.m_Msgs.front().m_Message == pMsg->m_Msg.m_Message);
+            WALLET_CHECK(t2.m_Msgs.empty());
+
+            for (auto t: {&t1, &t2, &t3})
+            {
+                t->m_Endpoint->BbsSubscribe(channel, 0, nullptr);
+                t->m_Endpoint->BbsSubscribe(channel + 1, 0, nullptr);
+            }
+        }
+
+        //
+        // The common tip is reverted, the wallets are rolled back to the states confirmed by the node
+        //
+        {
+            auto forgedTip = nodeTip;
+            forgedTip.m_TimeStamp++;
+
+            sharedClient.get_History().DeleteFrom(nodeTip.m_Height);
+            sharedClient.get_History().AddStates(&forgedTip, 1);
+            sharedClient.OnRolledBack();
+
+            WALLET_CHECK(t1.IsTip(forgedTip) && t1.HasState(getState(100)) && t1.m_RollBacks == 1);
+            WALLET_CHECK(t2.IsTip(forgedTip) && t2.m_RollBacks == 1);
+            WALLET_CHECK(t3.IsTip(forgedTip) && t3.HasState(getState(90)) && t3.m_RollBacks == 2);
+        }
+
+        nnet->Disconnect();
+    }
+
     void TestEventTypeSerialization()
     {
         std::string serializedStr;
@@ -4199,6 +4734,69 @@ void TestKeyKeeper(IPrivateKeyKeeper2::Ptr externalKeyKeeper = {}, size_t index
     WALLET_CHECK(tx.IsValid(ctx));
 }
 
+void TestKeyKeeperOutputsBatch()
+{
+    io::Reactor::Ptr mainReactor{ io::Reactor::create() };
+    io::Reactor::Scope scope(*mainReactor);
+
+    Key::IKdf::Ptr pKdf;
+    ECC::HKdf::Create(pKdf, 17U);
+
+    LocalPrivateKeyKeeperStd keyKeeper(pKdf);
+
+    const Height hScheme = 100500;
+    const uint32_t nOutputs = 5;
+
+    struct MyHandler
+        :public IPrivateKeyKeeper2::Handler
+    {
+        IPrivateKeyKeeper2::Status::Type m_Status = IPrivateKeyKeeper2::Status::Unspecified;
+        uint32_t* m_pDone;
+        uint32_t m_Total;
+
+        void OnDone(IPrivateKeyKeeper2::Status::Type s) override
+        {
+            m_Status = s;
+            if (++*m_pDone == m_Total)
+                io::Reactor::get_Current().stop();
+        }
+    };
+
+    uint32_t nDone = 0;
+    IPrivateKeyKeeper2::Method::CreateOutput pM[nOutputs];
+    std::shared_ptr<MyHandler> pH[nOutputs];
+
+    for (uint32_t i = 0; i < nOutputs; i++)
+    {
+        pM[i].m_Cid = CoinID(100 + i, 15 + i, Key::Type::Regular, i);
+        pM[i].m_hScheme = hScheme;
+
+        pH[i] = std::make_shared<MyHandler>();
+        pH[i]->m_pDone = &nDone;
+        pH[i]->m_Total = nOutputs;
+
+        keyKeeper.InvokeAsync(pM[i], pH[i]);
+    }
+
+    // all the outputs are created together on the next reactor cycle
+    WALLET_CHECK(!nDone);
+    mainReactor->run();
+    WALLET_CHECK(nOutputs == nDone);
+
+    for (uint32_t i = 0; i < nOutputs; i++)
+    {
+        WALLET_CHECK(IPrivateKeyKeeper2::Status::Success == pH[i]->m_Status);
+
+        ECC::Point::Native comm;
+        WALLET_CHECK(pM[i].m_pResult && pM[i].m_pResult->IsValid(hScheme, comm));
+
+        IPrivateKeyKeeper2::Method::get_Commitment m;
+        m.m_Cid = pM[i].m_Cid;
+        WALLET_CHECK(IPrivateKeyKeeper2::Status::Success == keyKeeper.InvokeSync(m));
+        WALLET_CHECK(comm == m.m_Result);
+    }
+}
+
 void TestArgumentParsing()
 {
     struct MyProcessor : bvm2::ProcessorManager
@@ -4994,7 +5592,11 @@ int main()
     TestThreadPool();
     //GenerateTreasury(100, 100, 100000000);
     TestTxList();
+    TestEventsJournal();
+    TestEventsCoalescing();
+    TestSharedNodeClient();
     TestKeyKeeper();
+    TestKeyKeeperOutputsBatch();
 
     TestVouchers();
 
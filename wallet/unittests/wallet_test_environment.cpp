@@ -1030,6 +1030,7 @@ public:
 
     TestBlockchain m_Blockchain;
     std::vector<ECC::Point::Storage> m_vShieldedPool;
+    std::vector<proto::BbsSubscribe> m_BbsSubscriptions; // all the subscription requests received
 
     void AddBlock()
     {
@@ -1143,8 +1144,33 @@ private:
             Send(msgOut);
         }
 
+        void OnMsg(proto::EnumHdrs&& msg) override
+        {
+            const auto& v = m_This.m_Blockchain.m_mcm.m_vStates; // alias
+
+            HeightRange hr(Rules::HeightGenesis, m_This.GetHeight());
+            hr.Intersect(msg.m_Height);
+            if (hr.IsEmpty())
+            {
+                Send(proto::DataMissing{});
+                return;
+            }
+
+            if (hr.m_Max - hr.m_Min >= proto::g_HdrPackMaxSize)
+                hr.m_Min = hr.m_Max - proto::g_HdrPackMaxSize + 1;
+
+            proto::HdrPack msgOut;
+            for (Height h = hr.m_Max; h >= hr.m_Min; --h)
+                msgOut.m_vElements.push_back(v[h - Rules::HeightGenesis].m_Hdr);
+
+            msgOut.m_Prefix = v[hr.m_Min - Rules::HeightGenesis].m_Hdr;
+            Send(msgOut);
+        }
+
         void OnMsg(proto::BbsSubscribe&& msg) override
         {
+            m_This.m_BbsSubscriptions.push_back(msg);
+
             if (m_Subscribed)
                 return;
             m_Subscribed = true;